@@ -0,0 +1,49 @@
+<?php
+
+namespace Tensor\Benchmarks\Arithmetic;
+
+use Tensor\Matrix;
+
+/**
+ * @Groups({"Arithmetic"})
+ * @BeforeMethods({"setUp"})
+ */
+class MatrixAxpyBench
+{
+    /**
+     * @var Matrix
+     */
+    protected $a;
+
+    /**
+     * @var Matrix
+     */
+    protected $b;
+
+    public function setUp() : void
+    {
+        $this->a = Matrix::uniform(500, 500);
+
+        $this->b = Matrix::uniform(500, 500);
+    }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("seconds", precision=3)
+     */
+    public function subtractMatrix() : void
+    {
+        $this->a = $this->a->subtractMatrix($this->b->multiplyScalar(0.01));
+    }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("seconds", precision=3)
+     */
+    public function axpy() : void
+    {
+        $this->a->axpy(-0.01, $this->b);
+    }
+}
@@ -0,0 +1,32 @@
+<?php
+
+namespace Tensor\Benchmarks\Functions;
+
+use Tensor\Matrix;
+
+/**
+ * @Groups({"Functions"})
+ * @BeforeMethods({"setUp"})
+ */
+class ArgmaxMatrixBench
+{
+    /**
+     * @var Matrix
+     */
+    protected $a;
+
+    public function setUp() : void
+    {
+        $this->a = Matrix::uniform(500, 500);
+    }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("milliseconds", precision=3)
+     */
+    public function argmax() : void
+    {
+        $this->a->argmax();
+    }
+}
@@ -0,0 +1,77 @@
+<?php
+
+namespace Tensor\Benchmarks\Functions;
+
+use Tensor\Matrix;
+use Tensor\Settings;
+
+/**
+ * @Groups({"Functions"})
+ * @BeforeMethods({"setUp"})
+ */
+class FastMathMatrixBench
+{
+    /**
+     * @var Matrix
+     */
+    protected $a;
+
+    public function setUp() : void
+    {
+        if (extension_loaded('tensor')) {
+            Settings::setFastMath(true);
+        }
+
+        $this->a = Matrix::uniform(500, 500);
+    }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("seconds", precision=3)
+     */
+    public function exp() : void
+    {
+        $this->a->exp();
+    }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("seconds", precision=3)
+     */
+    public function log() : void
+    {
+        $this->a->log();
+    }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("seconds", precision=3)
+     */
+    public function sin() : void
+    {
+        $this->a->sin();
+    }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("seconds", precision=3)
+     */
+    public function cos() : void
+    {
+        $this->a->cos();
+    }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("seconds", precision=3)
+     */
+    public function tan() : void
+    {
+        $this->a->tan();
+    }
+}
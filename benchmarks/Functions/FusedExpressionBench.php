@@ -0,0 +1,66 @@
+<?php
+
+namespace Tensor\Benchmarks\Functions;
+
+use Tensor\Matrix;
+
+/**
+ * @Groups({"Functions"})
+ * @BeforeMethods({"setUp"})
+ */
+class FusedExpressionBench
+{
+    /**
+     * @var Matrix
+     */
+    protected $a;
+
+    public function setUp() : void
+    {
+        $this->a = Matrix::uniform(500, 500);
+    }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("seconds", precision=3)
+     */
+    public function unfusedVariance() : void
+    {
+        $this->a->subtractColumnVector($this->a->mean())->square()->sum();
+    }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("seconds", precision=3)
+     */
+    public function fusedVariance() : void
+    {
+        $this->a->expr()->subtract($this->a->mean())->square()->sum();
+    }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("seconds", precision=3)
+     */
+    public function unfusedSoftmax() : void
+    {
+        $b = $this->a->subtractColumnVector($this->a->max())->exp();
+
+        $b->divideColumnVector($b->sum());
+    }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("seconds", precision=3)
+     */
+    public function fusedSoftmax() : void
+    {
+        $b = $this->a->expr()->subtract($this->a->max())->exp()->evaluate();
+
+        $b->divideColumnVector($b->sum());
+    }
+}
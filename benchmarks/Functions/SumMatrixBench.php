@@ -29,4 +29,14 @@ class SumMatrixBench
     {
         $this->a->sum();
     }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("milliseconds", precision=3)
+     */
+    public function sumColumns() : void
+    {
+        $this->a->sum(0);
+    }
 }
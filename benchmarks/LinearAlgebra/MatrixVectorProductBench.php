@@ -0,0 +1,50 @@
+<?php
+
+namespace Tensor\Benchmarks\LinearAlgebra;
+
+use Tensor\Matrix;
+use Tensor\Vector;
+
+/**
+ * @Groups({"LinearAlgebra"})
+ * @BeforeMethods({"setUp"})
+ */
+class MatrixVectorProductBench
+{
+    /**
+     * @var Matrix
+     */
+    protected $a;
+
+    /**
+     * @var Vector
+     */
+    protected $b;
+
+    public function setUp() : void
+    {
+        $this->a = Matrix::uniform(500, 500);
+
+        $this->b = Vector::uniform(500);
+    }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("milliseconds", precision=3)
+     */
+    public function dot() : void
+    {
+        $this->a->dot($this->b);
+    }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("milliseconds", precision=3)
+     */
+    public function matmul() : void
+    {
+        $this->b->matmul($this->a);
+    }
+}
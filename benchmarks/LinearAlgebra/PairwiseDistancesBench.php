@@ -0,0 +1,59 @@
+<?php
+
+namespace Tensor\Benchmarks\LinearAlgebra;
+
+use Tensor\Matrix;
+
+/**
+ * @Groups({"LinearAlgebra"})
+ * @BeforeMethods({"setUp"})
+ */
+class PairwiseDistancesBench
+{
+    /**
+     * @var Matrix
+     */
+    protected $a;
+
+    /**
+     * @var Matrix
+     */
+    protected $b;
+
+    public function setUp() : void
+    {
+        $this->a = Matrix::uniform(500, 64);
+
+        $this->b = Matrix::uniform(1000, 64);
+    }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("seconds", precision=3)
+     */
+    public function euclidean() : void
+    {
+        $this->a->pairwiseDistances($this->b, 'euclidean');
+    }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("seconds", precision=3)
+     */
+    public function cosine() : void
+    {
+        $this->a->pairwiseDistances($this->b, 'cosine');
+    }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("seconds", precision=3)
+     */
+    public function manhattan() : void
+    {
+        $this->a->pairwiseDistances($this->b, 'manhattan');
+    }
+}
@@ -18,4 +18,14 @@ class PoissonMatrixBench
     {
         Matrix::poisson(500, 500);
     }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("seconds", precision=3)
+     */
+    public function poissonLargeLambda() : void
+    {
+        Matrix::poisson(500, 500, 100.0);
+    }
 }
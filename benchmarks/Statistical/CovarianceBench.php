@@ -29,4 +29,24 @@ class CovarianceBench
     {
         $this->a->covariance();
     }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("seconds", precision=3)
+     */
+    public function gram() : void
+    {
+        $this->a->gram();
+    }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("seconds", precision=3)
+     */
+    public function gemm() : void
+    {
+        $this->a->gemm($this->a, false, true);
+    }
 }
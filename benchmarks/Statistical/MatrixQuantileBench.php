@@ -29,4 +29,14 @@ class MatrixQuantileBench
     {
         $this->a->quantile(0.5);
     }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("seconds", precision=3)
+     */
+    public function quantiles() : void
+    {
+        $this->a->quantiles([0.25, 0.5, 0.75]);
+    }
 }
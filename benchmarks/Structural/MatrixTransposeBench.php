@@ -27,6 +27,16 @@ class MatrixTransposeBench
      */
     public function transpose() : void
     {
-        $this->a->transpose();
+        $this->a->transpose()->asArray();
+    }
+
+    /**
+     * @Subject
+     * @Iterations(5)
+     * @OutputTimeUnit("seconds", precision=3)
+     */
+    public function matmulTransposed() : void
+    {
+        $this->a->transpose()->matmul($this->a);
     }
 }
@@ -3,272 +3,222 @@
 #endif
 
 #include <php.h>
+#include <cblas.h>
+#include <Zend/zend_exceptions.h>
 #include "kernel/operators.h"
+#include "arithmetic.h"
+#include "buffer.h"
+#include "simd.h"
+
+/**
+ * Define the element-wise kernels of a binary function over two arrays and over an array and a
+ * scalar of the given element type.
+ */
+#define TENSOR_BINARY_FUNCTION(name, name_scalar, type, fn) \
+static void name(const type * a, const type * b, type * c, size_t n) \
+{ \
+    size_t i; \
+    for (i = 0; i < n; ++i) { \
+        c[i] = (type) fn(a[i], b[i]); \
+    } \
+} \
+static void name_scalar(const type * a, type b, type * c, size_t n) \
+{ \
+    size_t i; \
+    for (i = 0; i < n; ++i) { \
+        c[i] = (type) fn(a[i], b); \
+    } \
+}
 
-void tensor_multiply(zval * return_value, zval * a, zval * b)
-{
-    unsigned int i;
-    double product;
-	zval c;
-
-    zend_array * aa = Z_ARR_P(a);
-    zend_array * ab = Z_ARR_P(b);
+TENSOR_BINARY_FUNCTION(tensor_pow_kernel, tensor_pow_scalar_kernel, double, pow)
+TENSOR_BINARY_FUNCTION(tensor_mod_kernel, tensor_mod_scalar_kernel, double, tensor_modulus)
 
-    unsigned int n = zend_array_count(aa);
+TENSOR_BINARY_FUNCTION(tensor_pow_kernel32, tensor_pow_scalar_kernel32, float, powf)
+TENSOR_BINARY_FUNCTION(tensor_mod_kernel32, tensor_mod_scalar_kernel32, float, tensor_modulus)
 
-	array_init_size(&c, n);
+/**
+ * Throw a division by zero error if any divisor truncates to zero. The result is still filled in
+ * so the caller always receives a buffer of the expected shape.
+ *
+ * @param b
+ * @param n
+ */
+void tensor_check_modulus(const double * b, size_t n)
+{
+    size_t i;
 
     for (i = 0; i < n; ++i) {
-        product = zephir_get_doubleval(zend_hash_index_find(aa, i)) * zephir_get_doubleval(zend_hash_index_find(ab, i));
+        if (zend_dval_to_lval(b[i]) == 0) {
+            zend_throw_exception_ex(zend_ce_division_by_zero_error, 0, "Modulo by zero");
 
-	    add_next_index_double(&c, product);
+            return;
+        }
     }
-
-    RETVAL_ARR(Z_ARR(c));
 }
 
-void tensor_divide(zval * return_value, zval * a, zval * b)
+/**
+ * Throw a division by zero error if any element of buffer B truncates to zero.
+ *
+ * @param bb
+ */
+static void tensor_check_modulus_buffer(const tensor_buffer * bb)
 {
-    unsigned int i;
-    double quotient;
-	zval c;
+    size_t i;
 
-    zend_array * aa = Z_ARR_P(a);
-    zend_array * ab = Z_ARR_P(b);
+    size_t n = bb->m * bb->n;
 
-    unsigned int n = zend_array_count(aa);
+    if (bb->dtype != TENSOR_DTYPE_FLOAT32) {
+        tensor_check_modulus(bb->data, n);
 
-	array_init_size(&c, n);
+        return;
+    }
 
     for (i = 0; i < n; ++i) {
-        quotient = zephir_get_doubleval(zend_hash_index_find(aa, i)) / zephir_get_doubleval(zend_hash_index_find(ab, i));
+        if (zend_dval_to_lval(bb->single[i]) == 0) {
+            zend_throw_exception_ex(zend_ce_division_by_zero_error, 0, "Modulo by zero");
 
-	    add_next_index_double(&c, quotient);
+            return;
+        }
     }
-
-    RETVAL_ARR(Z_ARR(c));
 }
 
-void tensor_add(zval * return_value, zval * a, zval * b)
+void tensor_multiply(zval * return_value, zval * a, zval * b)
 {
-    unsigned int i;
-    double sum;
-	zval c;
-
-    zend_array * aa = Z_ARR_P(a);
-    zend_array * ab = Z_ARR_P(b);
-
-    unsigned int n = zend_array_count(aa);
-
-	array_init_size(&c, n);
-
-    for (i = 0; i < n; ++i) {
-        sum = zephir_get_doubleval(zend_hash_index_find(aa, i)) + zephir_get_doubleval(zend_hash_index_find(ab, i));
+    tensor_buffer_broadcast(return_value, a, b, 0, tensor_simd.multiply, tensor_simd.multiply_scalar, tensor_simd32.multiply, tensor_simd32.multiply_scalar);
+}
 
-	    add_next_index_double(&c, sum);
-    }
+void tensor_divide(zval * return_value, zval * a, zval * b)
+{
+    tensor_buffer_broadcast(return_value, a, b, 0, tensor_simd.divide, tensor_simd.divide_scalar, tensor_simd32.divide, tensor_simd32.divide_scalar);
+}
 
-    RETVAL_ARR(Z_ARR(c));
+void tensor_add(zval * return_value, zval * a, zval * b)
+{
+    tensor_buffer_broadcast(return_value, a, b, 0, tensor_simd.add, tensor_simd.add_scalar, tensor_simd32.add, tensor_simd32.add_scalar);
 }
 
 void tensor_subtract(zval * return_value, zval * a, zval * b)
 {
-    unsigned int i;
-    double difference;
-	zval c;
-
-    zend_array * aa = Z_ARR_P(a);
-    zend_array * ab = Z_ARR_P(b);
-
-    unsigned int n = zend_array_count(aa);
-
-	array_init_size(&c, n);
-
-    for (i = 0; i < n; ++i) {
-        difference = zephir_get_doubleval(zend_hash_index_find(aa, i)) - zephir_get_doubleval(zend_hash_index_find(ab, i));
-
-	    add_next_index_double(&c, difference);
-    }
-
-    RETVAL_ARR(Z_ARR(c));
+    tensor_buffer_broadcast(return_value, a, b, 0, tensor_simd.subtract, tensor_simd.subtract_scalar, tensor_simd32.subtract, tensor_simd32.subtract_scalar);
 }
 
 void tensor_pow(zval * return_value, zval * a, zval * b)
 {
-    unsigned int i;
-    double power;
-	zval c;
-
-    zend_array * aa = Z_ARR_P(a);
-    zend_array * ab = Z_ARR_P(b);
-
-    unsigned int n = zend_array_count(aa);
-
-	array_init_size(&c, n);
-
-    for (i = 0; i < n; ++i) {
-        power = pow(zephir_get_doubleval(zend_hash_index_find(aa, i)), zephir_get_doubleval(zend_hash_index_find(ab, i)));
-
-	    add_next_index_double(&c, power);
-    }
-
-    RETVAL_ARR(Z_ARR(c));
+    tensor_buffer_broadcast(return_value, a, b, 0, tensor_pow_kernel, tensor_pow_scalar_kernel, tensor_pow_kernel32, tensor_pow_scalar_kernel32);
 }
 
 void tensor_mod(zval * return_value, zval * a, zval * b)
 {
-    unsigned int i;
-    zval modulus;
-	zval c;
+    tensor_check_modulus_buffer(Z_TENSOR_BUFFER_P(b));
 
-    zend_array * aa = Z_ARR_P(a);
-    zend_array * ab = Z_ARR_P(b);
-
-    unsigned int n = zend_array_count(aa);
-
-	array_init_size(&c, n);
-
-    for (i = 0; i < n; ++i) {
-        mod_function(&modulus, zend_hash_index_find(aa, i), zend_hash_index_find(ab, i));
-
-	    add_next_index_zval(&c, &modulus);
-    }
-
-    RETVAL_ARR(Z_ARR(c));
+    tensor_buffer_broadcast(return_value, a, b, 0, tensor_mod_kernel, tensor_mod_scalar_kernel, tensor_mod_kernel32, tensor_mod_scalar_kernel32);
 }
 
-void tensor_multiply_scalar(zval * return_value, zval * a, zval * b)
+void tensor_multiply_column(zval * return_value, zval * a, zval * b)
 {
-    unsigned int i;
-    double product;
-	zval c;
+    tensor_buffer_broadcast(return_value, a, b, 1, tensor_simd.multiply, tensor_simd.multiply_scalar, tensor_simd32.multiply, tensor_simd32.multiply_scalar);
+}
 
-    zend_array * aa = Z_ARR_P(a);
+void tensor_divide_column(zval * return_value, zval * a, zval * b)
+{
+    tensor_buffer_broadcast(return_value, a, b, 1, tensor_simd.divide, tensor_simd.divide_scalar, tensor_simd32.divide, tensor_simd32.divide_scalar);
+}
 
-    double ab = zephir_get_doubleval(b);
+void tensor_add_column(zval * return_value, zval * a, zval * b)
+{
+    tensor_buffer_broadcast(return_value, a, b, 1, tensor_simd.add, tensor_simd.add_scalar, tensor_simd32.add, tensor_simd32.add_scalar);
+}
 
-    unsigned int n = zend_array_count(aa);
+void tensor_subtract_column(zval * return_value, zval * a, zval * b)
+{
+    tensor_buffer_broadcast(return_value, a, b, 1, tensor_simd.subtract, tensor_simd.subtract_scalar, tensor_simd32.subtract, tensor_simd32.subtract_scalar);
+}
 
-	array_init_size(&c, n);
+void tensor_pow_column(zval * return_value, zval * a, zval * b)
+{
+    tensor_buffer_broadcast(return_value, a, b, 1, tensor_pow_kernel, tensor_pow_scalar_kernel, tensor_pow_kernel32, tensor_pow_scalar_kernel32);
+}
 
-    for (i = 0; i < n; ++i) {
-        product = zephir_get_doubleval(zend_hash_index_find(aa, i)) * ab;
+void tensor_mod_column(zval * return_value, zval * a, zval * b)
+{
+    tensor_check_modulus_buffer(Z_TENSOR_BUFFER_P(b));
 
-	    add_next_index_double(&c, product);
-    }
+    tensor_buffer_broadcast(return_value, a, b, 1, tensor_mod_kernel, tensor_mod_scalar_kernel, tensor_mod_kernel32, tensor_mod_scalar_kernel32);
+}
 
-    RETVAL_ARR(Z_ARR(c));
+void tensor_multiply_scalar(zval * return_value, zval * a, zval * b)
+{
+    tensor_buffer_apply_scalar(return_value, a, b, tensor_simd.multiply_scalar, tensor_simd32.multiply_scalar);
 }
 
 void tensor_divide_scalar(zval * return_value, zval * a, zval * b)
 {
-    unsigned int i;
-    double quotient;
-	zval c;
-
-    zend_array * aa = Z_ARR_P(a);
-
-    double ab = zephir_get_doubleval(b);
-
-    unsigned int n = zend_array_count(aa);
-
-	array_init_size(&c, n);
-
-    for (i = 0; i < n; ++i) {
-        quotient = zephir_get_doubleval(zend_hash_index_find(aa, i)) / ab;
-
-	    add_next_index_double(&c, quotient);
-    }
-
-    RETVAL_ARR(Z_ARR(c));
+    tensor_buffer_apply_scalar(return_value, a, b, tensor_simd.divide_scalar, tensor_simd32.divide_scalar);
 }
 
 void tensor_add_scalar(zval * return_value, zval * a, zval * b)
 {
-    unsigned int i;
-    double sum;
-	zval c;
-
-    zend_array * aa = Z_ARR_P(a);
-
-    double ab = zephir_get_doubleval(b);
-
-    unsigned int n = zend_array_count(aa);
-
-	array_init_size(&c, n);
-
-    for (i = 0; i < n; ++i) {
-        sum = zephir_get_doubleval(zend_hash_index_find(aa, i)) + ab;
-
-	    add_next_index_double(&c, sum);
-    }
-
-    RETVAL_ARR(Z_ARR(c));
+    tensor_buffer_apply_scalar(return_value, a, b, tensor_simd.add_scalar, tensor_simd32.add_scalar);
 }
 
 void tensor_subtract_scalar(zval * return_value, zval * a, zval * b)
 {
-    unsigned int i;
-    double difference;
-	zval c;
-
-    zend_array * aa = Z_ARR_P(a);
-
-    double ab = zephir_get_doubleval(b);
-
-    unsigned int n = zend_array_count(aa);
-
-	array_init_size(&c, n);
-
-    for (i = 0; i < n; ++i) {
-        difference = zephir_get_doubleval(zend_hash_index_find(aa, i)) - ab;
-
-	    add_next_index_double(&c, difference);
-    }
-
-    RETVAL_ARR(Z_ARR(c));
+    tensor_buffer_apply_scalar(return_value, a, b, tensor_simd.subtract_scalar, tensor_simd32.subtract_scalar);
 }
 
 void tensor_pow_scalar(zval * return_value, zval * a, zval * b)
 {
-    unsigned int i;
-    double power;
-	zval c;
+    tensor_buffer_apply_scalar(return_value, a, b, tensor_pow_scalar_kernel, tensor_pow_scalar_kernel32);
+}
 
-    zend_array * aa = Z_ARR_P(a);
+void tensor_mod_scalar(zval * return_value, zval * a, zval * b)
+{
+    double divisor = zephir_get_doubleval(b);
 
-    double ab = zephir_get_doubleval(b);
+    tensor_check_modulus(&divisor, 1);
 
-    unsigned int n = zend_array_count(aa);
+    tensor_buffer_apply_scalar(return_value, a, b, tensor_mod_scalar_kernel, tensor_mod_scalar_kernel32);
+}
 
-	array_init_size(&c, n);
+/**
+ * Add alpha times buffer B to buffer A in place and return A.
+ *
+ * @param return_value
+ * @param a
+ * @param b
+ * @param alpha
+ */
+void tensor_axpy_in_place(zval * return_value, zval * a, zval * b, zval * alpha)
+{
+    tensor_buffer * bb = Z_TENSOR_BUFFER_P(b);
 
-    for (i = 0; i < n; ++i) {
-        power = pow(zephir_get_doubleval(zend_hash_index_find(aa, i)), ab);
+    tensor_buffer * bc = tensor_buffer_separate(return_value, a);
 
-	    add_next_index_double(&c, power);
+    if (bc->dtype == TENSOR_DTYPE_FLOAT32) {
+        cblas_saxpy(bc->m * bc->n, (float) zephir_get_doubleval(alpha), bb->single, 1, bc->single, 1);
+
+        return;
     }
 
-    RETVAL_ARR(Z_ARR(c));
+    cblas_daxpy(bc->m * bc->n, zephir_get_doubleval(alpha), bb->data, 1, bc->data, 1);
 }
 
-void tensor_mod_scalar(zval * return_value, zval * a, zval * b)
+/**
+ * Multiply buffer A by a scalar in place and return A.
+ *
+ * @param return_value
+ * @param a
+ * @param alpha
+ */
+void tensor_scale_in_place(zval * return_value, zval * a, zval * alpha)
 {
-    unsigned int i;
-    zval modulus;
-	zval c;
-
-    zend_array * aa = Z_ARR_P(a);
+    tensor_buffer * bc = tensor_buffer_separate(return_value, a);
 
-    unsigned int n = zend_array_count(aa);
-
-	array_init_size(&c, n);
-
-    for (i = 0; i < n; ++i) {
-        mod_function(&modulus, zend_hash_index_find(aa, i), b);
+    if (bc->dtype == TENSOR_DTYPE_FLOAT32) {
+        cblas_sscal(bc->m * bc->n, (float) zephir_get_doubleval(alpha), bc->single, 1);
 
-	    add_next_index_zval(&c, &modulus);
+        return;
     }
 
-    RETVAL_ARR(Z_ARR(c));
+    cblas_dscal(bc->m * bc->n, zephir_get_doubleval(alpha), bc->data, 1);
 }
@@ -2,6 +2,27 @@
 #define TENSOR_ARITHMETIC_H
 
 #include <Zend/zend.h>
+#include <Zend/zend_operators.h>
+
+/**
+ * Integer modulus of two doubles with the same semantics as the PHP % operator.
+ *
+ * @param a
+ * @param b
+ * @return double
+ */
+static inline double tensor_modulus(double a, double b)
+{
+    zend_long lb = zend_dval_to_lval(b);
+
+    if (lb == 0 || lb == -1) {
+        return 0.0;
+    }
+
+    return (double) (zend_dval_to_lval(a) % lb);
+}
+
+void tensor_check_modulus(const double * b, size_t n);
 
 void tensor_multiply(zval * return_value, zval * a, zval * b);
 void tensor_divide(zval * return_value, zval * a, zval * b);
@@ -10,6 +31,13 @@ void tensor_subtract(zval * return_value, zval * a, zval * b);
 void tensor_pow(zval * return_value, zval * a, zval * b);
 void tensor_mod(zval * return_value, zval * a, zval * b);
 
+void tensor_multiply_column(zval * return_value, zval * a, zval * b);
+void tensor_divide_column(zval * return_value, zval * a, zval * b);
+void tensor_add_column(zval * return_value, zval * a, zval * b);
+void tensor_subtract_column(zval * return_value, zval * a, zval * b);
+void tensor_pow_column(zval * return_value, zval * a, zval * b);
+void tensor_mod_column(zval * return_value, zval * a, zval * b);
+
 void tensor_multiply_scalar(zval * return_value, zval * a, zval * b);
 void tensor_divide_scalar(zval * return_value, zval * a, zval * b);
 void tensor_add_scalar(zval * return_value, zval * a, zval * b);
@@ -17,4 +45,7 @@ void tensor_subtract_scalar(zval * return_value, zval * a, zval * b);
 void tensor_pow_scalar(zval * return_value, zval * a, zval * b);
 void tensor_mod_scalar(zval * return_value, zval * a, zval * b);
 
+void tensor_axpy_in_place(zval * return_value, zval * a, zval * b, zval * alpha);
+void tensor_scale_in_place(zval * return_value, zval * a, zval * alpha);
+
 #endif
@@ -0,0 +1,671 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <php.h>
+#include <Zend/zend_interfaces.h>
+#include "kernel/operators.h"
+#include "buffer.h"
+#include "context.h"
+#include "parallel.h"
+
+zend_class_entry * tensor_buffer_ce;
+
+static zend_object_handlers tensor_buffer_handlers;
+
+static zend_object_handlers tensor_backed_handlers;
+
+/**
+ * Allocate an empty buffer object for the class entry.
+ *
+ * @param ce
+ * @return zend_object
+ */
+static zend_object * tensor_buffer_create(zend_class_entry * ce)
+{
+    tensor_buffer * buffer = zend_object_alloc(sizeof(tensor_buffer), ce);
+
+    buffer->data = NULL;
+    buffer->m = 0;
+    buffer->n = 0;
+    buffer->dtype = TENSOR_DTYPE_FLOAT64;
+    buffer->persistent = 0;
+
+    zend_object_std_init(&buffer->std, ce);
+    object_properties_init(&buffer->std, ce);
+
+    buffer->std.handlers = &tensor_buffer_handlers;
+
+    return &buffer->std;
+}
+
+/**
+ * Release the memory held by a buffer object.
+ *
+ * @param object
+ */
+static void tensor_buffer_free(zend_object * object)
+{
+    tensor_buffer * buffer = tensor_buffer_from_object(object);
+
+    if (buffer->data) {
+        pefree(buffer->data, buffer->persistent);
+    }
+
+    zend_object_std_dtor(object);
+}
+
+/**
+ * Copy the elements of a buffer into a newly allocated buffer object.
+ *
+ * @param object
+ * @return zend_object
+ */
+static zend_object * tensor_buffer_clone(zend_object * object)
+{
+    tensor_buffer * buffer = tensor_buffer_from_object(object);
+
+    tensor_buffer * copy = tensor_buffer_from_object(tensor_buffer_create(object->ce));
+
+    size_t size = tensor_dtype_size(buffer->dtype);
+
+    copy->m = buffer->m;
+    copy->n = buffer->n;
+    copy->dtype = buffer->dtype;
+    copy->persistent = buffer->persistent;
+
+    if (buffer->data) {
+        copy->data = safe_pemalloc(buffer->m * buffer->n, size, 0, buffer->persistent);
+
+        memcpy(copy->data, buffer->data, buffer->m * buffer->n * size);
+    }
+
+    zend_objects_clone_members(&copy->std, object);
+
+    return &copy->std;
+}
+
+/**
+ * Unpack the elements of a tensor backed by a buffer into its array so that its properties reflect
+ * its contents.
+ *
+ * @param object
+ */
+static void tensor_backed_materialize(zend_object * object)
+{
+    zval retval;
+
+    zend_call_method_with_0_params(object, object->ce, NULL, "asarray", &retval);
+
+    zval_ptr_dtor(&retval);
+}
+
+/**
+ * Return the properties of a tensor with its elements unpacked into the array and the native buffer
+ * and transposed view left out, so that array casts, var_dump(), and var_export() show the same
+ * properties for a tensor regardless of how it was built.
+ *
+ * @param object
+ * @param purpose
+ * @return HashTable
+ */
+static HashTable * tensor_backed_get_properties_for(zend_object * object, zend_prop_purpose purpose)
+{
+    HashTable * properties;
+    zval null;
+
+    switch (purpose) {
+        case ZEND_PROP_PURPOSE_DEBUG:
+        case ZEND_PROP_PURPOSE_ARRAY_CAST:
+        case ZEND_PROP_PURPOSE_VAR_EXPORT:
+        case ZEND_PROP_PURPOSE_JSON:
+            break;
+
+        default:
+            return zend_std_get_properties_for(object, purpose);
+    }
+
+    tensor_backed_materialize(object);
+
+    properties = zend_array_dup(zend_std_get_properties(object));
+
+    ZVAL_NULL(&null);
+
+    if (zend_hash_str_exists(properties, "\0*\0buffer", sizeof("\0*\0buffer") - 1)) {
+        zend_hash_str_update(properties, "\0*\0buffer", sizeof("\0*\0buffer") - 1, &null);
+    }
+
+    if (zend_hash_str_exists(properties, "\0*\0transposed", sizeof("\0*\0transposed") - 1)) {
+        zend_hash_str_update(properties, "\0*\0transposed", sizeof("\0*\0transposed") - 1, &null);
+    }
+
+    return properties;
+}
+
+/**
+ * Compare two tensors of the same class by their elements rather than by their native buffers.
+ *
+ * @param o1
+ * @param o2
+ * @return int
+ */
+static int tensor_backed_compare(zval * o1, zval * o2)
+{
+    int result;
+
+    ZEND_COMPARE_OBJECTS_FALLBACK(o1, o2);
+
+    if (Z_OBJCE_P(o1) != Z_OBJCE_P(o2)) {
+        return zend_std_compare_objects(o1, o2);
+    }
+
+    HashTable * a = tensor_backed_get_properties_for(Z_OBJ_P(o1), ZEND_PROP_PURPOSE_ARRAY_CAST);
+    HashTable * b = tensor_backed_get_properties_for(Z_OBJ_P(o2), ZEND_PROP_PURPOSE_ARRAY_CAST);
+
+    result = zend_compare_symbol_tables(a, b);
+
+    zend_array_release(a);
+    zend_array_release(b);
+
+    return result;
+}
+
+/**
+ * Allocate an object of a tensor class that is backed by a buffer.
+ *
+ * @param ce
+ * @return zend_object
+ */
+static zend_object * tensor_backed_create(zend_class_entry * ce)
+{
+    zend_object * object = zend_objects_new(ce);
+
+    object_properties_init(object, ce);
+
+    object->handlers = &tensor_backed_handlers;
+
+    return object;
+}
+
+/**
+ * Install the tensor handlers on a class registered under the given lowercase name. Subclasses
+ * declared afterwards inherit them.
+ *
+ * @param name
+ * @param length
+ */
+static void tensor_backed_attach(const char * name, size_t length)
+{
+    zend_class_entry * ce = zend_hash_str_find_ptr(CG(class_table), name, length);
+
+    if (ce) {
+        ce->create_object = tensor_backed_create;
+    }
+}
+
+/**
+ * Register the buffer class with the engine and install the handlers of the classes that are backed
+ * by buffers. Called once at module startup after the classes of the extension are registered.
+ */
+void tensor_buffer_init()
+{
+    zend_class_entry ce;
+
+    INIT_NS_CLASS_ENTRY(ce, "Tensor", "Buffer", NULL);
+
+    tensor_buffer_ce = zend_register_internal_class(&ce);
+
+    tensor_buffer_ce->ce_flags |= ZEND_ACC_FINAL;
+    tensor_buffer_ce->create_object = tensor_buffer_create;
+
+#ifdef ZEND_ACC_NOT_SERIALIZABLE
+    tensor_buffer_ce->ce_flags |= ZEND_ACC_NOT_SERIALIZABLE;
+#endif
+
+    memcpy(&tensor_buffer_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
+
+    tensor_buffer_handlers.offset = XtOffsetOf(tensor_buffer, std);
+    tensor_buffer_handlers.free_obj = tensor_buffer_free;
+    tensor_buffer_handlers.clone_obj = tensor_buffer_clone;
+
+    memcpy(&tensor_backed_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
+
+    tensor_backed_handlers.get_properties_for = tensor_backed_get_properties_for;
+
+    tensor_backed_handlers.compare = tensor_backed_compare;
+
+    tensor_backed_attach(ZEND_STRL("tensor\\matrix"));
+    tensor_backed_attach(ZEND_STRL("tensor\\vector"));
+    tensor_backed_attach(ZEND_STRL("tensor\\columnvector"));
+}
+
+/**
+ * Allocate an uninitialized m x n buffer of doubles with the allocator of the current context and
+ * return it in the given zval.
+ *
+ * @param return_value
+ * @param m
+ * @param n
+ * @return tensor_buffer
+ */
+tensor_buffer * tensor_buffer_alloc(zval * return_value, zend_long m, zend_long n)
+{
+    return tensor_buffer_alloc_dtype(return_value, m, n, TENSOR_DTYPE_FLOAT64);
+}
+
+/**
+ * Allocate an uninitialized m x n buffer of the given dtype with the allocator of the current
+ * context and return it in the given zval.
+ *
+ * @param return_value
+ * @param m
+ * @param n
+ * @param dtype
+ * @return tensor_buffer
+ */
+tensor_buffer * tensor_buffer_alloc_dtype(zval * return_value, zend_long m, zend_long n, zend_long dtype)
+{
+    object_init_ex(return_value, tensor_buffer_ce);
+
+    tensor_buffer * buffer = Z_TENSOR_BUFFER_P(return_value);
+
+    buffer->m = m;
+    buffer->n = n;
+    buffer->dtype = dtype;
+    buffer->persistent = tensor_allocator == TENSOR_ALLOCATOR_SYSTEM;
+
+    if (m > 0 && n > 0) {
+        buffer->data = safe_pemalloc(m * n, tensor_dtype_size(dtype), 0, buffer->persistent);
+    }
+
+    return buffer;
+}
+
+/**
+ * Return buffer A in the given zval ready to be written to in place. The buffer is reused when the
+ * caller holds the only reference to it, otherwise it is copied so that no other tensor observes
+ * the write.
+ *
+ * @param return_value
+ * @param a
+ * @return tensor_buffer
+ */
+tensor_buffer * tensor_buffer_separate(zval * return_value, zval * a)
+{
+    zend_object * object = Z_OBJ_P(a);
+
+    if (GC_REFCOUNT(object) > 1) {
+        ZVAL_OBJ(return_value, object->handlers->clone_obj(object));
+    } else {
+        ZVAL_COPY(return_value, a);
+    }
+
+    return Z_TENSOR_BUFFER_P(return_value);
+}
+
+/**
+ * Pack a 1-d or 2-d array of numbers into a contiguous row-major buffer. Vectors are packed as a single row
+ * and rows shorter than the first are padded with zeros.
+ *
+ * @param return_value
+ * @param a
+ */
+void tensor_buffer_from_array(zval * return_value, zval * a)
+{
+    unsigned int i, j;
+    zval * row = NULL;
+    zval * value;
+
+    zend_array * aa = Z_ARR_P(a);
+
+    unsigned int m = zend_array_count(aa);
+
+    ZEND_HASH_FOREACH_VAL(aa, value) {
+        row = value;
+
+        break;
+    } ZEND_HASH_FOREACH_END();
+
+    if (row && Z_TYPE_P(row) == IS_ARRAY) {
+        unsigned int n = zend_array_count(Z_ARR_P(row));
+
+        tensor_buffer * b = tensor_buffer_alloc(return_value, m, n);
+
+        i = 0;
+
+        ZEND_HASH_FOREACH_VAL(aa, row) {
+            j = 0;
+
+            if (Z_TYPE_P(row) == IS_ARRAY) {
+                ZEND_HASH_FOREACH_VAL(Z_ARR_P(row), value) {
+                    if (j >= n) {
+                        break;
+                    }
+
+                    b->data[i * n + j] = zephir_get_doubleval(value);
+
+                    ++j;
+                } ZEND_HASH_FOREACH_END();
+            }
+
+            for (; j < n; ++j) {
+                b->data[i * n + j] = 0.0;
+            }
+
+            ++i;
+        } ZEND_HASH_FOREACH_END();
+
+        return;
+    }
+
+    tensor_buffer * b = tensor_buffer_alloc(return_value, m > 0 ? 1 : 0, m);
+
+    i = 0;
+
+    ZEND_HASH_FOREACH_VAL(aa, value) {
+        b->data[i] = zephir_get_doubleval(value);
+
+        ++i;
+    } ZEND_HASH_FOREACH_END();
+}
+
+/**
+ * Unpack a buffer into a 2-dimensional array.
+ *
+ * @param return_value
+ * @param buffer
+ */
+void tensor_buffer_to_matrix(zval * return_value, zval * buffer)
+{
+    unsigned int i, j;
+    zval rowB, b;
+
+    tensor_buffer * a = Z_TENSOR_BUFFER_P(buffer);
+
+    array_init_size(&b, a->m);
+
+    for (i = 0; i < a->m; ++i) {
+        array_init_size(&rowB, a->n);
+
+        for (j = 0; j < a->n; ++j) {
+            if (a->dtype == TENSOR_DTYPE_FLOAT32) {
+                add_next_index_double(&rowB, a->single[i * a->n + j]);
+            } else if (a->dtype == TENSOR_DTYPE_BOOL) {
+                add_next_index_bool(&rowB, a->mask[i * a->n + j]);
+            } else {
+                add_next_index_double(&rowB, a->data[i * a->n + j]);
+            }
+        }
+
+        add_next_index_zval(&b, &rowB);
+    }
+
+    RETVAL_ARR(Z_ARR(b));
+}
+
+/**
+ * Unpack a buffer into a 1-dimensional array.
+ *
+ * @param return_value
+ * @param buffer
+ */
+void tensor_buffer_to_vector(zval * return_value, zval * buffer)
+{
+    unsigned int i;
+    zval b;
+
+    tensor_buffer * a = Z_TENSOR_BUFFER_P(buffer);
+
+    unsigned int n = a->m * a->n;
+
+    array_init_size(&b, n);
+
+    for (i = 0; i < n; ++i) {
+        if (a->dtype == TENSOR_DTYPE_FLOAT32) {
+            add_next_index_double(&b, a->single[i]);
+        } else if (a->dtype == TENSOR_DTYPE_BOOL) {
+            add_next_index_bool(&b, a->mask[i]);
+        } else {
+            add_next_index_double(&b, a->data[i]);
+        }
+    }
+
+    RETVAL_ARR(Z_ARR(b));
+}
+
+/**
+ * Return the dimensionality of a buffer as a tuple.
+ *
+ * @param return_value
+ * @param buffer
+ */
+void tensor_buffer_shape(zval * return_value, zval * buffer)
+{
+    zval shape;
+
+    tensor_buffer * a = Z_TENSOR_BUFFER_P(buffer);
+
+    array_init_size(&shape, 2);
+
+    add_next_index_long(&shape, a->m);
+    add_next_index_long(&shape, a->n);
+
+    RETVAL_ARR(Z_ARR(shape));
+}
+
+/**
+ * Return the dtype of a buffer.
+ *
+ * @param return_value
+ * @param buffer
+ */
+void tensor_buffer_dtype(zval * return_value, zval * buffer)
+{
+    RETURN_LONG(Z_TENSOR_BUFFER_P(buffer)->dtype);
+}
+
+/**
+ * Convert the elements of a buffer to the given dtype and return them in a new buffer. Narrowing
+ * to single precision rounds each element to the nearest float. Masks convert to 1 where they
+ * hold and 0 otherwise.
+ *
+ * @param return_value
+ * @param buffer
+ * @param dtype
+ */
+void tensor_buffer_cast(zval * return_value, zval * buffer, zval * dtype)
+{
+    size_t i;
+
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(buffer);
+
+    zend_long target = zephir_get_intval(dtype);
+
+    size_t n = ba->m * ba->n;
+
+    tensor_buffer * bb = tensor_buffer_alloc_dtype(return_value, ba->m, ba->n, target);
+
+    if (n == 0) {
+        return;
+    }
+
+    if (ba->dtype == target) {
+        memcpy(bb->data, ba->data, n * tensor_dtype_size(target));
+    } else if (ba->dtype == TENSOR_DTYPE_BOOL && target == TENSOR_DTYPE_FLOAT32) {
+        for (i = 0; i < n; ++i) {
+            bb->single[i] = ba->mask[i] ? 1.0f : 0.0f;
+        }
+    } else if (ba->dtype == TENSOR_DTYPE_BOOL) {
+        for (i = 0; i < n; ++i) {
+            bb->data[i] = ba->mask[i] ? 1.0 : 0.0;
+        }
+    } else if (target == TENSOR_DTYPE_FLOAT32) {
+        for (i = 0; i < n; ++i) {
+            bb->single[i] = (float) ba->data[i];
+        }
+    } else {
+        for (i = 0; i < n; ++i) {
+            bb->data[i] = (double) ba->single[i];
+        }
+    }
+}
+
+/**
+ * Return an m x n buffer of the given dtype with every element set to value.
+ *
+ * @param return_value
+ * @param value
+ * @param m
+ * @param n
+ * @param dtype
+ */
+void tensor_buffer_fill(zval * return_value, zval * value, zval * m, zval * n, zval * dtype)
+{
+    size_t i;
+
+    double v = zephir_get_doubleval(value);
+
+    tensor_buffer * bb = tensor_buffer_alloc_dtype(return_value, zephir_get_intval(m), zephir_get_intval(n), zephir_get_intval(dtype));
+
+    size_t k = bb->m * bb->n;
+
+    if (bb->dtype == TENSOR_DTYPE_FLOAT32) {
+        for (i = 0; i < k; ++i) {
+            bb->single[i] = (float) v;
+        }
+    } else {
+        for (i = 0; i < k; ++i) {
+            bb->data[i] = v;
+        }
+    }
+}
+
+typedef struct _tensor_broadcast_job {
+    const void * a;
+    const void * b;
+    void * c;
+    zend_long ma, na;
+    zend_long mb, nb;
+    zend_long n;
+    tensor_simd_binary op;
+    tensor_simd_scalar op_scalar;
+    tensor_simd_binary32 op32;
+    tensor_simd_scalar32 op32_scalar;
+} tensor_broadcast_job;
+
+/**
+ * Define a task that broadcasts the operation over rows start through end of the output. Runs
+ * on pool threads so the scratch row is allocated with malloc rather than the request allocator.
+ */
+#define TENSOR_BROADCAST_TASK(name, type, op, op_scalar) \
+static void name(void * context, size_t start, size_t end) \
+{ \
+    zend_long i, j; \
+    tensor_broadcast_job * job = context; \
+    zend_long n = job->n; \
+    type * row = job->na == n ? NULL : malloc(n * sizeof(type)); \
+    for (i = start; i < end; ++i) { \
+        const type * va = (const type *) job->a + (job->ma == 1 ? 0 : i * job->na); \
+        const type * vb = (const type *) job->b + (job->mb == 1 ? 0 : i * job->nb); \
+        type * vc = (type *) job->c + i * n; \
+        if (job->na == job->nb) { \
+            job->op(va, vb, vc, n); \
+        } else if (job->nb == 1) { \
+            job->op_scalar(va, *vb, vc, n); \
+        } else { \
+            for (j = 0; j < n; ++j) { \
+                row[j] = *va; \
+            } \
+            job->op(row, vb, vc, n); \
+        } \
+    } \
+    free(row); \
+}
+
+TENSOR_BROADCAST_TASK(tensor_broadcast_task, double, op, op_scalar)
+TENSOR_BROADCAST_TASK(tensor_broadcast_task32, float, op32, op32_scalar)
+
+/**
+ * Apply an element-wise operation to buffers A and B and return the result in a new buffer. Either
+ * operand may be a single row, or a single column when the column flag is set, in which case it is
+ * broadcast across the other. Vectors are stored as a single row, so the column flag tells the
+ * kernel to read the vector operand down the rows instead. Both operands must share a dtype, which
+ * selects between the double and single precision kernels.
+ *
+ * @param return_value
+ * @param a
+ * @param b
+ * @param column
+ * @param op
+ * @param op_scalar
+ * @param op32
+ * @param op32_scalar
+ */
+void tensor_buffer_broadcast(zval * return_value, zval * a, zval * b, zend_bool column, tensor_simd_binary op, tensor_simd_scalar op_scalar, tensor_simd_binary32 op32, tensor_simd_scalar32 op32_scalar)
+{
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+    tensor_buffer * bb = Z_TENSOR_BUFFER_P(b);
+
+    zend_long ma = ba->m, na = ba->n;
+    zend_long mb = bb->m, nb = bb->n;
+
+    zend_bool single = ba->dtype == TENSOR_DTYPE_FLOAT32;
+
+    if (column) {
+        if (ma == 1 && mb != 1) {
+            ma = na;
+            na = 1;
+        } else if (mb == 1 && ma != 1) {
+            mb = nb;
+            nb = 1;
+        }
+    }
+
+    zend_long m = MAX(ma, mb);
+    zend_long n = MAX(na, nb);
+
+    tensor_buffer * bc = tensor_buffer_alloc_dtype(return_value, m, n, ba->dtype);
+
+    if (ma == mb && na == nb) {
+        if (single) {
+            tensor_parallel_binary32(op32, ba->single, bb->single, bc->single, m * n);
+        } else {
+            tensor_parallel_binary(op, ba->data, bb->data, bc->data, m * n);
+        }
+
+        return;
+    }
+
+    tensor_broadcast_job job = {
+        .a = ba->data, .b = bb->data, .c = bc->data,
+        .ma = ma, .na = na, .mb = mb, .nb = nb, .n = n,
+        .op = op, .op_scalar = op_scalar, .op32 = op32, .op32_scalar = op32_scalar,
+    };
+
+    tensor_parallel_for(m, MAX(1, tensor_grain_size / MAX(n, 1)), single ? tensor_broadcast_task32 : tensor_broadcast_task, &job);
+}
+
+/**
+ * Apply an element-wise operation to buffer A and a scalar B and return the result in a new buffer
+ * of the same dtype.
+ *
+ * @param return_value
+ * @param a
+ * @param b
+ * @param op
+ * @param op32
+ */
+void tensor_buffer_apply_scalar(zval * return_value, zval * a, zval * b, tensor_simd_scalar op, tensor_simd_scalar32 op32)
+{
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    tensor_buffer * bc = tensor_buffer_alloc_dtype(return_value, ba->m, ba->n, ba->dtype);
+
+    if (ba->dtype == TENSOR_DTYPE_FLOAT32) {
+        tensor_parallel_scalar32(op32, ba->single, (float) zephir_get_doubleval(b), bc->single, ba->m * ba->n);
+
+        return;
+    }
+
+    tensor_parallel_scalar(op, ba->data, zephir_get_doubleval(b), bc->data, ba->m * ba->n);
+}
@@ -0,0 +1,77 @@
+#ifndef TENSOR_BUFFER_H
+#define TENSOR_BUFFER_H
+
+#include <Zend/zend.h>
+#include "simd.h"
+
+enum {
+    TENSOR_DTYPE_FLOAT64,
+    TENSOR_DTYPE_FLOAT32,
+    TENSOR_DTYPE_BOOL
+};
+
+/**
+ * A contiguous row-major buffer of m x n elements. Double precision buffers are read through
+ * data, single precision buffers through single, and boolean masks through mask, the dtype
+ * tells which one is in use.
+ */
+typedef struct _tensor_buffer {
+    union {
+        double * data;
+        float * single;
+        zend_uchar * mask;
+    };
+    zend_long m;
+    zend_long n;
+    zend_uchar dtype;
+    zend_bool persistent;
+    zend_object std;
+} tensor_buffer;
+
+extern zend_class_entry * tensor_buffer_ce;
+
+static inline tensor_buffer * tensor_buffer_from_object(zend_object * object)
+{
+    return (tensor_buffer *) ((char *) object - XtOffsetOf(tensor_buffer, std));
+}
+
+#define Z_TENSOR_BUFFER_P(zv) tensor_buffer_from_object(Z_OBJ_P(zv))
+
+/**
+ * Return the size in bytes of a single element of the given dtype.
+ *
+ * @param dtype
+ * @return size_t
+ */
+static inline size_t tensor_dtype_size(zend_long dtype)
+{
+    switch (dtype) {
+        case TENSOR_DTYPE_FLOAT32:
+            return sizeof(float);
+
+        case TENSOR_DTYPE_BOOL:
+            return sizeof(zend_uchar);
+
+        default:
+            return sizeof(double);
+    }
+}
+
+void tensor_buffer_init();
+
+tensor_buffer * tensor_buffer_alloc(zval * return_value, zend_long m, zend_long n);
+tensor_buffer * tensor_buffer_alloc_dtype(zval * return_value, zend_long m, zend_long n, zend_long dtype);
+tensor_buffer * tensor_buffer_separate(zval * return_value, zval * a);
+
+void tensor_buffer_from_array(zval * return_value, zval * a);
+void tensor_buffer_to_matrix(zval * return_value, zval * buffer);
+void tensor_buffer_to_vector(zval * return_value, zval * buffer);
+void tensor_buffer_shape(zval * return_value, zval * buffer);
+void tensor_buffer_dtype(zval * return_value, zval * buffer);
+void tensor_buffer_cast(zval * return_value, zval * buffer, zval * dtype);
+void tensor_buffer_fill(zval * return_value, zval * value, zval * m, zval * n, zval * dtype);
+
+void tensor_buffer_broadcast(zval * return_value, zval * a, zval * b, zend_bool column, tensor_simd_binary op, tensor_simd_scalar op_scalar, tensor_simd_binary32 op32, tensor_simd_scalar32 op32_scalar);
+void tensor_buffer_apply_scalar(zval * return_value, zval * a, zval * b, tensor_simd_scalar op, tensor_simd_scalar32 op32);
+
+#endif
@@ -4,287 +4,147 @@
 
 #include <php.h>
 #include "kernel/operators.h"
+#include "buffer.h"
+
+/**
+ * Define an element-wise comparison of two arrays of the given element type that writes 1 where
+ * the comparison holds and 0 otherwise.
+ */
+#define TENSOR_COMPARISON(name, type, op) \
+static void name(const type * a, const type * b, type * c, size_t n) \
+{ \
+    size_t i; \
+    for (i = 0; i < n; ++i) { \
+        c[i] = a[i] op b[i] ? 1 : 0; \
+    } \
+}
 
-void tensor_equal(zval * return_value, zval * a, zval * b)
-{
-    unsigned int i;
-	zval c;
-
-    zend_array * aa = Z_ARR_P(a);
-    zend_array * ab = Z_ARR_P(b);
-
-    unsigned int n = zend_array_count(aa);
-
-	array_init_size(&c, n);
+/**
+ * Define an element-wise comparison of an array of the given element type and a scalar.
+ */
+#define TENSOR_COMPARISON_SCALAR(name, type, op) \
+static void name(const type * a, type b, type * c, size_t n) \
+{ \
+    size_t i; \
+    for (i = 0; i < n; ++i) { \
+        c[i] = a[i] op b ? 1 : 0; \
+    } \
+}
 
-    for (i = 0; i < n; ++i) {
-        if (zephir_get_doubleval(zend_hash_index_find(aa, i)) == zephir_get_doubleval(zend_hash_index_find(ab, i))) {
-            add_next_index_long(&c, 1);
-        } else {
-            add_next_index_long(&c, 0);
-        }
-    }
+TENSOR_COMPARISON(tensor_equal_kernel, double, ==)
+TENSOR_COMPARISON(tensor_not_equal_kernel, double, !=)
+TENSOR_COMPARISON(tensor_greater_kernel, double, >)
+TENSOR_COMPARISON(tensor_greater_equal_kernel, double, >=)
+TENSOR_COMPARISON(tensor_less_kernel, double, <)
+TENSOR_COMPARISON(tensor_less_equal_kernel, double, <=)
+
+TENSOR_COMPARISON_SCALAR(tensor_equal_scalar_kernel, double, ==)
+TENSOR_COMPARISON_SCALAR(tensor_not_equal_scalar_kernel, double, !=)
+TENSOR_COMPARISON_SCALAR(tensor_greater_scalar_kernel, double, >)
+TENSOR_COMPARISON_SCALAR(tensor_greater_equal_scalar_kernel, double, >=)
+TENSOR_COMPARISON_SCALAR(tensor_less_scalar_kernel, double, <)
+TENSOR_COMPARISON_SCALAR(tensor_less_equal_scalar_kernel, double, <=)
+
+TENSOR_COMPARISON(tensor_equal_kernel32, float, ==)
+TENSOR_COMPARISON(tensor_not_equal_kernel32, float, !=)
+TENSOR_COMPARISON(tensor_greater_kernel32, float, >)
+TENSOR_COMPARISON(tensor_greater_equal_kernel32, float, >=)
+TENSOR_COMPARISON(tensor_less_kernel32, float, <)
+TENSOR_COMPARISON(tensor_less_equal_kernel32, float, <=)
+
+TENSOR_COMPARISON_SCALAR(tensor_equal_scalar_kernel32, float, ==)
+TENSOR_COMPARISON_SCALAR(tensor_not_equal_scalar_kernel32, float, !=)
+TENSOR_COMPARISON_SCALAR(tensor_greater_scalar_kernel32, float, >)
+TENSOR_COMPARISON_SCALAR(tensor_greater_equal_scalar_kernel32, float, >=)
+TENSOR_COMPARISON_SCALAR(tensor_less_scalar_kernel32, float, <)
+TENSOR_COMPARISON_SCALAR(tensor_less_equal_scalar_kernel32, float, <=)
 
-    RETVAL_ARR(Z_ARR(c));
+void tensor_equal(zval * return_value, zval * a, zval * b)
+{
+    tensor_buffer_broadcast(return_value, a, b, 0, tensor_equal_kernel, tensor_equal_scalar_kernel, tensor_equal_kernel32, tensor_equal_scalar_kernel32);
 }
 
 void tensor_not_equal(zval * return_value, zval * a, zval * b)
 {
-    unsigned int i;
-	zval c;
-
-    zend_array * aa = Z_ARR_P(a);
-    zend_array * ab = Z_ARR_P(b);
-
-    unsigned int n = zend_array_count(aa);
-
-	array_init_size(&c, n);
-
-    for (i = 0; i < n; ++i) {
-        if (zephir_get_doubleval(zend_hash_index_find(aa, i)) != zephir_get_doubleval(zend_hash_index_find(ab, i))) {
-            add_next_index_long(&c, 1);
-        } else {
-            add_next_index_long(&c, 0);
-        }
-    }
-
-    RETVAL_ARR(Z_ARR(c));
+    tensor_buffer_broadcast(return_value, a, b, 0, tensor_not_equal_kernel, tensor_not_equal_scalar_kernel, tensor_not_equal_kernel32, tensor_not_equal_scalar_kernel32);
 }
 
 void tensor_greater(zval * return_value, zval * a, zval * b)
 {
-    unsigned int i;
-	zval c;
-
-    zend_array * aa = Z_ARR_P(a);
-    zend_array * ab = Z_ARR_P(b);
-
-    unsigned int n = zend_array_count(aa);
-
-	array_init_size(&c, n);
-
-    for (i = 0; i < n; ++i) {
-        if (zephir_get_doubleval(zend_hash_index_find(aa, i)) > zephir_get_doubleval(zend_hash_index_find(ab, i))) {
-            add_next_index_long(&c, 1);
-        } else {
-            add_next_index_long(&c, 0);
-        }
-    }
-
-    RETVAL_ARR(Z_ARR(c));
+    tensor_buffer_broadcast(return_value, a, b, 0, tensor_greater_kernel, tensor_greater_scalar_kernel, tensor_greater_kernel32, tensor_greater_scalar_kernel32);
 }
 
 void tensor_greater_equal(zval * return_value, zval * a, zval * b)
 {
-    unsigned int i;
-	zval c;
-
-    zend_array * aa = Z_ARR_P(a);
-    zend_array * ab = Z_ARR_P(b);
-
-    unsigned int n = zend_array_count(aa);
-
-	array_init_size(&c, n);
-
-    for (i = 0; i < n; ++i) {
-        if (zephir_get_doubleval(zend_hash_index_find(aa, i)) >= zephir_get_doubleval(zend_hash_index_find(ab, i))) {
-            add_next_index_long(&c, 1);
-        } else {
-            add_next_index_long(&c, 0);
-        }
-    }
-
-    RETVAL_ARR(Z_ARR(c));
+    tensor_buffer_broadcast(return_value, a, b, 0, tensor_greater_equal_kernel, tensor_greater_equal_scalar_kernel, tensor_greater_equal_kernel32, tensor_greater_equal_scalar_kernel32);
 }
 
 void tensor_less(zval * return_value, zval * a, zval * b)
 {
-    unsigned int i;
-	zval c;
-
-    zend_array * aa = Z_ARR_P(a);
-    zend_array * ab = Z_ARR_P(b);
-
-    unsigned int n = zend_array_count(aa);
-
-	array_init_size(&c, n);
-
-    for (i = 0; i < n; ++i) {
-        if (zephir_get_doubleval(zend_hash_index_find(aa, i)) < zephir_get_doubleval(zend_hash_index_find(ab, i))) {
-            add_next_index_long(&c, 1);
-        } else {
-            add_next_index_long(&c, 0);
-        }
-    }
-
-    RETVAL_ARR(Z_ARR(c));
+    tensor_buffer_broadcast(return_value, a, b, 0, tensor_less_kernel, tensor_less_scalar_kernel, tensor_less_kernel32, tensor_less_scalar_kernel32);
 }
 
 void tensor_less_equal(zval * return_value, zval * a, zval * b)
 {
-    unsigned int i;
-	zval c;
-
-    zend_array * aa = Z_ARR_P(a);
-    zend_array * ab = Z_ARR_P(b);
-
-    unsigned int n = zend_array_count(aa);
-
-	array_init_size(&c, n);
-
-    for (i = 0; i < n; ++i) {
-        if (zephir_get_doubleval(zend_hash_index_find(aa, i)) <= zephir_get_doubleval(zend_hash_index_find(ab, i))) {
-            add_next_index_long(&c, 1);
-        } else {
-            add_next_index_long(&c, 0);
-        }
-    }
-
-    RETVAL_ARR(Z_ARR(c));
+    tensor_buffer_broadcast(return_value, a, b, 0, tensor_less_equal_kernel, tensor_less_equal_scalar_kernel, tensor_less_equal_kernel32, tensor_less_equal_scalar_kernel32);
 }
 
-void tensor_equal_scalar(zval * return_value, zval * a, zval * b)
+void tensor_equal_column(zval * return_value, zval * a, zval * b)
 {
-	unsigned int i;
-	zval c;
+    tensor_buffer_broadcast(return_value, a, b, 1, tensor_equal_kernel, tensor_equal_scalar_kernel, tensor_equal_kernel32, tensor_equal_scalar_kernel32);
+}
 
-    zend_array * aa = Z_ARR_P(a);
+void tensor_not_equal_column(zval * return_value, zval * a, zval * b)
+{
+    tensor_buffer_broadcast(return_value, a, b, 1, tensor_not_equal_kernel, tensor_not_equal_scalar_kernel, tensor_not_equal_kernel32, tensor_not_equal_scalar_kernel32);
+}
 
-    double ab = zephir_get_doubleval(b);
+void tensor_greater_column(zval * return_value, zval * a, zval * b)
+{
+    tensor_buffer_broadcast(return_value, a, b, 1, tensor_greater_kernel, tensor_greater_scalar_kernel, tensor_greater_kernel32, tensor_greater_scalar_kernel32);
+}
 
-    unsigned int n = zend_array_count(aa);
+void tensor_greater_equal_column(zval * return_value, zval * a, zval * b)
+{
+    tensor_buffer_broadcast(return_value, a, b, 1, tensor_greater_equal_kernel, tensor_greater_equal_scalar_kernel, tensor_greater_equal_kernel32, tensor_greater_equal_scalar_kernel32);
+}
 
-	array_init_size(&c, n);
+void tensor_less_column(zval * return_value, zval * a, zval * b)
+{
+    tensor_buffer_broadcast(return_value, a, b, 1, tensor_less_kernel, tensor_less_scalar_kernel, tensor_less_kernel32, tensor_less_scalar_kernel32);
+}
 
-    for (i = 0; i < n; ++i) {
-        if (zephir_get_doubleval(zend_hash_index_find(aa, i)) == ab) {
-            add_next_index_long(&c, 1);
-        } else {
-            add_next_index_long(&c, 0);
-        }
-    }
+void tensor_less_equal_column(zval * return_value, zval * a, zval * b)
+{
+    tensor_buffer_broadcast(return_value, a, b, 1, tensor_less_equal_kernel, tensor_less_equal_scalar_kernel, tensor_less_equal_kernel32, tensor_less_equal_scalar_kernel32);
+}
 
-    RETVAL_ARR(Z_ARR(c));
+void tensor_equal_scalar(zval * return_value, zval * a, zval * b)
+{
+    tensor_buffer_apply_scalar(return_value, a, b, tensor_equal_scalar_kernel, tensor_equal_scalar_kernel32);
 }
 
 void tensor_not_equal_scalar(zval * return_value, zval * a, zval * b)
 {
-	unsigned int i;
-	zval c;
-
-    zend_array * aa = Z_ARR_P(a);
-
-    double ab = zephir_get_doubleval(b);
-
-    unsigned int n = zend_array_count(aa);
-
-	array_init_size(&c, n);
-
-    for (i = 0; i < n; ++i) {
-        if (zephir_get_doubleval(zend_hash_index_find(aa, i)) != ab) {
-            add_next_index_long(&c, 1);
-        } else {
-            add_next_index_long(&c, 0);
-        }
-    }
-
-    RETVAL_ARR(Z_ARR(c));
+    tensor_buffer_apply_scalar(return_value, a, b, tensor_not_equal_scalar_kernel, tensor_not_equal_scalar_kernel32);
 }
 
 void tensor_greater_scalar(zval * return_value, zval * a, zval * b)
 {
-	unsigned int i;
-	zval c;
-
-    zend_array * aa = Z_ARR_P(a);
-
-    double ab = zephir_get_doubleval(b);
-
-    unsigned int n = zend_array_count(aa);
-
-	array_init_size(&c, n);
-
-    for (i = 0; i < n; ++i) {
-        if (zephir_get_doubleval(zend_hash_index_find(aa, i)) > ab) {
-            add_next_index_long(&c, 1);
-        } else {
-            add_next_index_long(&c, 0);
-        }
-    }
-
-    RETVAL_ARR(Z_ARR(c));
+    tensor_buffer_apply_scalar(return_value, a, b, tensor_greater_scalar_kernel, tensor_greater_scalar_kernel32);
 }
 
 void tensor_greater_equal_scalar(zval * return_value, zval * a, zval * b)
 {
-	unsigned int i;
-	zval c;
-
-    zend_array * aa = Z_ARR_P(a);
-
-    double ab = zephir_get_doubleval(b);
-
-    unsigned int n = zend_array_count(aa);
-
-	array_init_size(&c, n);
-
-    for (i = 0; i < n; ++i) {
-        if (zephir_get_doubleval(zend_hash_index_find(aa, i)) >= ab) {
-            add_next_index_long(&c, 1);
-        } else {
-            add_next_index_long(&c, 0);
-        }
-    }
-
-    RETVAL_ARR(Z_ARR(c));
+    tensor_buffer_apply_scalar(return_value, a, b, tensor_greater_equal_scalar_kernel, tensor_greater_equal_scalar_kernel32);
 }
 
 void tensor_less_scalar(zval * return_value, zval * a, zval * b)
 {
-	unsigned int i;
-	zval c;
-
-    zend_array * aa = Z_ARR_P(a);
-
-    double ab = zephir_get_doubleval(b);
-
-    unsigned int n = zend_array_count(aa);
-
-	array_init_size(&c, n);
-
-    for (i = 0; i < n; ++i) {
-        if (zephir_get_doubleval(zend_hash_index_find(aa, i)) < ab) {
-            add_next_index_long(&c, 1);
-        } else {
-            add_next_index_long(&c, 0);
-        }
-    }
-
-    RETVAL_ARR(Z_ARR(c));
+    tensor_buffer_apply_scalar(return_value, a, b, tensor_less_scalar_kernel, tensor_less_scalar_kernel32);
 }
 
 void tensor_less_equal_scalar(zval * return_value, zval * a, zval * b)
 {
-	unsigned int i;
-	zval c;
-
-    zend_array * aa = Z_ARR_P(a);
-
-    Bucket * ba = aa->arData;
-
-    double ab = zephir_get_doubleval(b);
-
-    unsigned int n = zend_array_count(aa);
-
-	array_init_size(&c, n);
-
-    for (i = 0; i < n; ++i) {
-        if (zephir_get_doubleval(zend_hash_index_find(aa, i)) <= ab) {
-            add_next_index_long(&c, 1);
-        } else {
-            add_next_index_long(&c, 0);
-        }
-    }
-
-    RETVAL_ARR(Z_ARR(c));
+    tensor_buffer_apply_scalar(return_value, a, b, tensor_less_equal_scalar_kernel, tensor_less_equal_scalar_kernel32);
 }
@@ -10,6 +10,13 @@ void tensor_greater_equal(zval * return_value, zval * a, zval * b);
 void tensor_less(zval * return_value, zval * a, zval * b);
 void tensor_less_equal(zval * return_value, zval * a, zval * b);
 
+void tensor_equal_column(zval * return_value, zval * a, zval * b);
+void tensor_not_equal_column(zval * return_value, zval * a, zval * b);
+void tensor_greater_column(zval * return_value, zval * a, zval * b);
+void tensor_greater_equal_column(zval * return_value, zval * a, zval * b);
+void tensor_less_column(zval * return_value, zval * a, zval * b);
+void tensor_less_equal_column(zval * return_value, zval * a, zval * b);
+
 void tensor_equal_scalar(zval * return_value, zval * a, zval * b);
 void tensor_not_equal_scalar(zval * return_value, zval * a, zval * b);
 void tensor_greater_scalar(zval * return_value, zval * a, zval * b);
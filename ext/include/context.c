@@ -0,0 +1,117 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <php.h>
+#include <cblas.h>
+#include "kernel/operators.h"
+#include "context.h"
+#include "functions.h"
+#include "parallel.h"
+
+/**
+ * The allocator that new buffers are allocated with. Request memory counts towards the memory
+ * limit and is released at the end of the request at the latest, whereas system memory is
+ * handed back to the operating system as soon as a buffer is freed.
+ */
+TENSOR_TLS zend_long tensor_allocator = TENSOR_ALLOCATOR_REQUEST;
+
+/**
+ * Set the thread budget of the current thread. OpenBLAS only has a process wide thread count, so
+ * under ZTS it stays single threaded and concurrent requests never oversubscribe the CPU.
+ *
+ * @param threads
+ */
+void tensor_context_set_threads(zend_long threads)
+{
+    tensor_parallel_resize(threads);
+
+#ifndef ZTS
+    openblas_set_num_threads(tensor_num_threads);
+#endif
+}
+
+/**
+ * The number of contexts entered on the current thread that have not been exited yet, and the
+ * settings that were in place before the outermost of them was entered.
+ */
+static TENSOR_TLS zend_long tensor_context_depth = 0;
+static TENSOR_TLS zend_long tensor_context_threads = 1;
+static TENSOR_TLS zend_bool tensor_context_fast_math = 0;
+static TENSOR_TLS zend_long tensor_context_allocator = TENSOR_ALLOCATOR_REQUEST;
+
+/**
+ * Unwind any contexts left entered at the end of a request so that their settings never leak into
+ * the next request served by the same process or thread. Settings made outside of a context, such
+ * as a thread count chosen once at bootstrap, are kept.
+ */
+void tensor_context_reset()
+{
+    if (tensor_context_depth == 0) {
+        return;
+    }
+
+    tensor_context_depth = 0;
+
+    if (tensor_num_threads != tensor_context_threads) {
+        tensor_context_set_threads(tensor_context_threads);
+    }
+
+    tensor_fast_math = tensor_context_fast_math;
+    tensor_allocator = tensor_context_allocator;
+}
+
+/**
+ * Apply the thread budget, precision mode, and allocator of a context to the current thread and
+ * return the settings that they replaced in a tuple.
+ *
+ * @param return_value
+ * @param threads
+ * @param fastMath
+ * @param allocator
+ */
+void tensor_context_enter(zval * return_value, zval * threads, zval * fastMath, zval * allocator)
+{
+    zval previous;
+
+    array_init_size(&previous, 3);
+
+    add_next_index_long(&previous, tensor_num_threads);
+    add_next_index_bool(&previous, tensor_fast_math);
+    add_next_index_long(&previous, tensor_allocator);
+
+    if (tensor_context_depth++ == 0) {
+        tensor_context_threads = tensor_num_threads;
+        tensor_context_fast_math = tensor_fast_math;
+        tensor_context_allocator = tensor_allocator;
+    }
+
+    tensor_context_set_threads(zephir_get_intval(threads));
+
+    tensor_fast_math = zephir_is_true(fastMath);
+    tensor_allocator = zephir_get_intval(allocator);
+
+    RETVAL_ARR(Z_ARR(previous));
+}
+
+/**
+ * Restore the settings returned when a context was entered.
+ *
+ * @param return_value
+ * @param previous
+ */
+void tensor_context_exit(zval * return_value, zval * previous)
+{
+    zend_array * settings = Z_ARR_P(previous);
+
+    if (tensor_context_depth > 0) {
+        --tensor_context_depth;
+    }
+
+    tensor_context_set_threads(zephir_get_intval(zend_hash_index_find(settings, 0)));
+
+    tensor_fast_math = zephir_is_true(zend_hash_index_find(settings, 1));
+    tensor_allocator = zephir_get_intval(zend_hash_index_find(settings, 2));
+
+    RETURN_TRUE;
+}
@@ -0,0 +1,25 @@
+#ifndef TENSOR_CONTEXT_H
+#define TENSOR_CONTEXT_H
+
+#include <Zend/zend.h>
+
+#ifdef ZTS
+#define TENSOR_TLS TSRM_TLS
+#else
+#define TENSOR_TLS
+#endif
+
+enum tensor_allocator {
+    TENSOR_ALLOCATOR_REQUEST,
+    TENSOR_ALLOCATOR_SYSTEM
+};
+
+extern TENSOR_TLS zend_long tensor_allocator;
+
+void tensor_context_set_threads(zend_long threads);
+void tensor_context_reset();
+
+void tensor_context_enter(zval * return_value, zval * threads, zval * fastMath, zval * allocator);
+void tensor_context_exit(zval * return_value, zval * previous);
+
+#endif
@@ -0,0 +1,262 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <php.h>
+#include <math.h>
+#include <cblas.h>
+#include "kernel/operators.h"
+#include "buffer.h"
+#include "distances.h"
+#include "parallel.h"
+
+typedef struct _tensor_distance_job {
+    const double * a;
+    const double * b;
+    double * c;
+    double * na;
+    const double * nb;
+    zend_long k;
+    zend_long n;
+} tensor_distance_job;
+
+/**
+ * Compute the squared L2 norm of rows start through end of array A.
+ *
+ * @param context
+ * @param start
+ * @param end
+ */
+static void tensor_row_norms_task(void * context, size_t start, size_t end)
+{
+    size_t i;
+    zend_long j;
+
+    tensor_distance_job * job = context;
+
+    zend_long n = job->n;
+
+    for (i = start; i < end; ++i) {
+        const double * row = job->a + i * n;
+
+        double sigma = 0.0;
+
+        for (j = 0; j < n; ++j) {
+            sigma += row[j] * row[j];
+        }
+
+        job->na[i] = sigma;
+    }
+}
+
+/**
+ * Compute the squared L2 norm of each of the m rows of the n-column array A on the thread pool.
+ *
+ * @param a
+ * @param norms
+ * @param m
+ * @param n
+ */
+static void tensor_row_norms_squared(const double * a, double * norms, zend_long m, zend_long n)
+{
+    tensor_distance_job job = { .a = a, .na = norms, .n = n };
+
+    tensor_parallel_for(m, MAX(1, tensor_grain_size / MAX(n, 1)), tensor_row_norms_task, &job);
+}
+
+/**
+ * Turn the inner products in rows start through end of C into Euclidean distances.
+ *
+ * @param context
+ * @param start
+ * @param end
+ */
+static void tensor_euclidean_task(void * context, size_t start, size_t end)
+{
+    size_t i;
+    zend_long j;
+
+    tensor_distance_job * job = context;
+
+    zend_long k = job->k;
+
+    for (i = start; i < end; ++i) {
+        double * row = job->c + i * k;
+
+        double sa = job->na[i];
+
+        for (j = 0; j < k; ++j) {
+            double d2 = sa + job->nb[j] - 2.0 * row[j];
+
+            row[j] = sqrt(d2 > 0.0 ? d2 : 0.0);
+        }
+    }
+}
+
+/**
+ * Turn the inner products in rows start through end of C into cosine distances given the inverse
+ * norms of the rows of B.
+ *
+ * @param context
+ * @param start
+ * @param end
+ */
+static void tensor_cosine_task(void * context, size_t start, size_t end)
+{
+    size_t i;
+    zend_long j;
+
+    tensor_distance_job * job = context;
+
+    zend_long k = job->k;
+
+    for (i = start; i < end; ++i) {
+        double * row = job->c + i * k;
+
+        double sa = job->na[i] > 0.0 ? 1.0 / sqrt(job->na[i]) : 1.0;
+
+        for (j = 0; j < k; ++j) {
+            double d = 1.0 - row[j] * sa * job->nb[j];
+
+            row[j] = d < 0.0 ? 0.0 : (d > 2.0 ? 2.0 : d);
+        }
+    }
+}
+
+/**
+ * Fill the m x k matrix C with the pairwise Euclidean or cosine distances between the rows of A and B.
+ * The inner products of every pair of rows are computed with a single GEMM and then combined with the
+ * squared row norms i.e. ||a - b||^2 = ||a||^2 + ||b||^2 - 2ab and cos(a, b) = ab / (||a|| ||b||).
+ * The norms and the combining pass are split across the thread pool by rows.
+ *
+ * @param ba
+ * @param bb
+ * @param bc
+ * @param metric
+ */
+static void tensor_distances_gemm(const tensor_buffer * ba, const tensor_buffer * bb, tensor_buffer * bc, zend_long metric)
+{
+    zend_long i;
+
+    zend_long m = ba->m;
+    zend_long k = bb->m;
+    zend_long n = ba->n;
+
+    double * na = safe_emalloc(m, sizeof(double), 0);
+    double * nb = safe_emalloc(k, sizeof(double), 0);
+
+    tensor_row_norms_squared(ba->data, na, m, n);
+    tensor_row_norms_squared(bb->data, nb, k, n);
+
+    if (n > 0) {
+        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasTrans, m, k, n, 1.0, ba->data, n, bb->data, n, 0.0, bc->data, k);
+    } else {
+        memset(bc->data, 0, m * k * sizeof(double));
+    }
+
+    tensor_distance_job job = { .c = bc->data, .na = na, .nb = nb, .k = k };
+
+    if (metric == TENSOR_DISTANCE_EUCLIDEAN) {
+        tensor_parallel_for(m, MAX(1, tensor_grain_size / k), tensor_euclidean_task, &job);
+    } else {
+        for (i = 0; i < k; ++i) {
+            nb[i] = nb[i] > 0.0 ? 1.0 / sqrt(nb[i]) : 1.0;
+        }
+
+        tensor_parallel_for(m, MAX(1, tensor_grain_size / k), tensor_cosine_task, &job);
+    }
+
+    efree(na);
+    efree(nb);
+}
+
+/**
+ * Fill rows start through end of C with the Manhattan distances to every row of B. Rows are visited
+ * in tiles so that a block of B is reused from cache by every row in a block of A, and the inner
+ * loop over the features is a contiguous reduction that the compiler vectorizes.
+ *
+ * @param context
+ * @param start
+ * @param end
+ */
+static void tensor_manhattan_task(void * context, size_t start, size_t end)
+{
+    zend_long i, j, l, ii, jj, iMax, jMax;
+
+    tensor_distance_job * job = context;
+
+    zend_long k = job->k;
+    zend_long n = job->n;
+    zend_long last = end;
+
+    for (ii = start; ii < last; ii += TENSOR_DISTANCE_BLOCK_M) {
+        iMax = MIN(ii + TENSOR_DISTANCE_BLOCK_M, last);
+
+        for (jj = 0; jj < k; jj += TENSOR_DISTANCE_BLOCK_K) {
+            jMax = MIN(jj + TENSOR_DISTANCE_BLOCK_K, k);
+
+            for (i = ii; i < iMax; ++i) {
+                const double * rowA = job->a + i * n;
+
+                for (j = jj; j < jMax; ++j) {
+                    const double * rowB = job->b + j * n;
+
+                    double sigma = 0.0;
+
+                    for (l = 0; l < n; ++l) {
+                        sigma += fabs(rowA[l] - rowB[l]);
+                    }
+
+                    job->c[i * k + j] = sigma;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Fill the m x k matrix C with the pairwise Manhattan distances between the rows of A and B with
+ * blocks of rows of A split across the thread pool.
+ *
+ * @param ba
+ * @param bb
+ * @param bc
+ */
+static void tensor_distances_manhattan(const tensor_buffer * ba, const tensor_buffer * bb, tensor_buffer * bc)
+{
+    zend_long k = bb->m;
+    zend_long n = ba->n;
+
+    tensor_distance_job job = { .a = ba->data, .b = bb->data, .c = bc->data, .k = k, .n = n };
+
+    tensor_parallel_for(ba->m, MAX(1, tensor_grain_size / MAX(k * n, 1)), tensor_manhattan_task, &job);
+}
+
+/**
+ * Return the m x k matrix of distances between every row of the m x n matrix A and every row of the
+ * k x n matrix B under the given metric.
+ *
+ * @param return_value
+ * @param a
+ * @param b
+ * @param metric
+ */
+void tensor_pairwise_distances(zval * return_value, zval * a, zval * b, zval * metric)
+{
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+    tensor_buffer * bb = Z_TENSOR_BUFFER_P(b);
+
+    zend_long mode = zephir_get_intval(metric);
+
+    tensor_buffer * bc = tensor_buffer_alloc(return_value, ba->m, bb->m);
+
+    if (ba->m == 0 || bb->m == 0) {
+        return;
+    }
+
+    if (mode == TENSOR_DISTANCE_MANHATTAN) {
+        tensor_distances_manhattan(ba, bb, bc);
+    } else {
+        tensor_distances_gemm(ba, bb, bc, mode);
+    }
+}
@@ -0,0 +1,17 @@
+#ifndef TENSOR_DISTANCES_H
+#define TENSOR_DISTANCES_H
+
+#include <Zend/zend.h>
+
+#define TENSOR_DISTANCE_BLOCK_M 16
+#define TENSOR_DISTANCE_BLOCK_K 64
+
+enum tensor_distance_metric {
+    TENSOR_DISTANCE_EUCLIDEAN,
+    TENSOR_DISTANCE_COSINE,
+    TENSOR_DISTANCE_MANHATTAN
+};
+
+void tensor_pairwise_distances(zval * return_value, zval * a, zval * b, zval * metric);
+
+#endif
@@ -0,0 +1,397 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <php.h>
+#include <math.h>
+#include "kernel/operators.h"
+#include "arithmetic.h"
+#include "buffer.h"
+#include "expression.h"
+#include "functions.h"
+#include "parallel.h"
+#include "reductions.h"
+#include "simd.h"
+
+typedef struct _tensor_instruction {
+    zend_long op;
+    zend_long kind;
+    const double * data;
+    zend_long stride;
+    double scalar;
+} tensor_instruction;
+
+typedef struct _tensor_expression_job {
+    const tensor_instruction * instructions;
+    size_t count;
+    const double * a;
+    double * c;
+    zend_long n;
+    zend_bool fast_math;
+} tensor_expression_job;
+
+/**
+ * Decode a program of [op, operand kind, operand] tuples into a flat list of instructions.
+ *
+ * @param program
+ * @param count
+ * @return tensor_instruction
+ */
+static tensor_instruction * tensor_expression_decode(zval * program, size_t * count)
+{
+    size_t k = 0;
+    zval * tuple;
+    zval * operand;
+
+    zend_array * ap = Z_ARR_P(program);
+
+    tensor_instruction * instructions = safe_emalloc(MAX(zend_array_count(ap), 1), sizeof(tensor_instruction), 0);
+
+    ZEND_HASH_FOREACH_VAL(ap, tuple) {
+        tensor_instruction * ins = &instructions[k];
+
+        zend_array * at = Z_ARR_P(tuple);
+
+        ins->op = zephir_get_intval(zend_hash_index_find(at, 0));
+        ins->kind = zephir_get_intval(zend_hash_index_find(at, 1));
+        ins->data = NULL;
+        ins->stride = 0;
+        ins->scalar = 0.0;
+
+        operand = zend_hash_index_find(at, 2);
+
+        if (Z_TYPE_P(operand) == IS_OBJECT) {
+            tensor_buffer * bb = Z_TENSOR_BUFFER_P(operand);
+
+            ins->data = bb->data;
+            ins->stride = bb->n;
+
+            if (ins->op == TENSOR_OP_MOD) {
+                tensor_check_modulus(bb->data, bb->m * bb->n);
+            }
+        } else {
+            ins->scalar = zephir_get_doubleval(operand);
+
+            if (ins->op == TENSOR_OP_MOD) {
+                tensor_check_modulus(&ins->scalar, 1);
+            }
+        }
+
+        ++k;
+    } ZEND_HASH_FOREACH_END();
+
+    *count = k;
+
+    return instructions;
+}
+
+/**
+ * Apply a single element-wise operation to a tile in place. The second operand is either the
+ * array b or, if b is null, the scalar s. Transcendental functions read from a scratch copy of
+ * the tile so that the fast kernels can recompute out of range elements with libm. The precision
+ * mode is passed in since tiles may be run on pool threads.
+ *
+ * @param op
+ * @param t
+ * @param b
+ * @param s
+ * @param n
+ * @param fast_math
+ */
+static void tensor_expression_apply(zend_long op, double * t, const double * b, double s, size_t n, zend_bool fast_math)
+{
+    size_t k;
+    double u[TENSOR_EXPRESSION_TILE];
+
+#define TENSOR_FUSED_BINARY(expr) \
+    if (b) { \
+        for (k = 0; k < n; ++k) { \
+            double x = t[k], y = b[k]; \
+            t[k] = (expr); \
+        } \
+    } else { \
+        for (k = 0; k < n; ++k) { \
+            double x = t[k], y = s; \
+            t[k] = (expr); \
+        } \
+    } \
+    break;
+
+#define TENSOR_FUSED_UNARY(expr) \
+    for (k = 0; k < n; ++k) { \
+        double x = t[k]; \
+        t[k] = (expr); \
+    } \
+    break;
+
+#define TENSOR_FUSED_TRANSCENDENTAL(fn) \
+    if (fast_math) { \
+        memcpy(u, t, n * sizeof(double)); \
+        tensor_simd.fn(u, t, n); \
+    } else { \
+        for (k = 0; k < n; ++k) { \
+            t[k] = fn(t[k]); \
+        } \
+    } \
+    break;
+
+    switch (op) {
+        case TENSOR_OP_MULTIPLY:
+            if (b) {
+                tensor_simd.multiply(t, b, t, n);
+            } else {
+                tensor_simd.multiply_scalar(t, s, t, n);
+            }
+
+            break;
+
+        case TENSOR_OP_DIVIDE:
+            if (b) {
+                tensor_simd.divide(t, b, t, n);
+            } else {
+                tensor_simd.divide_scalar(t, s, t, n);
+            }
+
+            break;
+
+        case TENSOR_OP_ADD:
+            if (b) {
+                tensor_simd.add(t, b, t, n);
+            } else {
+                tensor_simd.add_scalar(t, s, t, n);
+            }
+
+            break;
+
+        case TENSOR_OP_SUBTRACT:
+            if (b) {
+                tensor_simd.subtract(t, b, t, n);
+            } else {
+                tensor_simd.subtract_scalar(t, s, t, n);
+            }
+
+            break;
+
+        case TENSOR_OP_POW: TENSOR_FUSED_BINARY(pow(x, y))
+        case TENSOR_OP_MOD: TENSOR_FUSED_BINARY(tensor_modulus(x, y))
+        case TENSOR_OP_EQUAL: TENSOR_FUSED_BINARY(x == y ? 1.0 : 0.0)
+        case TENSOR_OP_NOT_EQUAL: TENSOR_FUSED_BINARY(x != y ? 1.0 : 0.0)
+        case TENSOR_OP_GREATER: TENSOR_FUSED_BINARY(x > y ? 1.0 : 0.0)
+        case TENSOR_OP_GREATER_EQUAL: TENSOR_FUSED_BINARY(x >= y ? 1.0 : 0.0)
+        case TENSOR_OP_LESS: TENSOR_FUSED_BINARY(x < y ? 1.0 : 0.0)
+        case TENSOR_OP_LESS_EQUAL: TENSOR_FUSED_BINARY(x <= y ? 1.0 : 0.0)
+        case TENSOR_OP_ABS: TENSOR_FUSED_UNARY(fabs(x))
+        case TENSOR_OP_SQUARE: TENSOR_FUSED_UNARY(x * x)
+        case TENSOR_OP_SQRT:
+            tensor_simd.sqrt(t, t, n);
+
+            break;
+
+        case TENSOR_OP_EXP: TENSOR_FUSED_TRANSCENDENTAL(exp)
+        case TENSOR_OP_EXPM1: TENSOR_FUSED_UNARY(expm1(x))
+        case TENSOR_OP_LOG:
+            if (fast_math) {
+                memcpy(u, t, n * sizeof(double));
+
+                tensor_simd.log(u, t, n);
+            } else {
+                for (k = 0; k < n; ++k) {
+                    t[k] = log(t[k]);
+                }
+            }
+
+            if (s != M_E) {
+                tensor_simd.divide_scalar(t, log(s), t, n);
+            }
+
+            break;
+
+        case TENSOR_OP_LOG1P: TENSOR_FUSED_UNARY(log1p(x))
+        case TENSOR_OP_SIN: TENSOR_FUSED_TRANSCENDENTAL(sin)
+        case TENSOR_OP_ASIN: TENSOR_FUSED_UNARY(asin(x))
+        case TENSOR_OP_COS: TENSOR_FUSED_TRANSCENDENTAL(cos)
+        case TENSOR_OP_ACOS: TENSOR_FUSED_UNARY(acos(x))
+        case TENSOR_OP_TAN: TENSOR_FUSED_TRANSCENDENTAL(tan)
+        case TENSOR_OP_ATAN: TENSOR_FUSED_UNARY(atan(x))
+        case TENSOR_OP_RAD2DEG: TENSOR_FUSED_UNARY((x / M_PI) * 180.0)
+        case TENSOR_OP_DEG2RAD: TENSOR_FUSED_UNARY((x / 180.0) * M_PI)
+        case TENSOR_OP_NEGATE: TENSOR_FUSED_UNARY(-x)
+        case TENSOR_OP_RECIPROCAL: TENSOR_FUSED_UNARY(1.0 / x)
+        case TENSOR_OP_SIGN: TENSOR_FUSED_UNARY(x > 0.0 ? 1.0 : (x < 0.0 ? -1.0 : 0.0))
+        case TENSOR_OP_FLOOR: TENSOR_FUSED_UNARY(floor(x))
+        case TENSOR_OP_CEIL: TENSOR_FUSED_UNARY(ceil(x))
+        case TENSOR_OP_CLIP_LOWER: TENSOR_FUSED_UNARY(x < s ? s : x)
+        case TENSOR_OP_CLIP_UPPER: TENSOR_FUSED_UNARY(x > s ? s : x)
+    }
+
+#undef TENSOR_FUSED_BINARY
+#undef TENSOR_FUSED_UNARY
+#undef TENSOR_FUSED_TRANSCENDENTAL
+}
+
+/**
+ * Run every instruction of the program over a tile that starts at row i and column j.
+ *
+ * @param instructions
+ * @param count
+ * @param t
+ * @param i
+ * @param j
+ * @param n
+ * @param fast_math
+ */
+static void tensor_expression_run(const tensor_instruction * instructions, size_t count, double * t, zend_long i, zend_long j, size_t n, zend_bool fast_math)
+{
+    size_t k;
+
+    for (k = 0; k < count; ++k) {
+        const tensor_instruction * ins = &instructions[k];
+
+        switch (ins->kind) {
+            case TENSOR_OPERAND_MATRIX:
+                tensor_expression_apply(ins->op, t, ins->data + i * ins->stride + j, 0.0, n, fast_math);
+                break;
+
+            case TENSOR_OPERAND_ROW:
+                tensor_expression_apply(ins->op, t, ins->data + j, 0.0, n, fast_math);
+                break;
+
+            case TENSOR_OPERAND_COLUMN:
+                tensor_expression_apply(ins->op, t, NULL, ins->data[i], n, fast_math);
+                break;
+
+            default:
+                tensor_expression_apply(ins->op, t, NULL, ins->scalar, n, fast_math);
+        }
+    }
+}
+
+/**
+ * Evaluate the program over rows start through end of the job, one tile at a time.
+ *
+ * @param context
+ * @param start
+ * @param end
+ */
+static void tensor_evaluate_task(void * context, size_t start, size_t end)
+{
+    size_t i, j, len;
+
+    tensor_expression_job * job = context;
+
+    size_t n = job->n;
+
+    for (i = start; i < end; ++i) {
+        for (j = 0; j < n; j += TENSOR_EXPRESSION_TILE) {
+            len = MIN(TENSOR_EXPRESSION_TILE, n - j);
+
+            double * t = job->c + i * n + j;
+
+            memcpy(t, job->a + i * n + j, len * sizeof(double));
+
+            tensor_expression_run(job->instructions, job->count, t, i, j, len, job->fast_math);
+        }
+    }
+}
+
+/**
+ * Evaluate the program over rows start through end of the job and sum each row. Tiles are summed
+ * pairwise and so are the partial sums of the tiles. Runs on pool threads so the partial sums are
+ * allocated with malloc rather than the request allocator.
+ *
+ * @param context
+ * @param start
+ * @param end
+ */
+static void tensor_evaluate_sum_task(void * context, size_t start, size_t end)
+{
+    size_t i, j, k, len;
+    double t[TENSOR_EXPRESSION_TILE];
+
+    tensor_expression_job * job = context;
+
+    size_t n = job->n;
+
+    double * partials = malloc(MAX((n + TENSOR_EXPRESSION_TILE - 1) / TENSOR_EXPRESSION_TILE, 1) * sizeof(double));
+
+    for (i = start; i < end; ++i) {
+        k = 0;
+
+        for (j = 0; j < n; j += TENSOR_EXPRESSION_TILE) {
+            len = MIN(TENSOR_EXPRESSION_TILE, n - j);
+
+            memcpy(t, job->a + i * n + j, len * sizeof(double));
+
+            tensor_expression_run(job->instructions, job->count, t, i, j, len, job->fast_math);
+
+            partials[k++] = tensor_pairwise_sum(t, len);
+        }
+
+        job->c[i] = tensor_pairwise_sum(partials, k);
+    }
+
+    free(partials);
+}
+
+/**
+ * Evaluate a program of element-wise operations over matrix A in a single pass. Each row is
+ * processed in small tiles that stay in cache while every operation is applied to them, and
+ * bands of rows are split across the thread pool.
+ *
+ * @param return_value
+ * @param a
+ * @param program
+ */
+void tensor_evaluate(zval * return_value, zval * a, zval * program)
+{
+    size_t count;
+
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    zend_long m = ba->m;
+    zend_long n = ba->n;
+
+    tensor_instruction * instructions = tensor_expression_decode(program, &count);
+
+    tensor_buffer * bc = tensor_buffer_alloc(return_value, m, n);
+
+    tensor_expression_job job = {
+        .instructions = instructions, .count = count, .a = ba->data, .c = bc->data,
+        .n = n, .fast_math = tensor_fast_math,
+    };
+
+    tensor_parallel_for(m, MAX(1, tensor_grain_size / MAX(n, 1)), tensor_evaluate_task, &job);
+
+    efree(instructions);
+}
+
+/**
+ * Evaluate a program of element-wise operations over matrix A and return the sum of each row
+ * without materializing the intermediate matrix.
+ *
+ * @param return_value
+ * @param a
+ * @param program
+ */
+void tensor_evaluate_sum(zval * return_value, zval * a, zval * program)
+{
+    size_t count;
+
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    zend_long m = ba->m;
+    zend_long n = ba->n;
+
+    tensor_instruction * instructions = tensor_expression_decode(program, &count);
+
+    tensor_buffer * bc = tensor_buffer_alloc(return_value, m > 0 ? 1 : 0, m);
+
+    tensor_expression_job job = {
+        .instructions = instructions, .count = count, .a = ba->data, .c = bc->data,
+        .n = n, .fast_math = tensor_fast_math,
+    };
+
+    tensor_parallel_for(m, MAX(1, tensor_grain_size / MAX(n, 1)), tensor_evaluate_sum_task, &job);
+
+    efree(instructions);
+}
@@ -0,0 +1,55 @@
+#ifndef TENSOR_EXPRESSION_H
+#define TENSOR_EXPRESSION_H
+
+#include <Zend/zend.h>
+
+#define TENSOR_EXPRESSION_TILE 256
+
+enum tensor_expression_op {
+    TENSOR_OP_MULTIPLY,
+    TENSOR_OP_DIVIDE,
+    TENSOR_OP_ADD,
+    TENSOR_OP_SUBTRACT,
+    TENSOR_OP_POW,
+    TENSOR_OP_MOD,
+    TENSOR_OP_EQUAL,
+    TENSOR_OP_NOT_EQUAL,
+    TENSOR_OP_GREATER,
+    TENSOR_OP_GREATER_EQUAL,
+    TENSOR_OP_LESS,
+    TENSOR_OP_LESS_EQUAL,
+    TENSOR_OP_ABS,
+    TENSOR_OP_SQUARE,
+    TENSOR_OP_SQRT,
+    TENSOR_OP_EXP,
+    TENSOR_OP_EXPM1,
+    TENSOR_OP_LOG,
+    TENSOR_OP_LOG1P,
+    TENSOR_OP_SIN,
+    TENSOR_OP_ASIN,
+    TENSOR_OP_COS,
+    TENSOR_OP_ACOS,
+    TENSOR_OP_TAN,
+    TENSOR_OP_ATAN,
+    TENSOR_OP_RAD2DEG,
+    TENSOR_OP_DEG2RAD,
+    TENSOR_OP_NEGATE,
+    TENSOR_OP_RECIPROCAL,
+    TENSOR_OP_SIGN,
+    TENSOR_OP_FLOOR,
+    TENSOR_OP_CEIL,
+    TENSOR_OP_CLIP_LOWER,
+    TENSOR_OP_CLIP_UPPER
+};
+
+enum tensor_expression_operand {
+    TENSOR_OPERAND_SCALAR,
+    TENSOR_OPERAND_MATRIX,
+    TENSOR_OPERAND_ROW,
+    TENSOR_OPERAND_COLUMN
+};
+
+void tensor_evaluate(zval * return_value, zval * a, zval * program);
+void tensor_evaluate_sum(zval * return_value, zval * a, zval * program);
+
+#endif
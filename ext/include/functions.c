@@ -0,0 +1,97 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <php.h>
+#include <math.h>
+#include "kernel/operators.h"
+#include "buffer.h"
+#include "functions.h"
+#include "parallel.h"
+#include "simd.h"
+
+/**
+ * Use the fast vectorized approximations instead of libm. The approximations are within a few
+ * units in the last place of the correctly rounded result. Strict by default.
+ */
+TENSOR_TLS zend_bool tensor_fast_math = 0;
+
+/**
+ * Define a kernel that applies a libm function to an array of doubles.
+ */
+#define TENSOR_STRICT_UNARY(name, fn) \
+static void name(const double * a, double * b, size_t n) \
+{ \
+    size_t i; \
+    for (i = 0; i < n; ++i) { \
+        b[i] = fn(a[i]); \
+    } \
+}
+
+TENSOR_STRICT_UNARY(tensor_strict_exp, exp)
+TENSOR_STRICT_UNARY(tensor_strict_log, log)
+TENSOR_STRICT_UNARY(tensor_strict_sin, sin)
+TENSOR_STRICT_UNARY(tensor_strict_cos, cos)
+TENSOR_STRICT_UNARY(tensor_strict_tan, tan)
+
+/**
+ * Apply a unary kernel to every element of buffer A and return the result in a new buffer.
+ *
+ * @param return_value
+ * @param a
+ * @param op
+ * @return tensor_buffer
+ */
+static tensor_buffer * tensor_apply_unary(zval * return_value, zval * a, tensor_simd_unary op)
+{
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    tensor_buffer * bb = tensor_buffer_alloc(return_value, ba->m, ba->n);
+
+    tensor_parallel_unary(op, ba->data, bb->data, ba->m * ba->n);
+
+    return bb;
+}
+
+void tensor_exp(zval * return_value, zval * a)
+{
+    tensor_apply_unary(return_value, a, tensor_fast_math ? tensor_simd.exp : tensor_strict_exp);
+}
+
+/**
+ * Logarithm of each element of buffer A to the given base.
+ *
+ * @param return_value
+ * @param a
+ * @param base
+ */
+void tensor_log(zval * return_value, zval * a, zval * base)
+{
+    double b = zephir_get_doubleval(base);
+
+    tensor_buffer * bb = tensor_apply_unary(return_value, a, tensor_fast_math ? tensor_simd.log : tensor_strict_log);
+
+    if (b != M_E) {
+        tensor_simd.divide_scalar(bb->data, log(b), bb->data, bb->m * bb->n);
+    }
+}
+
+void tensor_sin(zval * return_value, zval * a)
+{
+    tensor_apply_unary(return_value, a, tensor_fast_math ? tensor_simd.sin : tensor_strict_sin);
+}
+
+void tensor_cos(zval * return_value, zval * a)
+{
+    tensor_apply_unary(return_value, a, tensor_fast_math ? tensor_simd.cos : tensor_strict_cos);
+}
+
+void tensor_tan(zval * return_value, zval * a)
+{
+    tensor_apply_unary(return_value, a, tensor_fast_math ? tensor_simd.tan : tensor_strict_tan);
+}
+
+void tensor_sqrt(zval * return_value, zval * a)
+{
+    tensor_apply_unary(return_value, a, tensor_simd.sqrt);
+}
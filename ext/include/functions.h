@@ -0,0 +1,16 @@
+#ifndef TENSOR_FUNCTIONS_H
+#define TENSOR_FUNCTIONS_H
+
+#include <Zend/zend.h>
+#include "context.h"
+
+extern TENSOR_TLS zend_bool tensor_fast_math;
+
+void tensor_exp(zval * return_value, zval * a);
+void tensor_log(zval * return_value, zval * a, zval * base);
+void tensor_sin(zval * return_value, zval * a);
+void tensor_cos(zval * return_value, zval * a);
+void tensor_tan(zval * return_value, zval * a);
+void tensor_sqrt(zval * return_value, zval * a);
+
+#endif
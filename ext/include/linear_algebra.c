@@ -3,69 +3,254 @@
 #endif
 
 #include <php.h>
+#include <math.h>
 #include <cblas.h>
 #include <lapacke.h>
 #include "kernel/operators.h"
+#include "buffer.h"
+#include "linear_algebra.h"
 
 /**
- * Matrix-matrix multiplication i.e. linear transformation of matrices A and B.
- * 
+ * General matrix-matrix multiplication i.e. C = alpha * op(A) * op(B) + beta * C where op() optionally
+ * transposes its operand. A transposed operand is read in place by BLAS so no copy is ever made. If C
+ * is null then the product is written into a new buffer, otherwise C is updated in place when nothing
+ * else holds a reference to it. An inner dimension of zero gives an empty sum so C is only scaled by
+ * beta, or zeroed if it is new.
+ *
  * @param return_value
  * @param a
  * @param b
+ * @param trans_a
+ * @param trans_b
+ * @param alpha
+ * @param beta
+ * @param c
  */
-void tensor_matmul(zval * return_value, zval * a, zval * b)
+void tensor_gemm(zval * return_value, zval * a, zval * b, zval * trans_a, zval * trans_b, zval * alpha, zval * beta, zval * c)
 {
-    unsigned int i, j;
-    zval * row;
-    zval rowC, c;
+    tensor_buffer * bc;
 
-    zend_array * aa = Z_ARR_P(a);
-    zend_array * ab = Z_ARR_P(b);
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+    tensor_buffer * bb = Z_TENSOR_BUFFER_P(b);
 
-    unsigned int m = zend_array_count(aa);
-    unsigned int p = zend_array_count(ab);
-    unsigned int n = zend_array_count(Z_ARR_P(zend_hash_index_find(ab, 0)));
+    zend_bool ta = zephir_is_true(trans_a);
+    zend_bool tb = zephir_is_true(trans_b);
 
-    double * va = emalloc(m * p * sizeof(double));
-    double * vb = emalloc(n * p * sizeof(double));
-    double * vc = emalloc(m * n * sizeof(double));
+    zend_long m = ta ? ba->n : ba->m;
+    zend_long p = ta ? ba->m : ba->n;
+    zend_long n = tb ? bb->m : bb->n;
 
-    for (i = 0; i < m; ++i) {
-        row = zend_hash_index_find(aa, i);
+    double scale = zephir_get_doubleval(beta);
 
-        for (j = 0; j < p; ++j) {
-            va[i * p + j] = zephir_get_doubleval(zend_hash_index_find(Z_ARR_P(row), j));
-        }
+    if (Z_TYPE_P(c) == IS_OBJECT) {
+        bc = tensor_buffer_separate(return_value, c);
+    } else {
+        bc = tensor_buffer_alloc_dtype(return_value, m, n, ba->dtype);
+
+        scale = 0.0;
     }
 
-    for (i = 0; i < p; ++i) {
-        row = zend_hash_index_find(ab, i);
+    if (m == 0 || n == 0) {
+        return;
+    }
 
-        for (j = 0; j < n; ++j) {
-            vb[i * n + j] = zephir_get_doubleval(zend_hash_index_find(Z_ARR_P(row), j));
+    if (p == 0) {
+        if (scale == 0.0) {
+            memset(bc->data, 0, m * n * tensor_dtype_size(bc->dtype));
+        } else if (bc->dtype == TENSOR_DTYPE_FLOAT32) {
+            cblas_sscal(m * n, (float) scale, bc->single, 1);
+        } else {
+            cblas_dscal(m * n, scale, bc->data, 1);
         }
+
+        return;
     }
 
-    cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, m, n, p, 1.0, va, p, vb, n, 0.0, vc, n);
+    if (ba->dtype == TENSOR_DTYPE_FLOAT32) {
+        cblas_sgemm(CblasRowMajor, ta ? CblasTrans : CblasNoTrans, tb ? CblasTrans : CblasNoTrans,
+            m, n, p, (float) zephir_get_doubleval(alpha), ba->single, ba->n, bb->single, bb->n, (float) scale, bc->single, n);
 
-    array_init_size(&c, m);
+        return;
+    }
 
-    for (i = 0; i < m; ++i) {
-        array_init_size(&rowC, n);
+    cblas_dgemm(CblasRowMajor, ta ? CblasTrans : CblasNoTrans, tb ? CblasTrans : CblasNoTrans,
+        m, n, p, zephir_get_doubleval(alpha), ba->data, ba->n, bb->data, bb->n, scale, bc->data, n);
+}
 
-        for (j = 0; j < n; ++j) {
-            add_next_index_double(&rowC, vc[i * n + j]);
+/**
+ * Symmetric rank-k update i.e. the Gram matrix alpha * A * A^T, or alpha * A^T * A if the transpose
+ * flag is set. BLAS only computes the upper triangle of the symmetric product which is then mirrored
+ * into the lower triangle.
+ *
+ * @param return_value
+ * @param a
+ * @param trans
+ * @param alpha
+ */
+void tensor_syrk(zval * return_value, zval * a, zval * trans, zval * alpha)
+{
+    zend_long i, j;
+
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    zend_bool ta = zephir_is_true(trans);
+
+    zend_long n = ta ? ba->n : ba->m;
+    zend_long k = ta ? ba->m : ba->n;
+
+    tensor_buffer * bc = tensor_buffer_alloc_dtype(return_value, n, n, ba->dtype);
+
+    if (n == 0) {
+        return;
+    }
+
+    if (k == 0) {
+        memset(bc->data, 0, n * n * tensor_dtype_size(bc->dtype));
+
+        return;
+    }
+
+    if (ba->dtype == TENSOR_DTYPE_FLOAT32) {
+        cblas_ssyrk(CblasRowMajor, CblasUpper, ta ? CblasTrans : CblasNoTrans, n, k,
+            (float) zephir_get_doubleval(alpha), ba->single, ba->n, 0.0f, bc->single, n);
+
+        for (i = 1; i < n; ++i) {
+            for (j = 0; j < i; ++j) {
+                bc->single[i * n + j] = bc->single[j * n + i];
+            }
         }
 
-        add_next_index_zval(&c, &rowC);
+        return;
     }
 
-    RETVAL_ARR(Z_ARR(c));
+    cblas_dsyrk(CblasRowMajor, CblasUpper, ta ? CblasTrans : CblasNoTrans, n, k,
+        zephir_get_doubleval(alpha), ba->data, ba->n, 0.0, bc->data, n);
 
-    efree(va);
-    efree(vb);
-    efree(vc);
+    for (i = 1; i < n; ++i) {
+        double * row = bc->data + i * n;
+
+        for (j = 0; j < i; ++j) {
+            row[j] = bc->data[j * n + i];
+        }
+    }
+}
+
+/**
+ * Define a blocked transpose of an m x n array of the given element type. The array is walked in
+ * square tiles that fit in the L1 cache so that both the strided reads and the contiguous writes
+ * of a tile hit cache lines that are already loaded.
+ */
+#define TENSOR_TRANSPOSE(name, type) \
+static void name(const type * src, type * dst, zend_long m, zend_long n) \
+{ \
+    zend_long i, j, ii, jj, iMax, jMax; \
+    for (ii = 0; ii < m; ii += TENSOR_TRANSPOSE_BLOCK) { \
+        iMax = MIN(ii + TENSOR_TRANSPOSE_BLOCK, m); \
+        for (jj = 0; jj < n; jj += TENSOR_TRANSPOSE_BLOCK) { \
+            jMax = MIN(jj + TENSOR_TRANSPOSE_BLOCK, n); \
+            for (j = jj; j < jMax; ++j) { \
+                type * row = dst + j * m; \
+                for (i = ii; i < iMax; ++i) { \
+                    row[i] = src[i * n + j]; \
+                } \
+            } \
+        } \
+    } \
+}
+
+TENSOR_TRANSPOSE(tensor_transpose_kernel, double)
+TENSOR_TRANSPOSE(tensor_transpose_kernel32, float)
+
+/**
+ * Transpose matrix A.
+ *
+ * @param return_value
+ * @param a
+ */
+void tensor_transpose(zval * return_value, zval * a)
+{
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    tensor_buffer * bb = tensor_buffer_alloc_dtype(return_value, ba->n, ba->m, ba->dtype);
+
+    if (ba->dtype == TENSOR_DTYPE_FLOAT32) {
+        tensor_transpose_kernel32(ba->single, bb->single, ba->m, ba->n);
+    } else {
+        tensor_transpose_kernel(ba->data, bb->data, ba->m, ba->n);
+    }
+}
+
+/**
+ * Matrix-vector product i.e. op(A) * x where op() optionally transposes A without copying it. The
+ * result is returned as a vector buffer so no intermediate matrix is built for either operand.
+ *
+ * @param return_value
+ * @param a
+ * @param x
+ * @param trans
+ */
+void tensor_gemv(zval * return_value, zval * a, zval * x, zval * trans)
+{
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+    tensor_buffer * bx = Z_TENSOR_BUFFER_P(x);
+
+    zend_bool ta = zephir_is_true(trans);
+
+    unsigned int n = ta ? ba->n : ba->m;
+
+    tensor_buffer * by = tensor_buffer_alloc_dtype(return_value, n > 0 ? 1 : 0, n, ba->dtype);
+
+    if (n == 0) {
+        return;
+    }
+
+    if (ba->m == 0 || ba->n == 0) {
+        memset(by->data, 0, n * tensor_dtype_size(ba->dtype));
+
+        return;
+    }
+
+    if (ba->dtype == TENSOR_DTYPE_FLOAT32) {
+        cblas_sgemv(CblasRowMajor, ta ? CblasTrans : CblasNoTrans, ba->m, ba->n, 1.0f,
+            ba->single, ba->n, bx->single, 1, 0.0f, by->single, 1);
+
+        return;
+    }
+
+    cblas_dgemv(CblasRowMajor, ta ? CblasTrans : CblasNoTrans, ba->m, ba->n, 1.0,
+        ba->data, ba->n, bx->data, 1, 0.0, by->data, 1);
+}
+
+/**
+ * Outer product of vectors X and Y i.e. the rank-1 matrix x * y^T.
+ *
+ * @param return_value
+ * @param x
+ * @param y
+ */
+void tensor_ger(zval * return_value, zval * x, zval * y)
+{
+    tensor_buffer * bx = Z_TENSOR_BUFFER_P(x);
+    tensor_buffer * by = Z_TENSOR_BUFFER_P(y);
+
+    unsigned int m = bx->m * bx->n;
+    unsigned int n = by->m * by->n;
+
+    tensor_buffer * bc = tensor_buffer_alloc_dtype(return_value, m, n, bx->dtype);
+
+    if (m == 0 || n == 0) {
+        return;
+    }
+
+    memset(bc->data, 0, m * n * tensor_dtype_size(bx->dtype));
+
+    if (bx->dtype == TENSOR_DTYPE_FLOAT32) {
+        cblas_sger(CblasRowMajor, m, n, 1.0f, bx->single, 1, by->single, 1, bc->single, n);
+
+        return;
+    }
+
+    cblas_dger(CblasRowMajor, m, n, 1.0, bx->data, 1, by->data, 1, bc->data, n);
 }
 
 /**
@@ -76,21 +261,117 @@ void tensor_matmul(zval * return_value, zval * a, zval * b)
  * @param b
  */
 void tensor_dot(zval * return_value, zval * a, zval * b)
+{
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+    tensor_buffer * bb = Z_TENSOR_BUFFER_P(b);
+
+    unsigned int n = ba->m * ba->n;
+
+    if (n == 0) {
+        RETURN_DOUBLE(0.0);
+    }
+
+    if (ba->dtype == TENSOR_DTYPE_FLOAT32) {
+        RETURN_DOUBLE(cblas_sdot(n, ba->single, 1, bb->single, 1));
+    }
+
+    RETVAL_DOUBLE(cblas_ddot(n, ba->data, 1, bb->data, 1));
+}
+
+/**
+ * Return the L1 or Manhattan norm of vector A.
+ *
+ * @param return_value
+ * @param a
+ */
+void tensor_l1_norm(zval * return_value, zval * a)
+{
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    unsigned int n = ba->m * ba->n;
+
+    if (n == 0) {
+        RETURN_DOUBLE(0.0);
+    }
+
+    RETVAL_DOUBLE(cblas_dasum(n, ba->data, 1));
+}
+
+/**
+ * Return the L2 or Euclidean norm of vector A. BLAS scales the running sum of squares so that
+ * the result does not overflow or underflow for very large or very small elements.
+ *
+ * @param return_value
+ * @param a
+ */
+void tensor_l2_norm(zval * return_value, zval * a)
+{
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    unsigned int n = ba->m * ba->n;
+
+    if (n == 0) {
+        RETURN_DOUBLE(0.0);
+    }
+
+    RETVAL_DOUBLE(cblas_dnrm2(n, ba->data, 1));
+}
+
+/**
+ * Return the p-norm of vector A in a single pass over the buffer.
+ *
+ * @param return_value
+ * @param a
+ * @param p
+ */
+void tensor_p_norm(zval * return_value, zval * a, zval * p)
 {
     unsigned int i;
 
-    zend_array * aa = Z_ARR_P(a);
-    zend_array * ab = Z_ARR_P(b);
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    unsigned int n = ba->m * ba->n;
 
-    unsigned int n = zend_array_count(aa);
+    double pp = zephir_get_doubleval(p);
 
     double sigma = 0.0;
 
+    if (n == 0) {
+        RETURN_DOUBLE(0.0);
+    }
+
+    if (pp == 1.0) {
+        RETURN_DOUBLE(cblas_dasum(n, ba->data, 1));
+    }
+
+    if (pp == 2.0) {
+        RETURN_DOUBLE(cblas_dnrm2(n, ba->data, 1));
+    }
+
     for (i = 0; i < n; ++i) {
-        sigma += zephir_get_doubleval(zend_hash_index_find(aa, i)) * zephir_get_doubleval(zend_hash_index_find(ab, i));
+        sigma += pow(fabs(ba->data[i]), pp);
     }
 
-    RETVAL_DOUBLE(sigma);
+    RETVAL_DOUBLE(pow(sigma, 1.0 / pp));
+}
+
+/**
+ * Return the max norm of vector A i.e. the largest absolute value.
+ *
+ * @param return_value
+ * @param a
+ */
+void tensor_max_norm(zval * return_value, zval * a)
+{
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    unsigned int n = ba->m * ba->n;
+
+    if (n == 0) {
+        RETURN_DOUBLE(0.0);
+    }
+
+    RETVAL_DOUBLE(fabs(ba->data[cblas_idamax(n, ba->data, 1)]));
 }
 
 /**
@@ -101,55 +382,35 @@ void tensor_dot(zval * return_value, zval * a, zval * b)
  */
 void tensor_inverse(zval * return_value, zval * a)
 {
-    unsigned int i, j;
-    zval * row;
-    zval rowB, b;
+    zval b;
 
-    zend_array * aa = Z_ARR_P(a);
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
 
-    unsigned int n = zend_array_count(aa);
+    unsigned int n = ba->m;
 
-    double * va = emalloc(n * n * sizeof(double));
-    int * pivots = emalloc(n * sizeof(int));
+    tensor_buffer * bb = tensor_buffer_alloc(&b, n, n);
 
-    for (i = 0; i < n; ++i) {
-        row = zend_hash_index_find(aa, i);
+    int * pivots = emalloc(n * sizeof(int));
 
-        for (j = 0; j < n; ++j) {
-            va[i * n + j] = zephir_get_doubleval(zend_hash_index_find(Z_ARR_P(row), j));
-        }
-    }
+    memcpy(bb->data, ba->data, n * n * sizeof(double));
     
     lapack_int status;
 
-    status = LAPACKE_dgetrf(LAPACK_ROW_MAJOR, n, n, va, n, pivots);
-
-    if (status != 0) {
-        RETURN_NULL();
-    }
-    
-    status = LAPACKE_dgetri(LAPACK_ROW_MAJOR, n, va, n, pivots);
+    status = LAPACKE_dgetrf(LAPACK_ROW_MAJOR, n, n, bb->data, n, pivots);
 
-    if (status != 0) {
-        RETURN_NULL();
+    if (status == 0) {
+        status = LAPACKE_dgetri(LAPACK_ROW_MAJOR, n, bb->data, n, pivots);
     }
 
-    array_init_size(&b, n);
-
-    for (i = 0; i < n; ++i) {
-        array_init_size(&rowB, n);
+    efree(pivots);
 
-        for (j = 0; j < n; ++j) {
-            add_next_index_double(&rowB, va[i * n + j]);
-        }
+    if (status != 0) {
+        zval_ptr_dtor(&b);
 
-        add_next_index_zval(&b, &rowB);
+        RETURN_NULL();
     }
 
-    RETVAL_ARR(Z_ARR(b));
-
-    efree(va);
-    efree(pivots);
+    RETVAL_OBJ(Z_OBJ(b));
 }
 
 /**
@@ -160,33 +421,30 @@ void tensor_inverse(zval * return_value, zval * a)
  */
 void tensor_pseudoinverse(zval * return_value, zval * a)
 {
-    unsigned int i, j;
-    zval * row;
-    zval b, rowB;
+    unsigned int i;
+    zval b;
 
-    zend_array * aa = Z_ARR_P(a);
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
 
-    unsigned int m = zend_array_count(aa);
-    unsigned int n = zend_array_count(Z_ARR_P(zend_hash_index_find(aa, 0)));
+    unsigned int m = ba->m;
+    unsigned int n = ba->n;
     unsigned int k = MIN(m, n);
 
     double * va = emalloc(m * n * sizeof(double));
     double * vu = emalloc(m * m * sizeof(double));
     double * vs = emalloc(k * sizeof(double));
     double * vvt = emalloc(n * n * sizeof(double));
-    double * vb = emalloc(n * m * sizeof(double));
 
-    for (i = 0; i < m; ++i) {
-        row = zend_hash_index_find(aa, i);
-
-        for (j = 0; j < n; ++j) {
-            va[i * n + j] = zephir_get_doubleval(zend_hash_index_find(Z_ARR_P(row), j));
-        }
-    }
+    memcpy(va, ba->data, m * n * sizeof(double));
 
     lapack_int status = LAPACKE_dgesdd(LAPACK_ROW_MAJOR, 'A', m, n, va, n, vs, vu, m, vvt, n);
 
     if (status != 0) {
+        efree(va);
+        efree(vu);
+        efree(vs);
+        efree(vvt);
+
         RETURN_NULL();
     }
 
@@ -194,27 +452,16 @@ void tensor_pseudoinverse(zval * return_value, zval * a)
         cblas_dscal(m, 1.0 / vs[i], &vu[i], m);
     }
 
-    cblas_dgemm(CblasRowMajor, CblasTrans, CblasTrans, n, m, m, 1.0, vvt, n, vu, m, 0.0, vb, m);
+    tensor_buffer * bb = tensor_buffer_alloc(&b, n, m);
 
-    array_init_size(&b, n);
+    cblas_dgemm(CblasRowMajor, CblasTrans, CblasTrans, n, m, m, 1.0, vvt, n, vu, m, 0.0, bb->data, m);
 
-    for (i = 0; i < n; ++i) {
-        array_init_size(&rowB, m);
-
-        for (j = 0; j < m; ++j) {
-            add_next_index_double(&rowB, vb[i * m + j]);
-        }
-
-        add_next_index_zval(&b, &rowB);
-    }
-
-    RETVAL_ARR(Z_ARR(b));
+    RETVAL_OBJ(Z_OBJ(b));
 
     efree(va);
     efree(vu);
     efree(vs);
     efree(vvt);
-    efree(vb);
 }
 
 /**
@@ -226,50 +473,37 @@ void tensor_pseudoinverse(zval * return_value, zval * a)
 void tensor_ref(zval * return_value, zval * a)
 {
     unsigned int i, j;
-    zval * row;
-    zval rowB, b;
+    zval b;
     zval tuple;
 
-    zend_array * aa = Z_ARR_P(a);
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
 
-    unsigned int m = zend_array_count(aa);
-    unsigned int n = zend_array_count(Z_ARR_P(zend_hash_index_find(aa, 0)));
+    unsigned int m = ba->m;
+    unsigned int n = ba->n;
 
-    double * va = emalloc(m * n * sizeof(double));
-    int * pivots = emalloc(MIN(m, n) * sizeof(int));
+    tensor_buffer * bb = tensor_buffer_alloc(&b, m, n);
 
-    for (i = 0; i < m; ++i) {
-        row = zend_hash_index_find(aa, i);
+    int * pivots = emalloc(MIN(m, n) * sizeof(int));
 
-        for (j = 0; j < n; ++j) {
-            va[i * n + j] = zephir_get_doubleval(zend_hash_index_find(Z_ARR_P(row), j));
-        }
-    }
+    memcpy(bb->data, ba->data, m * n * sizeof(double));
 
-    lapack_int status = LAPACKE_dgetrf(LAPACK_ROW_MAJOR, m, n, va, n, pivots);
+    lapack_int status = LAPACKE_dgetrf(LAPACK_ROW_MAJOR, m, n, bb->data, n, pivots);
 
     if (status != 0) {
+        zval_ptr_dtor(&b);
+        efree(pivots);
+
         RETURN_NULL();
     }
-    
-    array_init_size(&b, m);
 
     long swaps = 0;
 
     for (i = 0; i < m; ++i) {
-        array_init_size(&rowB, n);
-
-        for (j = 0; j < i; ++j) {
-            add_next_index_double(&rowB, 0.0);
-        }
-
-        for (j = i; j < n; ++j) {
-            add_next_index_double(&rowB, va[i * n + j]);
+        for (j = 0; j < i && j < n; ++j) {
+            bb->data[i * n + j] = 0.0;
         }
 
-        add_next_index_zval(&b, &rowB);
-
-        if (i + 1 != pivots[i]) {
+        if (i < MIN(m, n) && i + 1 != pivots[i]) {
             ++swaps;
         }
     }
@@ -281,7 +515,6 @@ void tensor_ref(zval * return_value, zval * a)
 
     RETVAL_ARR(Z_ARR(tuple));
 
-    efree(va);
     efree(pivots);
 }
 
@@ -294,48 +527,31 @@ void tensor_ref(zval * return_value, zval * a)
 void tensor_cholesky(zval * return_value, zval * a)
 {
     unsigned int i, j;
-    zval * row;
-    zval rowB, b;
+    zval b;
 
-    zend_array * aa = Z_ARR_P(a);
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
 
-    unsigned int n = zend_array_count(aa);
-
-    double * va = emalloc(n * n * sizeof(double));
+    unsigned int n = ba->m;
 
-    for (i = 0; i < n; ++i) {
-        row = zend_hash_index_find(aa, i);
+    tensor_buffer * bb = tensor_buffer_alloc(&b, n, n);
 
-        for (j = 0; j < n; ++j) {
-            va[i * n + j] = zephir_get_doubleval(zend_hash_index_find(Z_ARR_P(row), j));
-        }
-    }
+    memcpy(bb->data, ba->data, n * n * sizeof(double));
 
-    lapack_int status = LAPACKE_dpotrf(LAPACK_ROW_MAJOR, 'L', n, va, n);
+    lapack_int status = LAPACKE_dpotrf(LAPACK_ROW_MAJOR, 'L', n, bb->data, n);
 
     if (status != 0) {
+        zval_ptr_dtor(&b);
+
         RETURN_NULL();
     }
-    
-    array_init_size(&b, n);
 
     for (i = 0; i < n; ++i) {
-        array_init_size(&rowB, n);
-
-        for (j = 0; j <= i; ++j) {
-            add_next_index_double(&rowB, va[i * n + j]);
-        }
-
         for (j = i + 1; j < n; ++j) {
-            add_next_index_double(&rowB, 0.0);
+            bb->data[i * n + j] = 0.0;
         }
-
-        add_next_index_zval(&b, &rowB);
     }
 
-    RETVAL_ARR(Z_ARR(b));
-
-    efree(va);
+    RETVAL_OBJ(Z_OBJ(b));
 }
 
 /**
@@ -347,64 +563,44 @@ void tensor_cholesky(zval * return_value, zval * a)
 void tensor_lu(zval * return_value, zval * a)
 {
     unsigned int i, j;
-    zval * row;
-    zval rowL, l, rowU, u, rowP, p;
+    zval l, u, rowP, p;
     zval tuple;
 
-    zend_array * aa = Z_ARR_P(a);
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
 
-    unsigned int n = zend_array_count(aa);
+    unsigned int n = ba->m;
 
-    double * va = emalloc(n * n * sizeof(double));
-    int * pivots = emalloc(n * sizeof(int));
+    tensor_buffer * bu = tensor_buffer_alloc(&u, n, n);
 
-    for (i = 0; i < n; ++i) {
-        row = zend_hash_index_find(aa, i);
+    int * pivots = emalloc(n * sizeof(int));
 
-        for (j = 0; j < n; ++j) {
-            va[i * n + j] = zephir_get_doubleval(zend_hash_index_find(Z_ARR_P(row), j));
-        }
-    }
+    memcpy(bu->data, ba->data, n * n * sizeof(double));
 
-    lapack_int status = LAPACKE_dgetrf(LAPACK_ROW_MAJOR, n, n, va, n, pivots);
+    lapack_int status = LAPACKE_dgetrf(LAPACK_ROW_MAJOR, n, n, bu->data, n, pivots);
 
     if (status != 0) {
+        zval_ptr_dtor(&u);
+        efree(pivots);
+
         RETURN_NULL();
     }
-    
-    array_init_size(&l, n);
-    array_init_size(&u, n);
-    array_init_size(&p, n);
 
-    for (i = 0; i < n; ++i) {
-        array_init_size(&rowL, n);
+    tensor_buffer * bl = tensor_buffer_alloc(&l, n, n);
 
+    for (i = 0; i < n; ++i) {
         for (j = 0; j < i; ++j) {
-            add_next_index_double(&rowL, va[i * n + j]);
+            bl->data[i * n + j] = bu->data[i * n + j];
+            bu->data[i * n + j] = 0.0;
         }
 
-        add_next_index_double(&rowL, 1.0);
+        bl->data[i * n + i] = 1.0;
 
         for (j = i + 1; j < n; ++j) {
-            add_next_index_double(&rowL, 0.0);
+            bl->data[i * n + j] = 0.0;
         }
-
-        add_next_index_zval(&l, &rowL);
     }
 
-    for (i = 0; i < n; ++i) {
-        array_init_size(&rowU, n);
-
-        for (j = 0; j < i; ++j) {
-            add_next_index_double(&rowU, 0.0);
-        }
-
-        for (j = i; j < n; ++j) {
-            add_next_index_double(&rowU, va[i * n + j]);
-        }
-
-        add_next_index_zval(&u, &rowU);
-    }
+    array_init_size(&p, n);
 
     for (i = 0; i < n; ++i) {
         array_init_size(&rowP, n);
@@ -428,7 +624,6 @@ void tensor_lu(zval * return_value, zval * a)
 
     RETVAL_ARR(Z_ARR(tuple));
 
-    efree(va);
     efree(pivots); 
 }
 
@@ -441,32 +636,30 @@ void tensor_lu(zval * return_value, zval * a)
 void tensor_eig(zval * return_value, zval * a)
 {
     unsigned int i, j;
-    zval * row;
     zval eigenvalues;
     zval eigenvectors;
     zval eigenvector;
     zval tuple;
 
-    zend_array * aa = Z_ARR_P(a);
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
 
-    unsigned int n = zend_array_count(aa);
+    unsigned int n = ba->m;
 
     double * va = emalloc(n * n * sizeof(double));
     double * wr = emalloc(n * sizeof(double));
     double * wi = emalloc(n * sizeof(double));
     double * vr = emalloc(n * n * sizeof(double));
 
-    for (i = 0; i < n; ++i) {
-        row = zend_hash_index_find(aa, i);
-
-        for (j = 0; j < n; ++j) {
-            va[i * n + j] = zephir_get_doubleval(zend_hash_index_find(Z_ARR_P(row), j));
-        }
-    }
+    memcpy(va, ba->data, n * n * sizeof(double));
 
     lapack_int status = LAPACKE_dgeev(LAPACK_ROW_MAJOR, 'N', 'V', n, va, n, wr, wi, NULL, n, vr, n);
 
     if (status != 0) {
+        efree(va);
+        efree(wr);
+        efree(wi);
+        efree(vr);
+
         RETURN_NULL();
     }
 
@@ -507,30 +700,26 @@ void tensor_eig(zval * return_value, zval * a)
 void tensor_eig_symmetric(zval * return_value, zval * a)
 {
     unsigned int i, j;
-    zval * row;
     zval eigenvalues;
     zval eigenvectors;
     zval eigenvector;
     zval tuple;
 
-    zend_array * aa = Z_ARR_P(a);
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
 
-    unsigned int n = zend_array_count(aa);
+    unsigned int n = ba->m;
 
     double * va = emalloc(n * n * sizeof(double));
     double * wr = emalloc(n * sizeof(double));
 
-    for (i = 0; i < n; ++i) {
-        row = zend_hash_index_find(aa, i);
-
-        for (j = 0; j < n; ++j) {
-            va[i * n + j] = zephir_get_doubleval(zend_hash_index_find(Z_ARR_P(row), j));
-        }
-    }
+    memcpy(va, ba->data, n * n * sizeof(double));
 
     lapack_int status = LAPACKE_dsyev(LAPACK_ROW_MAJOR, 'V', 'U', n, va, n, wr);
 
     if (status != 0) {
+        efree(va);
+        efree(wr);
+
         RETURN_NULL();
     }
 
@@ -568,66 +757,43 @@ void tensor_eig_symmetric(zval * return_value, zval * a)
  */
 void tensor_svd(zval * return_value, zval * a)
 {
-    unsigned int i, j;
-    zval * row;
-    zval u, rowU;
+    unsigned int i;
+    zval u;
     zval s;
-    zval vt, rowVt;
+    zval vt;
     zval tuple;
 
-    zend_array * aa = Z_ARR_P(a);
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
 
-    unsigned int m = zend_array_count(aa);
-    unsigned int n = zend_array_count(Z_ARR_P(zend_hash_index_find(aa, 0)));
+    unsigned int m = ba->m;
+    unsigned int n = ba->n;
     unsigned int k = MIN(m, n);
 
     double * va = emalloc(m * n * sizeof(double));
-    double * vu = emalloc(m * m * sizeof(double));
     double * vs = emalloc(k * sizeof(double));
-    double * vvt = emalloc(n * n * sizeof(double));
 
-    for (i = 0; i < m; ++i) {
-        row = zend_hash_index_find(aa, i);
+    tensor_buffer * bu = tensor_buffer_alloc(&u, m, m);
+    tensor_buffer * bvt = tensor_buffer_alloc(&vt, n, n);
 
-        for (j = 0; j < n; ++j) {
-            va[i * n + j] = zephir_get_doubleval(zend_hash_index_find(Z_ARR_P(row), j));
-        }
-    }
+    memcpy(va, ba->data, m * n * sizeof(double));
 
-    lapack_int status = LAPACKE_dgesdd(LAPACK_ROW_MAJOR, 'A', m, n, va, n, vs, vu, m, vvt, n);
+    lapack_int status = LAPACKE_dgesdd(LAPACK_ROW_MAJOR, 'A', m, n, va, n, vs, bu->data, m, bvt->data, n);
 
     if (status != 0) {
+        zval_ptr_dtor(&u);
+        zval_ptr_dtor(&vt);
+        efree(va);
+        efree(vs);
+
         RETURN_NULL();
     }
 
-    array_init_size(&u, m);
     array_init_size(&s, k);
-    array_init_size(&vt, n);
 
-    for (i = 0; i < m; ++i) {
-        array_init_size(&rowU, m);
-
-        for (j = 0; j < m; ++j) {
-            add_next_index_double(&rowU, vu[i * m + j]);
-        }
-
-        add_next_index_zval(&u, &rowU);
-    }
-    
     for (i = 0; i < k; ++i) {
         add_next_index_double(&s, vs[i]);
     }
 
-    for (i = 0; i < n; ++i) {
-        array_init_size(&rowVt, n);
-
-        for (j = 0; j < n; ++j) {
-            add_next_index_double(&rowVt, vvt[i * n + j]);
-        }
-
-        add_next_index_zval(&vt, &rowVt);
-    }
-
     array_init_size(&tuple, 3);
     
     add_next_index_zval(&tuple, &u);
@@ -637,7 +803,5 @@ void tensor_svd(zval * return_value, zval * a)
     RETVAL_ARR(Z_ARR(tuple));
 
     efree(va);
-    efree(vu);
     efree(vs);
-    efree(vvt);
 }
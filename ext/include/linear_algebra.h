@@ -3,8 +3,18 @@
 
 #include <Zend/zend.h>
 
-void tensor_matmul(zval * return_value, zval * a, zval * b);
+#define TENSOR_TRANSPOSE_BLOCK 32
+
+void tensor_gemm(zval * return_value, zval * a, zval * b, zval * trans_a, zval * trans_b, zval * alpha, zval * beta, zval * c);
+void tensor_syrk(zval * return_value, zval * a, zval * trans, zval * alpha);
+void tensor_transpose(zval * return_value, zval * a);
+void tensor_gemv(zval * return_value, zval * a, zval * x, zval * trans);
+void tensor_ger(zval * return_value, zval * x, zval * y);
 void tensor_dot(zval * return_value, zval * a, zval * b);
+void tensor_l1_norm(zval * return_value, zval * a);
+void tensor_l2_norm(zval * return_value, zval * a);
+void tensor_p_norm(zval * return_value, zval * a, zval * p);
+void tensor_max_norm(zval * return_value, zval * a);
 
 void tensor_inverse(zval * return_value, zval * a);
 void tensor_pseudoinverse(zval * return_value, zval * a);
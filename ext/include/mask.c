@@ -0,0 +1,378 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <php.h>
+#include "kernel/operators.h"
+#include "buffer.h"
+#include "mask.h"
+#include "parallel.h"
+
+typedef struct _tensor_compare_job {
+    const void * a;
+    const void * b;
+    zend_uchar * c;
+    zend_long ma, na;
+    zend_long mb, nb;
+    zend_long n;
+    zend_long op;
+} tensor_compare_job;
+
+typedef struct _tensor_where_job {
+    const zend_uchar * mask;
+    const void * a;
+    const void * b;
+    void * c;
+    zend_bool scalar;
+} tensor_where_job;
+
+typedef struct _tensor_masked_sum_job {
+    const zend_uchar * mask;
+    const void * a;
+    double * c;
+    zend_long n;
+} tensor_masked_sum_job;
+
+#define TENSOR_COMPARE_LOOP(op) \
+    for (j = 0; j < n; ++j) { \
+        c[j] = a[j * sa] op b[j * sb]; \
+    } \
+    break;
+
+/**
+ * Define a kernel that compares a row of A to a row of B and writes the result to a row of the
+ * mask. A stride of 0 repeats the first element of the operand across the row.
+ */
+#define TENSOR_COMPARE_ROW(name, type) \
+static void name(zend_long op, const type * a, zend_long sa, const type * b, zend_long sb, zend_uchar * c, zend_long n) \
+{ \
+    zend_long j; \
+    switch (op) { \
+        case TENSOR_COMPARE_EQUAL: TENSOR_COMPARE_LOOP(==) \
+        case TENSOR_COMPARE_NOT_EQUAL: TENSOR_COMPARE_LOOP(!=) \
+        case TENSOR_COMPARE_GREATER: TENSOR_COMPARE_LOOP(>) \
+        case TENSOR_COMPARE_GREATER_EQUAL: TENSOR_COMPARE_LOOP(>=) \
+        case TENSOR_COMPARE_LESS: TENSOR_COMPARE_LOOP(<) \
+        case TENSOR_COMPARE_LESS_EQUAL: TENSOR_COMPARE_LOOP(<=) \
+    } \
+}
+
+/**
+ * Define a task that compares rows start through end of the operands.
+ */
+#define TENSOR_COMPARE_TASK(name, type, row) \
+static void name(void * context, size_t start, size_t end) \
+{ \
+    size_t i; \
+    tensor_compare_job * job = context; \
+    zend_long n = job->n; \
+    zend_long sa = job->na == n ? 1 : 0; \
+    zend_long sb = job->nb == n ? 1 : 0; \
+    for (i = start; i < end; ++i) { \
+        const type * va = (const type *) job->a + (job->ma == 1 ? 0 : i * job->na); \
+        const type * vb = (const type *) job->b + (job->mb == 1 ? 0 : i * job->nb); \
+        row(job->op, va, sa, vb, sb, job->c + i * n, n); \
+    } \
+}
+
+/**
+ * Define a task that selects elements start through end from A where the mask holds and from B
+ * otherwise.
+ */
+#define TENSOR_WHERE_TASK(name, type) \
+static void name(void * context, size_t start, size_t end) \
+{ \
+    size_t i; \
+    tensor_where_job * job = context; \
+    const zend_uchar * mask = job->mask; \
+    const type * a = job->a; \
+    const type * b = job->b; \
+    type * c = job->c; \
+    if (job->scalar) { \
+        type s = *b; \
+        for (i = start; i < end; ++i) { \
+            c[i] = mask[i] ? a[i] : s; \
+        } \
+    } else { \
+        for (i = start; i < end; ++i) { \
+            c[i] = mask[i] ? a[i] : b[i]; \
+        } \
+    } \
+}
+
+/**
+ * Define a task that sums the elements of rows start through end of A where the mask holds.
+ */
+#define TENSOR_MASKED_SUM_TASK(name, type) \
+static void name(void * context, size_t start, size_t end) \
+{ \
+    size_t i, j; \
+    tensor_masked_sum_job * job = context; \
+    size_t n = job->n; \
+    for (i = start; i < end; ++i) { \
+        const zend_uchar * mask = job->mask + i * n; \
+        const type * a = (const type *) job->a + i * n; \
+        double sigma = 0.0; \
+        for (j = 0; j < n; ++j) { \
+            sigma += mask[j] ? a[j] : 0.0; \
+        } \
+        job->c[i] = sigma; \
+    } \
+}
+
+TENSOR_COMPARE_ROW(tensor_compare_row, double)
+TENSOR_COMPARE_ROW(tensor_compare_row32, float)
+
+TENSOR_COMPARE_TASK(tensor_compare_task, double, tensor_compare_row)
+TENSOR_COMPARE_TASK(tensor_compare_task32, float, tensor_compare_row32)
+
+TENSOR_WHERE_TASK(tensor_where_task, double)
+TENSOR_WHERE_TASK(tensor_where_task32, float)
+
+TENSOR_MASKED_SUM_TASK(tensor_masked_sum_task, double)
+TENSOR_MASKED_SUM_TASK(tensor_masked_sum_task32, float)
+
+/**
+ * Compare buffer A to buffer or scalar B element-wise and return a mask that holds where the
+ * comparison does. Either buffer may be a single row, or a single column when the column flag is
+ * set, in which case it is broadcast across the other the same way as the arithmetic kernels.
+ *
+ * @param return_value
+ * @param a
+ * @param b
+ * @param op
+ * @param column
+ */
+void tensor_compare(zval * return_value, zval * a, zval * b, zval * op, zval * column)
+{
+    double scalar;
+    float scalar32;
+    const void * vb;
+
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    zend_long ma = ba->m, na = ba->n;
+    zend_long mb = 1, nb = 1;
+
+    zend_bool single = ba->dtype == TENSOR_DTYPE_FLOAT32;
+
+    if (Z_TYPE_P(b) == IS_OBJECT) {
+        tensor_buffer * bb = Z_TENSOR_BUFFER_P(b);
+
+        mb = bb->m;
+        nb = bb->n;
+        vb = bb->data;
+
+        if (zend_is_true(column)) {
+            if (ma == 1 && mb != 1) {
+                ma = na;
+                na = 1;
+            } else if (mb == 1 && ma != 1) {
+                mb = nb;
+                nb = 1;
+            }
+        }
+    } else {
+        scalar = zephir_get_doubleval(b);
+        scalar32 = (float) scalar;
+
+        vb = single ? (const void *) &scalar32 : (const void *) &scalar;
+    }
+
+    zend_long m = MAX(ma, mb);
+    zend_long n = MAX(na, nb);
+
+    tensor_buffer * bc = tensor_buffer_alloc_dtype(return_value, m, n, TENSOR_DTYPE_BOOL);
+
+    if (m == 0 || n == 0) {
+        return;
+    }
+
+    tensor_compare_job job = {
+        .a = ba->data, .b = vb, .c = bc->mask,
+        .ma = ma, .na = na, .mb = mb, .nb = nb, .n = n,
+        .op = zephir_get_intval(op),
+    };
+
+    tensor_parallel_for(m, MAX(1, tensor_grain_size / n), single ? tensor_compare_task32 : tensor_compare_task, &job);
+}
+
+/**
+ * Return a mask that holds where both mask A and mask B hold.
+ *
+ * @param return_value
+ * @param a
+ * @param b
+ */
+void tensor_mask_and(zval * return_value, zval * a, zval * b)
+{
+    size_t i;
+
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+    tensor_buffer * bb = Z_TENSOR_BUFFER_P(b);
+
+    size_t n = ba->m * ba->n;
+
+    tensor_buffer * bc = tensor_buffer_alloc_dtype(return_value, ba->m, ba->n, TENSOR_DTYPE_BOOL);
+
+    for (i = 0; i < n; ++i) {
+        bc->mask[i] = ba->mask[i] & bb->mask[i];
+    }
+}
+
+/**
+ * Return a mask that holds where either mask A or mask B holds.
+ *
+ * @param return_value
+ * @param a
+ * @param b
+ */
+void tensor_mask_or(zval * return_value, zval * a, zval * b)
+{
+    size_t i;
+
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+    tensor_buffer * bb = Z_TENSOR_BUFFER_P(b);
+
+    size_t n = ba->m * ba->n;
+
+    tensor_buffer * bc = tensor_buffer_alloc_dtype(return_value, ba->m, ba->n, TENSOR_DTYPE_BOOL);
+
+    for (i = 0; i < n; ++i) {
+        bc->mask[i] = ba->mask[i] | bb->mask[i];
+    }
+}
+
+/**
+ * Return a mask that holds where mask A does not.
+ *
+ * @param return_value
+ * @param a
+ */
+void tensor_mask_not(zval * return_value, zval * a)
+{
+    size_t i;
+
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    size_t n = ba->m * ba->n;
+
+    tensor_buffer * bc = tensor_buffer_alloc_dtype(return_value, ba->m, ba->n, TENSOR_DTYPE_BOOL);
+
+    for (i = 0; i < n; ++i) {
+        bc->mask[i] = ba->mask[i] ^ 1;
+    }
+}
+
+/**
+ * Return the number of elements where mask A holds.
+ *
+ * @param return_value
+ * @param a
+ */
+void tensor_mask_count(zval * return_value, zval * a)
+{
+    size_t i;
+    zend_long count = 0;
+
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    size_t n = ba->m * ba->n;
+
+    for (i = 0; i < n; ++i) {
+        count += ba->mask[i];
+    }
+
+    RETURN_LONG(count);
+}
+
+/**
+ * Return the elements of buffer A where the mask holds and the elements of buffer or scalar B
+ * otherwise. The result has the dtype of A.
+ *
+ * @param return_value
+ * @param mask
+ * @param a
+ * @param b
+ */
+void tensor_where(zval * return_value, zval * mask, zval * a, zval * b)
+{
+    double scalar;
+    float scalar32;
+
+    tensor_buffer * bm = Z_TENSOR_BUFFER_P(mask);
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    zend_bool single = ba->dtype == TENSOR_DTYPE_FLOAT32;
+
+    tensor_buffer * bc = tensor_buffer_alloc_dtype(return_value, ba->m, ba->n, ba->dtype);
+
+    tensor_where_job job = {
+        .mask = bm->mask, .a = ba->data, .c = bc->data,
+        .scalar = Z_TYPE_P(b) != IS_OBJECT,
+    };
+
+    if (job.scalar) {
+        scalar = zephir_get_doubleval(b);
+        scalar32 = (float) scalar;
+
+        job.b = single ? (const void *) &scalar32 : (const void *) &scalar;
+    } else {
+        job.b = Z_TENSOR_BUFFER_P(b)->data;
+    }
+
+    tensor_parallel_for(ba->m * ba->n, tensor_grain_size, single ? tensor_where_task32 : tensor_where_task, &job);
+}
+
+/**
+ * Return the sum of each row of buffer A over the elements where the mask holds.
+ *
+ * @param return_value
+ * @param a
+ * @param mask
+ */
+void tensor_masked_sum(zval * return_value, zval * a, zval * mask)
+{
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    zend_long m = ba->m;
+    zend_long n = ba->n;
+
+    tensor_buffer * bc = tensor_buffer_alloc(return_value, m > 0 ? 1 : 0, m);
+
+    tensor_masked_sum_job job = {
+        .mask = Z_TENSOR_BUFFER_P(mask)->mask, .a = ba->data, .c = bc->data, .n = n,
+    };
+
+    tensor_parallel_for(m, MAX(1, tensor_grain_size / MAX(n, 1)), ba->dtype == TENSOR_DTYPE_FLOAT32 ? tensor_masked_sum_task32 : tensor_masked_sum_task, &job);
+}
+
+/**
+ * Return the sum of the elements of vector A where the mask holds.
+ *
+ * @param return_value
+ * @param a
+ * @param mask
+ */
+void tensor_vector_masked_sum(zval * return_value, zval * a, zval * mask)
+{
+    size_t i;
+    double sigma = 0.0;
+
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+    tensor_buffer * bm = Z_TENSOR_BUFFER_P(mask);
+
+    size_t n = ba->m * ba->n;
+
+    if (ba->dtype == TENSOR_DTYPE_FLOAT32) {
+        for (i = 0; i < n; ++i) {
+            sigma += bm->mask[i] ? ba->single[i] : 0.0;
+        }
+    } else {
+        for (i = 0; i < n; ++i) {
+            sigma += bm->mask[i] ? ba->data[i] : 0.0;
+        }
+    }
+
+    RETURN_DOUBLE(sigma);
+}
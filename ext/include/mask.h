@@ -0,0 +1,24 @@
+#ifndef TENSOR_MASK_H
+#define TENSOR_MASK_H
+
+#include <Zend/zend.h>
+
+enum {
+    TENSOR_COMPARE_EQUAL,
+    TENSOR_COMPARE_NOT_EQUAL,
+    TENSOR_COMPARE_GREATER,
+    TENSOR_COMPARE_GREATER_EQUAL,
+    TENSOR_COMPARE_LESS,
+    TENSOR_COMPARE_LESS_EQUAL
+};
+
+void tensor_compare(zval * return_value, zval * a, zval * b, zval * op, zval * column);
+void tensor_mask_and(zval * return_value, zval * a, zval * b);
+void tensor_mask_or(zval * return_value, zval * a, zval * b);
+void tensor_mask_not(zval * return_value, zval * a);
+void tensor_mask_count(zval * return_value, zval * a);
+void tensor_where(zval * return_value, zval * mask, zval * a, zval * b);
+void tensor_masked_sum(zval * return_value, zval * a, zval * mask);
+void tensor_vector_masked_sum(zval * return_value, zval * a, zval * mask);
+
+#endif
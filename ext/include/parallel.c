@@ -0,0 +1,725 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <php.h>
+#include "parallel.h"
+#include "simd.h"
+
+#ifndef ZEND_WIN32
+#include <pthread.h>
+#include <stdint.h>
+#include <time.h>
+#endif
+
+/**
+ * The number of threads, including the calling thread, that kernels may be split across. Single
+ * threaded by default to match the BLAS configuration at module startup. Thread local under ZTS
+ * so that every request has its own budget.
+ */
+TENSOR_TLS zend_long tensor_num_threads = 1;
+
+/**
+ * The minimum number of elements handed to a thread at a time. Kernels with fewer than two grains
+ * of work run on the calling thread.
+ */
+TENSOR_TLS zend_long tensor_grain_size = TENSOR_DEFAULT_GRAIN_SIZE;
+
+/**
+ * Per-thread counters of the work done by the row scheduler. Slot 0 is the submitting thread. The
+ * counters are process-wide and shared by every request thread under ZTS. Each slot is only
+ * written by its own thread while a job runs with the submit lock held, and they are read and
+ * reset under the same lock.
+ */
+static tensor_worker_stats tensor_stats[TENSOR_MAX_THREADS];
+
+/**
+ * The wall time spent inside row scheduler jobs since the counters were last reset.
+ */
+static double tensor_stats_wall = 0.0;
+
+/**
+ * Return a monotonic timestamp in seconds.
+ *
+ * @return double
+ */
+static double tensor_clock()
+{
+#ifndef ZEND_WIN32
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#else
+    struct timespec ts;
+
+    timespec_get(&ts, TIME_UTC);
+
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+#ifndef ZEND_WIN32
+
+/**
+ * A fork-join pool of worker threads. The calling thread publishes a job, wakes the workers, and
+ * then claims chunks of the index range alongside them until the range is exhausted. Chunks are
+ * claimed from a shared counter so faster threads simply take more of them.
+ */
+static struct {
+    pthread_t threads[TENSOR_MAX_THREADS];
+    pthread_mutex_t lock;
+    pthread_mutex_t submit;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    int size;
+    int active;
+    int stop;
+    int initialized;
+    int participants;
+    unsigned long generation;
+    unsigned long born[TENSOR_MAX_THREADS];
+    void (*drain)(int slot);
+    tensor_parallel_task task;
+    void * context;
+    size_t n;
+    size_t grain;
+    size_t next;
+} tensor_pool = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .submit = PTHREAD_MUTEX_INITIALIZER,
+    .wake = PTHREAD_COND_INITIALIZER,
+    .done = PTHREAD_COND_INITIALIZER,
+};
+
+/**
+ * The remaining range of rows owned by each thread during a row scheduler job. The owner takes
+ * chunks from the front and idle threads steal the back half. Each range sits on its own cache
+ * line so that threads working through their own rows do not contend.
+ */
+static struct {
+    pthread_mutex_t lock;
+    size_t start;
+    size_t end;
+} __attribute__((aligned(64))) tensor_ranges[TENSOR_MAX_THREADS];
+
+/**
+ * Claim and run chunks of the current job from the shared counter until none are left.
+ *
+ * @param slot
+ */
+static void tensor_pool_drain(int slot)
+{
+    size_t start;
+
+    while ((start = __atomic_fetch_add(&tensor_pool.next, tensor_pool.grain, __ATOMIC_RELAXED)) < tensor_pool.n) {
+        tensor_pool.task(tensor_pool.context, start, MIN(start + tensor_pool.grain, tensor_pool.n));
+    }
+}
+
+/**
+ * Take the next chunk of rows from the front of the range owned by a thread.
+ *
+ * @param slot
+ * @param start
+ * @param end
+ * @return int
+ */
+static int tensor_range_pop(int slot, size_t * start, size_t * end)
+{
+    int found = 0;
+
+    pthread_mutex_lock(&tensor_ranges[slot].lock);
+
+    if (tensor_ranges[slot].start < tensor_ranges[slot].end) {
+        *start = tensor_ranges[slot].start;
+        *end = MIN(*start + tensor_pool.grain, tensor_ranges[slot].end);
+
+        tensor_ranges[slot].start = *end;
+
+        found = 1;
+    }
+
+    pthread_mutex_unlock(&tensor_ranges[slot].lock);
+
+    return found;
+}
+
+/**
+ * Move the back half of the rows owned by the victim, or all of them if they are no more than a
+ * single chunk, to the thief.
+ *
+ * @param victim
+ * @param thief
+ * @return int
+ */
+static int tensor_range_steal(int victim, int thief)
+{
+    size_t mid, end;
+
+    pthread_mutex_lock(&tensor_ranges[victim].lock);
+
+    size_t remaining = tensor_ranges[victim].end - tensor_ranges[victim].start;
+
+    if (remaining == 0) {
+        pthread_mutex_unlock(&tensor_ranges[victim].lock);
+
+        return 0;
+    }
+
+    mid = tensor_ranges[victim].start + (remaining > tensor_pool.grain ? remaining / 2 : 0);
+    end = tensor_ranges[victim].end;
+
+    tensor_ranges[victim].end = mid;
+
+    pthread_mutex_unlock(&tensor_ranges[victim].lock);
+
+    pthread_mutex_lock(&tensor_ranges[thief].lock);
+
+    tensor_ranges[thief].start = mid;
+    tensor_ranges[thief].end = end;
+
+    pthread_mutex_unlock(&tensor_ranges[thief].lock);
+
+    return 1;
+}
+
+/**
+ * Run chunks of rows from the range owned by a thread and steal from the other threads once it
+ * runs dry. Rows in transit between two threads are always run by the thief, so a thread may
+ * stop as soon as one sweep over the others finds nothing left to steal.
+ *
+ * @param slot
+ */
+static void tensor_pool_steal(int slot)
+{
+    int k;
+    size_t start, end;
+
+    int participants = tensor_pool.participants;
+
+    tensor_worker_stats * stats = &tensor_stats[slot];
+
+    while (1) {
+        if (tensor_range_pop(slot, &start, &end)) {
+            double began = tensor_clock();
+
+            tensor_pool.task(tensor_pool.context, start, end);
+
+            stats->busy += tensor_clock() - began;
+            stats->rows += end - start;
+
+            ++stats->tasks;
+
+            continue;
+        }
+
+        for (k = 1; k < participants; ++k) {
+            if (tensor_range_steal((slot + k) % participants, slot)) {
+                ++stats->steals;
+
+                break;
+            }
+        }
+
+        if (k == participants) {
+            break;
+        }
+    }
+}
+
+/**
+ * The main loop of a worker thread. The argument is the slot of the worker, slot 0 being the
+ * calling thread. A worker only runs jobs published after the pool that it belongs to started.
+ *
+ * @param arg
+ * @return void
+ */
+static void * tensor_pool_worker(void * arg)
+{
+    int slot = (int) (uintptr_t) arg;
+
+    pthread_mutex_lock(&tensor_pool.lock);
+
+    unsigned long seen = tensor_pool.born[slot];
+
+    while (1) {
+        while (!tensor_pool.stop && tensor_pool.generation == seen) {
+            pthread_cond_wait(&tensor_pool.wake, &tensor_pool.lock);
+        }
+
+        if (tensor_pool.stop) {
+            break;
+        }
+
+        seen = tensor_pool.generation;
+
+        if (slot >= tensor_pool.participants) {
+            continue;
+        }
+
+        pthread_mutex_unlock(&tensor_pool.lock);
+
+        tensor_pool.drain(slot);
+
+        pthread_mutex_lock(&tensor_pool.lock);
+
+        if (--tensor_pool.active == 0) {
+            pthread_cond_signal(&tensor_pool.done);
+        }
+    }
+
+    pthread_mutex_unlock(&tensor_pool.lock);
+
+    return NULL;
+}
+
+/**
+ * Stop and join every worker thread.
+ */
+static void tensor_pool_stop()
+{
+    int i;
+
+    pthread_mutex_lock(&tensor_pool.lock);
+
+    tensor_pool.stop = 1;
+
+    pthread_cond_broadcast(&tensor_pool.wake);
+
+    pthread_mutex_unlock(&tensor_pool.lock);
+
+    for (i = 0; i < tensor_pool.size; ++i) {
+        pthread_join(tensor_pool.threads[i], NULL);
+    }
+
+    tensor_pool.size = 0;
+    tensor_pool.stop = 0;
+}
+
+/**
+ * Hold the submit and pool locks across a fork so that the child never inherits them mid-job.
+ */
+static void tensor_pool_prepare()
+{
+    pthread_mutex_lock(&tensor_pool.submit);
+    pthread_mutex_lock(&tensor_pool.lock);
+}
+
+/**
+ * Release the locks taken before the fork in the parent.
+ */
+static void tensor_pool_parent()
+{
+    pthread_mutex_unlock(&tensor_pool.lock);
+    pthread_mutex_unlock(&tensor_pool.submit);
+}
+
+/**
+ * Discard the pool in a child process. The child inherits the bookkeeping of the pool but not its
+ * threads, and the condition variables still count the workers of the parent as waiters, so every
+ * primitive is initialized again and new workers are started on the next parallel kernel.
+ */
+static void tensor_pool_child()
+{
+    int i;
+
+    pthread_mutex_init(&tensor_pool.lock, NULL);
+    pthread_mutex_init(&tensor_pool.submit, NULL);
+    pthread_cond_init(&tensor_pool.wake, NULL);
+    pthread_cond_init(&tensor_pool.done, NULL);
+
+    for (i = 0; i < TENSOR_MAX_THREADS; ++i) {
+        pthread_mutex_init(&tensor_ranges[i].lock, NULL);
+    }
+
+    tensor_pool.size = 0;
+    tensor_pool.active = 0;
+    tensor_pool.stop = 0;
+}
+
+/**
+ * Make sure that the pool has at least the given number of workers. Workers are started lazily on
+ * first use so that no threads exist when a server forks its children, and the fork handlers are
+ * registered along with the first worker. The pool only grows since callers with a smaller thread
+ * budget simply leave workers idle.
+ *
+ * @param workers
+ */
+static void tensor_pool_ensure(int workers)
+{
+    int i;
+
+    if (tensor_pool.size >= workers) {
+        return;
+    }
+
+    if (!tensor_pool.initialized) {
+        for (i = 0; i < TENSOR_MAX_THREADS; ++i) {
+            pthread_mutex_init(&tensor_ranges[i].lock, NULL);
+        }
+
+        pthread_atfork(tensor_pool_prepare, tensor_pool_parent, tensor_pool_child);
+
+        tensor_pool.initialized = 1;
+    }
+
+    for (i = tensor_pool.size; i < workers; ++i) {
+        tensor_pool.born[i + 1] = tensor_pool.generation;
+
+        if (pthread_create(&tensor_pool.threads[i], NULL, tensor_pool_worker, (void *) (uintptr_t) (i + 1)) != 0) {
+            break;
+        }
+
+        tensor_pool.size = i + 1;
+    }
+}
+
+/**
+ * Publish a job to as many workers as the thread budget of the caller allows, drain it on the
+ * calling thread as well, and wait for the workers to finish. The caller must hold the submit
+ * lock and the pool must have at least one worker.
+ *
+ * @param n
+ * @param grain
+ * @param task
+ * @param context
+ * @param drain
+ */
+static void tensor_pool_dispatch(size_t n, size_t grain, tensor_parallel_task task, void * context, void (*drain)(int slot))
+{
+    pthread_mutex_lock(&tensor_pool.lock);
+
+    tensor_pool.drain = drain;
+    tensor_pool.task = task;
+    tensor_pool.context = context;
+    tensor_pool.n = n;
+    tensor_pool.grain = grain;
+    tensor_pool.next = 0;
+    tensor_pool.participants = MIN(tensor_num_threads, tensor_pool.size + 1);
+    tensor_pool.active = tensor_pool.participants - 1;
+
+    ++tensor_pool.generation;
+
+    pthread_cond_broadcast(&tensor_pool.wake);
+
+    pthread_mutex_unlock(&tensor_pool.lock);
+
+    drain(0);
+
+    pthread_mutex_lock(&tensor_pool.lock);
+
+    while (tensor_pool.active > 0) {
+        pthread_cond_wait(&tensor_pool.done, &tensor_pool.lock);
+    }
+
+    pthread_mutex_unlock(&tensor_pool.lock);
+}
+
+#endif
+
+/**
+ * Run a task over the index range [0, n) split into chunks of at least grain indices. The range
+ * is processed on the calling thread when it holds fewer than two chunks, when a single thread is
+ * configured, or when another thread is already using the pool.
+ *
+ * @param n
+ * @param grain
+ * @param task
+ * @param context
+ */
+void tensor_parallel_for(size_t n, size_t grain, tensor_parallel_task task, void * context)
+{
+    grain = MAX(grain, 1);
+
+#ifndef ZEND_WIN32
+    size_t chunks = (n + grain - 1) / grain;
+
+    if (tensor_num_threads > 1 && chunks > 1 && pthread_mutex_trylock(&tensor_pool.submit) == 0) {
+        tensor_pool_ensure(tensor_num_threads - 1);
+
+        if (tensor_pool.size > 0) {
+            tensor_pool_dispatch(n, grain, task, context, tensor_pool_drain);
+
+            pthread_mutex_unlock(&tensor_pool.submit);
+
+            return;
+        }
+
+        pthread_mutex_unlock(&tensor_pool.submit);
+    }
+#endif
+
+    if (n > 0) {
+        task(context, 0, n);
+    }
+}
+
+/**
+ * Run a task over the rows [0, n) with the work-stealing scheduler. Every thread starts with an
+ * equal share of the rows and takes chunks of grain rows from it, and threads that run out steal
+ * half of the rows left to another thread so that rows of uneven cost still keep every thread
+ * busy. The work done by each thread is added to the utilization counters.
+ *
+ * @param n
+ * @param grain
+ * @param task
+ * @param context
+ */
+void tensor_parallel_rows(size_t n, size_t grain, tensor_parallel_task task, void * context)
+{
+    grain = MAX(grain, 1);
+
+#ifndef ZEND_WIN32
+    size_t i;
+
+    if (pthread_mutex_trylock(&tensor_pool.submit) != 0) {
+        if (n > 0) {
+            task(context, 0, n);
+        }
+
+        return;
+    }
+#endif
+
+    double began = tensor_clock();
+
+#ifndef ZEND_WIN32
+    size_t chunks = (n + grain - 1) / grain;
+
+    if (tensor_num_threads > 1 && chunks > 1) {
+        tensor_pool_ensure(tensor_num_threads - 1);
+    }
+
+    if (tensor_num_threads > 1 && chunks > 1 && tensor_pool.size > 0) {
+        size_t participants = MIN(tensor_num_threads, tensor_pool.size + 1);
+
+        for (i = 0; i < participants; ++i) {
+            tensor_ranges[i].start = n * i / participants;
+            tensor_ranges[i].end = n * (i + 1) / participants;
+        }
+
+        tensor_pool_dispatch(n, grain, task, context, tensor_pool_steal);
+    } else
+#endif
+    if (n > 0) {
+        task(context, 0, n);
+
+        tensor_stats[0].busy += tensor_clock() - began;
+        tensor_stats[0].rows += n;
+
+        ++tensor_stats[0].tasks;
+    }
+
+    tensor_stats_wall += tensor_clock() - began;
+
+#ifndef ZEND_WIN32
+    pthread_mutex_unlock(&tensor_pool.submit);
+#endif
+}
+
+/**
+ * Copy the utilization counters of every thread and the wall time that the row scheduler has been
+ * running for into the given arrays, and return the number of threads in the pool including the
+ * submitting thread. The pool is shared by every request thread, so this is not capped by the
+ * thread budget of the caller.
+ *
+ * @param stats
+ * @param wall
+ * @return zend_long
+ */
+zend_long tensor_parallel_stats(tensor_worker_stats * stats, double * wall)
+{
+#ifndef ZEND_WIN32
+    pthread_mutex_lock(&tensor_pool.submit);
+#endif
+
+    memcpy(stats, tensor_stats, sizeof(tensor_stats));
+
+    *wall = tensor_stats_wall;
+
+#ifndef ZEND_WIN32
+    zend_long count = tensor_pool.size + 1;
+
+    pthread_mutex_unlock(&tensor_pool.submit);
+
+    return count;
+#else
+    return 1;
+#endif
+}
+
+/**
+ * Reset the utilization counters of every thread.
+ */
+void tensor_parallel_reset_stats()
+{
+#ifndef ZEND_WIN32
+    pthread_mutex_lock(&tensor_pool.submit);
+#endif
+
+    memset(tensor_stats, 0, sizeof(tensor_stats));
+
+    tensor_stats_wall = 0.0;
+
+#ifndef ZEND_WIN32
+    pthread_mutex_unlock(&tensor_pool.submit);
+#endif
+}
+
+/**
+ * Set the number of threads that kernels called from the current thread may be split across. Any
+ * missing workers are started the next time that a kernel runs in parallel.
+ *
+ * @param threads
+ */
+void tensor_parallel_resize(zend_long threads)
+{
+    tensor_num_threads = MAX(1, MIN(threads, TENSOR_MAX_THREADS));
+}
+
+/**
+ * Stop every worker thread at module shutdown.
+ */
+void tensor_parallel_shutdown()
+{
+#ifndef ZEND_WIN32
+    if (tensor_pool.size > 0) {
+        tensor_pool_stop();
+    }
+#endif
+}
+
+typedef struct _tensor_elementwise_job {
+    tensor_simd_binary binary;
+    tensor_simd_scalar scalar;
+    tensor_simd_unary unary;
+    const double * a;
+    const double * b;
+    double s;
+    double * c;
+} tensor_elementwise_job;
+
+typedef struct _tensor_elementwise_job32 {
+    tensor_simd_binary32 binary;
+    tensor_simd_scalar32 scalar;
+    const float * a;
+    const float * b;
+    float s;
+    float * c;
+} tensor_elementwise_job32;
+
+static void tensor_binary_task(void * context, size_t start, size_t end)
+{
+    tensor_elementwise_job * job = context;
+
+    job->binary(job->a + start, job->b + start, job->c + start, end - start);
+}
+
+static void tensor_scalar_task(void * context, size_t start, size_t end)
+{
+    tensor_elementwise_job * job = context;
+
+    job->scalar(job->a + start, job->s, job->c + start, end - start);
+}
+
+static void tensor_binary_task32(void * context, size_t start, size_t end)
+{
+    tensor_elementwise_job32 * job = context;
+
+    job->binary(job->a + start, job->b + start, job->c + start, end - start);
+}
+
+static void tensor_scalar_task32(void * context, size_t start, size_t end)
+{
+    tensor_elementwise_job32 * job = context;
+
+    job->scalar(job->a + start, job->s, job->c + start, end - start);
+}
+
+static void tensor_unary_task(void * context, size_t start, size_t end)
+{
+    tensor_elementwise_job * job = context;
+
+    job->unary(job->a + start, job->c + start, end - start);
+}
+
+/**
+ * Apply a binary kernel to arrays A and B of n doubles across the thread pool.
+ *
+ * @param op
+ * @param a
+ * @param b
+ * @param c
+ * @param n
+ */
+void tensor_parallel_binary(tensor_simd_binary op, const double * a, const double * b, double * c, size_t n)
+{
+    tensor_elementwise_job job = { .binary = op, .a = a, .b = b, .c = c };
+
+    tensor_parallel_for(n, tensor_grain_size, tensor_binary_task, &job);
+}
+
+/**
+ * Apply a scalar kernel to an array A of n doubles and scalar s across the thread pool.
+ *
+ * @param op
+ * @param a
+ * @param s
+ * @param c
+ * @param n
+ */
+void tensor_parallel_scalar(tensor_simd_scalar op, const double * a, double s, double * c, size_t n)
+{
+    tensor_elementwise_job job = { .scalar = op, .a = a, .s = s, .c = c };
+
+    tensor_parallel_for(n, tensor_grain_size, tensor_scalar_task, &job);
+}
+
+/**
+ * Apply a unary kernel to an array A of n doubles across the thread pool.
+ *
+ * @param op
+ * @param a
+ * @param b
+ * @param n
+ */
+void tensor_parallel_unary(tensor_simd_unary op, const double * a, double * b, size_t n)
+{
+    tensor_elementwise_job job = { .unary = op, .a = a, .c = b };
+
+    tensor_parallel_for(n, tensor_grain_size, tensor_unary_task, &job);
+}
+
+/**
+ * Apply a binary kernel to arrays A and B of n floats across the thread pool.
+ *
+ * @param op
+ * @param a
+ * @param b
+ * @param c
+ * @param n
+ */
+void tensor_parallel_binary32(tensor_simd_binary32 op, const float * a, const float * b, float * c, size_t n)
+{
+    tensor_elementwise_job32 job = { .binary = op, .a = a, .b = b, .c = c };
+
+    tensor_parallel_for(n, tensor_grain_size, tensor_binary_task32, &job);
+}
+
+/**
+ * Apply a scalar kernel to an array A of n floats and scalar s across the thread pool.
+ *
+ * @param op
+ * @param a
+ * @param s
+ * @param c
+ * @param n
+ */
+void tensor_parallel_scalar32(tensor_simd_scalar32 op, const float * a, float s, float * c, size_t n)
+{
+    tensor_elementwise_job32 job = { .scalar = op, .a = a, .s = s, .c = c };
+
+    tensor_parallel_for(n, tensor_grain_size, tensor_scalar_task32, &job);
+}
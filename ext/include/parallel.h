@@ -0,0 +1,35 @@
+#ifndef TENSOR_PARALLEL_H
+#define TENSOR_PARALLEL_H
+
+#include <Zend/zend.h>
+#include "context.h"
+#include "simd.h"
+
+#define TENSOR_MAX_THREADS 256
+#define TENSOR_DEFAULT_GRAIN_SIZE 32768
+
+typedef void (*tensor_parallel_task)(void * context, size_t start, size_t end);
+
+typedef struct _tensor_worker_stats {
+    double busy;
+    zend_long rows;
+    zend_long tasks;
+    zend_long steals;
+} tensor_worker_stats;
+
+extern TENSOR_TLS zend_long tensor_num_threads;
+extern TENSOR_TLS zend_long tensor_grain_size;
+
+void tensor_parallel_for(size_t n, size_t grain, tensor_parallel_task task, void * context);
+void tensor_parallel_rows(size_t n, size_t grain, tensor_parallel_task task, void * context);
+void tensor_parallel_binary(tensor_simd_binary op, const double * a, const double * b, double * c, size_t n);
+void tensor_parallel_scalar(tensor_simd_scalar op, const double * a, double s, double * c, size_t n);
+void tensor_parallel_unary(tensor_simd_unary op, const double * a, double * b, size_t n);
+void tensor_parallel_binary32(tensor_simd_binary32 op, const float * a, const float * b, float * c, size_t n);
+void tensor_parallel_scalar32(tensor_simd_scalar32 op, const float * a, float s, float * c, size_t n);
+void tensor_parallel_resize(zend_long threads);
+void tensor_parallel_shutdown();
+zend_long tensor_parallel_stats(tensor_worker_stats * stats, double * wall);
+void tensor_parallel_reset_stats();
+
+#endif
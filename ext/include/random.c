@@ -0,0 +1,847 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <php.h>
+#include <math.h>
+#include <time.h>
+#include "kernel/operators.h"
+#include "buffer.h"
+#include "context.h"
+#include "functions.h"
+#include "parallel.h"
+#include "random.h"
+#include "simd.h"
+
+#ifndef ZEND_WIN32
+#include <unistd.h>
+#else
+#include <process.h>
+#endif
+
+#if PHP_VERSION_ID >= 80200
+#include <ext/random/php_random.h>
+#else
+#include <ext/standard/php_random.h>
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+zend_class_entry * tensor_random_state_ce;
+
+static zend_object_handlers tensor_random_state_handlers;
+
+/**
+ * The generator used by the static constructors of the current thread along with the process
+ * that seeded it. A child process inherits the state of its parent, so the generator is reseeded
+ * after a fork to keep the children from drawing the same numbers.
+ */
+static TENSOR_TLS tensor_rng tensor_default_rng;
+static TENSOR_TLS zend_long tensor_default_pid = 0;
+
+static inline uint64_t tensor_rotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * Return the next output of a splitmix64 sequence. Used to expand a single seed into the state
+ * of the main generator.
+ *
+ * @param x
+ * @return uint64_t
+ */
+static uint64_t tensor_splitmix64(uint64_t * x)
+{
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+
+    return z ^ (z >> 31);
+}
+
+/**
+ * Seed a generator by expanding the seed with splitmix64 so that similar seeds still give
+ * unrelated streams.
+ *
+ * @param rng
+ * @param seed
+ */
+void tensor_rng_seed(tensor_rng * rng, uint64_t seed)
+{
+    int i;
+
+    for (i = 0; i < 4; ++i) {
+        rng->s[i] = tensor_splitmix64(&seed);
+    }
+}
+
+/**
+ * Return the next 64 random bits of a xoshiro256** generator.
+ *
+ * @param rng
+ * @return uint64_t
+ */
+uint64_t tensor_rng_next(tensor_rng * rng)
+{
+    uint64_t * s = rng->s;
+
+    uint64_t result = tensor_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+
+    s[2] ^= t;
+
+    s[3] = tensor_rotl(s[3], 45);
+
+    return result;
+}
+
+/**
+ * Return a random double in [0, 1) with all 53 bits of the mantissa filled.
+ *
+ * @param rng
+ * @return double
+ */
+double tensor_rng_double(tensor_rng * rng)
+{
+    return (tensor_rng_next(rng) >> 11) * 0x1.0p-53;
+}
+
+/**
+ * Advance a generator by 2^128 steps, which is the same as drawing 2^128 numbers. Used to hand out
+ * non-overlapping streams of the same sequence.
+ *
+ * @param rng
+ */
+void tensor_rng_jump(tensor_rng * rng)
+{
+    int i, b;
+
+    static const uint64_t jump[] = {
+        0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+        0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL,
+    };
+
+    uint64_t t[4] = { 0, 0, 0, 0 };
+
+    for (i = 0; i < 4; ++i) {
+        for (b = 0; b < 64; ++b) {
+            if (jump[i] & (1ULL << b)) {
+                t[0] ^= rng->s[0];
+                t[1] ^= rng->s[1];
+                t[2] ^= rng->s[2];
+                t[3] ^= rng->s[3];
+            }
+
+            tensor_rng_next(rng);
+        }
+    }
+
+    memcpy(rng->s, t, sizeof(t));
+}
+
+/**
+ * Return the generator of the current thread, seeding it from the operating system on first use
+ * and again after a fork.
+ *
+ * @return tensor_rng
+ */
+tensor_rng * tensor_rng_default()
+{
+    uint64_t seed;
+
+    zend_long pid = (zend_long) getpid();
+
+    if (tensor_default_pid != pid) {
+        if (php_random_bytes_silent(&seed, sizeof(seed)) == FAILURE) {
+            seed = (uint64_t) time(NULL) ^ ((uint64_t) pid << 32) ^ (uint64_t) (uintptr_t) &seed;
+        }
+
+        tensor_rng_seed(&tensor_default_rng, seed);
+
+        tensor_default_pid = pid;
+    }
+
+    return &tensor_default_rng;
+}
+
+/**
+ * Fill an array with doubles drawn uniformly from [lower, upper).
+ *
+ * @param rng
+ * @param a
+ * @param n
+ * @param lower
+ * @param upper
+ */
+void tensor_fill_uniform(tensor_rng * rng, double * a, size_t n, double lower, double upper)
+{
+    size_t i;
+
+    double scale = upper - lower;
+
+    for (i = 0; i < n; ++i) {
+        a[i] = lower + scale * tensor_rng_double(rng);
+    }
+}
+
+/**
+ * Fill an array with normally distributed doubles using the Box-Muller transform. Uniforms are
+ * drawn a tile at a time so that the logarithms, square roots, sines, and cosines run through the
+ * vectorized kernels when fast is set, and both outputs of every pair are used.
+ *
+ * @param rng
+ * @param a
+ * @param n
+ * @param mean
+ * @param std
+ * @param fast
+ */
+static void tensor_fill_gaussian_tiles(tensor_rng * rng, double * a, size_t n, double mean, double std, zend_bool fast)
+{
+    size_t i, j, len, half;
+
+    double r[TENSOR_RANDOM_TILE / 2];
+    double phi[TENSOR_RANDOM_TILE / 2];
+    double c[TENSOR_RANDOM_TILE / 2];
+    double s[TENSOR_RANDOM_TILE / 2];
+
+    for (j = 0; j < n; j += TENSOR_RANDOM_TILE) {
+        len = MIN(TENSOR_RANDOM_TILE, n - j);
+        half = (len + 1) / 2;
+
+        for (i = 0; i < half; ++i) {
+            r[i] = 1.0 - tensor_rng_double(rng);
+            phi[i] = 2.0 * M_PI * tensor_rng_double(rng);
+        }
+
+        if (fast) {
+            tensor_simd.log(r, r, half);
+            tensor_simd.cos(phi, c, half);
+            tensor_simd.sin(phi, s, half);
+        } else {
+            for (i = 0; i < half; ++i) {
+                r[i] = log(r[i]);
+                c[i] = cos(phi[i]);
+                s[i] = sin(phi[i]);
+            }
+        }
+
+        tensor_simd.multiply_scalar(r, -2.0, r, half);
+        tensor_simd.sqrt(r, r, half);
+
+        double * t = a + j;
+
+        for (i = 0; i < half; ++i) {
+            t[i] = mean + std * r[i] * c[i];
+        }
+
+        for (i = half; i < len; ++i) {
+            t[i] = mean + std * r[i - half] * s[i - half];
+        }
+    }
+}
+
+/**
+ * Fill an array with normally distributed doubles.
+ *
+ * @param rng
+ * @param a
+ * @param n
+ * @param mean
+ * @param std
+ */
+void tensor_fill_gaussian(tensor_rng * rng, double * a, size_t n, double mean, double std)
+{
+    tensor_fill_gaussian_tiles(rng, a, n, mean, std, tensor_fast_math);
+}
+
+/**
+ * Return a single standard normal draw.
+ *
+ * @param rng
+ * @return double
+ */
+static double tensor_rng_gaussian(tensor_rng * rng)
+{
+    double r = sqrt(-2.0 * log(1.0 - tensor_rng_double(rng)));
+
+    return r * cos(2.0 * M_PI * tensor_rng_double(rng));
+}
+
+/**
+ * Fill an array with normally distributed doubles truncated to within TENSOR_TRUNCATION standard
+ * deviations of the mean. The array is filled with the vectorized transform first and the few
+ * draws outside of the bounds, about one in twenty, are redrawn one at a time.
+ *
+ * @param rng
+ * @param a
+ * @param n
+ * @param mean
+ * @param std
+ * @param fast
+ */
+static void tensor_fill_truncated_gaussian(tensor_rng * rng, double * a, size_t n, double mean, double std, zend_bool fast)
+{
+    size_t i;
+
+    tensor_fill_gaussian_tiles(rng, a, n, 0.0, 1.0, fast);
+
+    for (i = 0; i < n; ++i) {
+        while (fabs(a[i]) > TENSOR_TRUNCATION) {
+            a[i] = tensor_rng_gaussian(rng);
+        }
+
+        a[i] = mean + std * a[i];
+    }
+}
+
+/**
+ * Fill an array with ones with probability p and zeros otherwise in a single pass.
+ *
+ * @param rng
+ * @param a
+ * @param n
+ * @param p
+ */
+static void tensor_fill_bernoulli(tensor_rng * rng, double * a, size_t n, double p)
+{
+    size_t i;
+
+    for (i = 0; i < n; ++i) {
+        a[i] = tensor_rng_double(rng) < p ? 1.0 : 0.0;
+    }
+}
+
+/**
+ * Fill an array with category offsets drawn by searching a cumulative distribution of k
+ * categories for a uniform draw.
+ *
+ * @param rng
+ * @param a
+ * @param n
+ * @param cdf
+ * @param k
+ */
+static void tensor_fill_categorical(tensor_rng * rng, double * a, size_t n, const double * cdf, size_t k)
+{
+    size_t i, lo, hi, mid;
+
+    for (i = 0; i < n; ++i) {
+        double u = tensor_rng_double(rng);
+
+        lo = 0;
+        hi = k - 1;
+
+        while (lo < hi) {
+            mid = lo + (hi - lo) / 2;
+
+            if (u < cdf[mid]) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+
+        a[i] = (double) lo;
+    }
+}
+
+/**
+ * Draw a Poisson distributed count by multiplying uniforms until their product falls below
+ * e^-lambda. Takes O(lambda) draws so it is only used for small lambda.
+ *
+ * @param rng
+ * @param l
+ * @return double
+ */
+static double tensor_poisson_knuth(tensor_rng * rng, double l)
+{
+    double k = 0.0;
+    double p = tensor_rng_double(rng);
+
+    while (p > l) {
+        k += 1.0;
+
+        p *= tensor_rng_double(rng);
+    }
+
+    return k;
+}
+
+/**
+ * Return the natural log of k factorial from a table for small k and from Stirling's series
+ * otherwise. Unlike lgamma() it does not write the global signgam so it is safe to call from the
+ * worker threads.
+ *
+ * @param k
+ * @return double
+ */
+static double tensor_log_factorial(double k)
+{
+    static const double table[] = {
+        0.0, 0.0, 0.69314718055994495, 1.7917594692280554,
+        3.1780538303479449, 4.7874917427820467, 6.5792512120101021, 8.5251613610654147,
+        10.604602902745249, 12.801827480081467, 15.104412573075514, 17.502307845873887,
+        19.987214495661885, 22.552163853123421, 25.191221182738683, 27.89927138384089,
+    };
+
+    double k2;
+
+    if (k < 16.0) {
+        return table[(size_t) k];
+    }
+
+    k2 = k * k;
+
+    return (k + 0.5) * log(k) - k + 0.91893853320467274
+        + (1.0 / 12.0 - (1.0 / 360.0 - 1.0 / (1260.0 * k2)) / k2) / k;
+}
+
+/**
+ * Draw a Poisson distributed count with the transformed rejection method with squeeze (PTRS) of
+ * Hormann, which accepts in about 1.1 tries on average regardless of lambda.
+ *
+ * @param rng
+ * @param lambda
+ * @return double
+ */
+static double tensor_poisson_ptrs(tensor_rng * rng, double lambda)
+{
+    double u, v, us, k;
+
+    double slam = sqrt(lambda);
+    double loglam = log(lambda);
+    double b = 0.931 + 2.53 * slam;
+    double a = -0.059 + 0.02483 * b;
+    double invalpha = 1.1239 + 1.1328 / (b - 3.4);
+    double vr = 0.9277 - 3.6224 / (b - 2.0);
+
+    while (1) {
+        u = tensor_rng_double(rng) - 0.5;
+        v = tensor_rng_double(rng);
+
+        us = 0.5 - fabs(u);
+        k = floor((2.0 * a / us + b) * u + lambda + 0.43);
+
+        if (us >= 0.07 && v <= vr) {
+            return k;
+        }
+
+        if (k < 0.0 || (us < 0.013 && v > us)) {
+            continue;
+        }
+
+        if (log(v) + log(invalpha) - log(a / (us * us) + b) <= -lambda + k * loglam - tensor_log_factorial(k)) {
+            return k;
+        }
+    }
+}
+
+/**
+ * Fill an array with Poisson distributed counts with rate lambda.
+ *
+ * @param rng
+ * @param a
+ * @param n
+ * @param lambda
+ */
+void tensor_fill_poisson(tensor_rng * rng, double * a, size_t n, double lambda)
+{
+    size_t i;
+
+    if (lambda <= 0.0) {
+        memset(a, 0, n * sizeof(double));
+
+        return;
+    }
+
+    if (lambda >= TENSOR_PTRS_THRESHOLD) {
+        for (i = 0; i < n; ++i) {
+            a[i] = tensor_poisson_ptrs(rng, lambda);
+        }
+
+        return;
+    }
+
+    double l = exp(-lambda);
+
+    for (i = 0; i < n; ++i) {
+        a[i] = tensor_poisson_knuth(rng, l);
+    }
+}
+
+typedef struct _tensor_random_fill_job {
+    double * a;
+    size_t n;
+    uint64_t key;
+    zend_long distribution;
+    double x;
+    double y;
+    const double * cdf;
+    size_t k;
+    zend_bool fast;
+} tensor_random_fill_job;
+
+/**
+ * Fill blocks start through end of the job. Every block has its own generator seeded from the key
+ * of the job and the index of the block.
+ *
+ * @param context
+ * @param start
+ * @param end
+ */
+static void tensor_random_fill_task(void * context, size_t start, size_t end)
+{
+    size_t b;
+    tensor_rng rng;
+
+    tensor_random_fill_job * job = context;
+
+    for (b = start; b < end; ++b) {
+        uint64_t seed = job->key ^ (b * 0xd1b54a32d192ed03ULL);
+
+        tensor_rng_seed(&rng, tensor_splitmix64(&seed));
+
+        double * a = job->a + b * TENSOR_RANDOM_BLOCK;
+
+        size_t len = MIN(TENSOR_RANDOM_BLOCK, job->n - b * TENSOR_RANDOM_BLOCK);
+
+        switch (job->distribution) {
+            case TENSOR_DISTRIBUTION_UNIFORM:
+                tensor_fill_uniform(&rng, a, len, job->x, job->y);
+                break;
+
+            case TENSOR_DISTRIBUTION_GAUSSIAN:
+                tensor_fill_gaussian_tiles(&rng, a, len, job->x, job->y, job->fast);
+                break;
+
+            case TENSOR_DISTRIBUTION_POISSON:
+                tensor_fill_poisson(&rng, a, len, job->x);
+                break;
+
+            case TENSOR_DISTRIBUTION_TRUNCATED_NORMAL:
+                tensor_fill_truncated_gaussian(&rng, a, len, job->x, job->y, job->fast);
+                break;
+
+            case TENSOR_DISTRIBUTION_BERNOULLI:
+                tensor_fill_bernoulli(&rng, a, len, job->x);
+                break;
+
+            case TENSOR_DISTRIBUTION_CATEGORICAL:
+                tensor_fill_categorical(&rng, a, len, job->cdf, job->k);
+                break;
+        }
+    }
+}
+
+/**
+ * Return the generator held by a random state object, or the generator of the current thread if
+ * none is given.
+ *
+ * @param generator
+ * @return tensor_rng
+ */
+static tensor_rng * tensor_random_generator(zval * generator)
+{
+    if (generator && Z_TYPE_P(generator) == IS_OBJECT) {
+        return &tensor_random_state_from_object(Z_OBJ_P(generator))->rng;
+    }
+
+    return tensor_rng_default();
+}
+
+/**
+ * Allocate an m x n buffer and fill it according to the job. A single key is drawn from the
+ * generator and the buffer is split into fixed blocks that are each seeded from the key and their
+ * index, so the blocks can be filled on any number of threads and the result is identical to
+ * filling them one after another.
+ *
+ * @param return_value
+ * @param m
+ * @param n
+ * @param generator
+ * @param job
+ */
+static void tensor_random_run(zval * return_value, zend_long m, zend_long n, zval * generator, tensor_random_fill_job * job)
+{
+    tensor_buffer * bb = tensor_buffer_alloc(return_value, m, n);
+
+    job->a = bb->data;
+    job->n = m * n;
+    job->key = tensor_rng_next(tensor_random_generator(generator));
+    job->fast = tensor_fast_math;
+
+    size_t blocks = (job->n + TENSOR_RANDOM_BLOCK - 1) / TENSOR_RANDOM_BLOCK;
+
+    tensor_parallel_for(blocks, MAX(1, tensor_grain_size / TENSOR_RANDOM_BLOCK), tensor_random_fill_task, job);
+}
+
+/**
+ * Fill an m x n buffer with draws from a distribution with parameters x and y.
+ *
+ * @param return_value
+ * @param m
+ * @param n
+ * @param generator
+ * @param distribution
+ * @param x
+ * @param y
+ */
+void tensor_random_fill(zval * return_value, zend_long m, zend_long n, zval * generator, zend_long distribution, double x, double y)
+{
+    tensor_random_fill_job job = { .distribution = distribution, .x = x, .y = y };
+
+    tensor_random_run(return_value, m, n, generator, &job);
+}
+
+/**
+ * Return an m x n buffer of random doubles between 0 and 1.
+ *
+ * @param return_value
+ * @param m
+ * @param n
+ * @param generator
+ */
+void tensor_rand(zval * return_value, zval * m, zval * n, zval * generator)
+{
+    tensor_random_fill(return_value, zephir_get_intval(m), zephir_get_intval(n), generator, TENSOR_DISTRIBUTION_UNIFORM, 0.0, 1.0);
+}
+
+/**
+ * Return an m x n buffer of standard normally distributed doubles.
+ *
+ * @param return_value
+ * @param m
+ * @param n
+ * @param generator
+ */
+void tensor_gaussian(zval * return_value, zval * m, zval * n, zval * generator)
+{
+    tensor_random_fill(return_value, zephir_get_intval(m), zephir_get_intval(n), generator, TENSOR_DISTRIBUTION_GAUSSIAN, 0.0, 1.0);
+}
+
+/**
+ * Return an m x n buffer of Poisson distributed counts with rate lambda.
+ *
+ * @param return_value
+ * @param m
+ * @param n
+ * @param lambda
+ * @param generator
+ */
+void tensor_poisson(zval * return_value, zval * m, zval * n, zval * lambda, zval * generator)
+{
+    tensor_random_fill(return_value, zephir_get_intval(m), zephir_get_intval(n), generator, TENSOR_DISTRIBUTION_POISSON, zephir_get_doubleval(lambda), 0.0);
+}
+
+/**
+ * Return an m x n buffer of random doubles between -1 and 1.
+ *
+ * @param return_value
+ * @param m
+ * @param n
+ * @param generator
+ */
+void tensor_uniform(zval * return_value, zval * m, zval * n, zval * generator)
+{
+    tensor_random_fill(return_value, zephir_get_intval(m), zephir_get_intval(n), generator, TENSOR_DISTRIBUTION_UNIFORM, -1.0, 1.0);
+}
+
+/**
+ * Return an m x n buffer of doubles drawn uniformly from [lower, upper).
+ *
+ * @param return_value
+ * @param m
+ * @param n
+ * @param lower
+ * @param upper
+ * @param generator
+ */
+void tensor_random_uniform(zval * return_value, zval * m, zval * n, zval * lower, zval * upper, zval * generator)
+{
+    tensor_random_fill(return_value, zephir_get_intval(m), zephir_get_intval(n), generator, TENSOR_DISTRIBUTION_UNIFORM, zephir_get_doubleval(lower), zephir_get_doubleval(upper));
+}
+
+/**
+ * Return an m x n buffer of normally distributed doubles with the given mean and standard
+ * deviation.
+ *
+ * @param return_value
+ * @param m
+ * @param n
+ * @param mean
+ * @param std
+ * @param generator
+ */
+void tensor_random_normal(zval * return_value, zval * m, zval * n, zval * mean, zval * std, zval * generator)
+{
+    tensor_random_fill(return_value, zephir_get_intval(m), zephir_get_intval(n), generator, TENSOR_DISTRIBUTION_GAUSSIAN, zephir_get_doubleval(mean), zephir_get_doubleval(std));
+}
+
+/**
+ * Return an m x n buffer of normally distributed doubles truncated to within two standard
+ * deviations of the mean.
+ *
+ * @param return_value
+ * @param m
+ * @param n
+ * @param mean
+ * @param std
+ * @param generator
+ */
+void tensor_truncated_normal(zval * return_value, zval * m, zval * n, zval * mean, zval * std, zval * generator)
+{
+    tensor_random_fill(return_value, zephir_get_intval(m), zephir_get_intval(n), generator, TENSOR_DISTRIBUTION_TRUNCATED_NORMAL, zephir_get_doubleval(mean), zephir_get_doubleval(std));
+}
+
+/**
+ * Return an m x n mask of ones with probability p and zeros otherwise.
+ *
+ * @param return_value
+ * @param m
+ * @param n
+ * @param p
+ * @param generator
+ */
+void tensor_bernoulli(zval * return_value, zval * m, zval * n, zval * p, zval * generator)
+{
+    tensor_random_fill(return_value, zephir_get_intval(m), zephir_get_intval(n), generator, TENSOR_DISTRIBUTION_BERNOULLI, zephir_get_doubleval(p), 0.0);
+}
+
+/**
+ * Return a 1 x n buffer of category offsets drawn with the unnormalized probabilities held by
+ * buffer P.
+ *
+ * @param return_value
+ * @param n
+ * @param p
+ * @param generator
+ */
+void tensor_categorical(zval * return_value, zval * n, zval * p, zval * generator)
+{
+    size_t i;
+
+    tensor_buffer * bp = Z_TENSOR_BUFFER_P(p);
+
+    size_t k = bp->m * bp->n;
+
+    double * cdf = safe_emalloc(MAX(k, 1), sizeof(double), 0);
+
+    double total = 0.0;
+
+    for (i = 0; i < k; ++i) {
+        total += bp->data[i];
+
+        cdf[i] = total;
+    }
+
+    for (i = 0; i < k; ++i) {
+        cdf[i] /= total;
+    }
+
+    tensor_random_fill_job job = { .distribution = TENSOR_DISTRIBUTION_CATEGORICAL, .cdf = cdf, .k = k };
+
+    tensor_random_run(return_value, 1, zephir_get_intval(n), generator, &job);
+
+    efree(cdf);
+}
+
+/**
+ * Allocate a random state object for the class entry.
+ *
+ * @param ce
+ * @return zend_object
+ */
+static zend_object * tensor_random_state_create(zend_class_entry * ce)
+{
+    tensor_random_state * state = zend_object_alloc(sizeof(tensor_random_state), ce);
+
+    memset(&state->rng, 0, sizeof(tensor_rng));
+
+    zend_object_std_init(&state->std, ce);
+    object_properties_init(&state->std, ce);
+
+    state->std.handlers = &tensor_random_state_handlers;
+
+    return &state->std;
+}
+
+/**
+ * Copy a random state object so that the copy continues the same sequence independently.
+ *
+ * @param object
+ * @return zend_object
+ */
+static zend_object * tensor_random_state_clone(zend_object * object)
+{
+    tensor_random_state * state = tensor_random_state_from_object(object);
+
+    tensor_random_state * copy = tensor_random_state_from_object(tensor_random_state_create(object->ce));
+
+    copy->rng = state->rng;
+
+    zend_objects_clone_members(&copy->std, object);
+
+    return &copy->std;
+}
+
+/**
+ * Register the random state class with the engine. Called once at module startup.
+ */
+void tensor_random_init()
+{
+    zend_class_entry ce;
+
+    INIT_NS_CLASS_ENTRY(ce, "Tensor", "RandomState", NULL);
+
+    tensor_random_state_ce = zend_register_internal_class(&ce);
+
+    tensor_random_state_ce->ce_flags |= ZEND_ACC_FINAL;
+    tensor_random_state_ce->create_object = tensor_random_state_create;
+
+#ifdef ZEND_ACC_NOT_SERIALIZABLE
+    tensor_random_state_ce->ce_flags |= ZEND_ACC_NOT_SERIALIZABLE;
+#endif
+
+    memcpy(&tensor_random_state_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
+
+    tensor_random_state_handlers.offset = XtOffsetOf(tensor_random_state, std);
+    tensor_random_state_handlers.clone_obj = tensor_random_state_clone;
+}
+
+/**
+ * Return a new random state seeded with the given seed.
+ *
+ * @param return_value
+ * @param seed
+ */
+void tensor_random_seed(zval * return_value, zval * seed)
+{
+    object_init_ex(return_value, tensor_random_state_ce);
+
+    tensor_random_state * state = tensor_random_state_from_object(Z_OBJ_P(return_value));
+
+    tensor_rng_seed(&state->rng, (uint64_t) zephir_get_intval(seed));
+}
+
+/**
+ * Advance a random state by 2^128 draws in place.
+ *
+ * @param return_value
+ * @param state
+ */
+void tensor_random_jump(zval * return_value, zval * state)
+{
+    tensor_rng_jump(&tensor_random_state_from_object(Z_OBJ_P(state))->rng);
+
+    RETURN_TRUE;
+}
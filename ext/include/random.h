@@ -0,0 +1,65 @@
+#ifndef TENSOR_RANDOM_H
+#define TENSOR_RANDOM_H
+
+#include <stdint.h>
+#include <Zend/zend.h>
+
+#define TENSOR_RANDOM_TILE 256
+#define TENSOR_RANDOM_BLOCK 4096
+#define TENSOR_PTRS_THRESHOLD 10.0
+#define TENSOR_TRUNCATION 2.0
+
+enum tensor_distribution {
+    TENSOR_DISTRIBUTION_UNIFORM,
+    TENSOR_DISTRIBUTION_GAUSSIAN,
+    TENSOR_DISTRIBUTION_POISSON,
+    TENSOR_DISTRIBUTION_TRUNCATED_NORMAL,
+    TENSOR_DISTRIBUTION_BERNOULLI,
+    TENSOR_DISTRIBUTION_CATEGORICAL
+};
+
+typedef struct _tensor_rng {
+    uint64_t s[4];
+} tensor_rng;
+
+typedef struct _tensor_random_state {
+    tensor_rng rng;
+    zend_object std;
+} tensor_random_state;
+
+extern zend_class_entry * tensor_random_state_ce;
+
+static inline tensor_random_state * tensor_random_state_from_object(zend_object * object)
+{
+    return (tensor_random_state *) ((char *) object - XtOffsetOf(tensor_random_state, std));
+}
+
+void tensor_random_init();
+
+tensor_rng * tensor_rng_default();
+
+void tensor_rng_seed(tensor_rng * rng, uint64_t seed);
+uint64_t tensor_rng_next(tensor_rng * rng);
+double tensor_rng_double(tensor_rng * rng);
+void tensor_rng_jump(tensor_rng * rng);
+
+void tensor_fill_uniform(tensor_rng * rng, double * a, size_t n, double lower, double upper);
+void tensor_fill_gaussian(tensor_rng * rng, double * a, size_t n, double mean, double std);
+void tensor_fill_poisson(tensor_rng * rng, double * a, size_t n, double lambda);
+
+void tensor_random_fill(zval * return_value, zend_long m, zend_long n, zval * generator, zend_long distribution, double x, double y);
+
+void tensor_rand(zval * return_value, zval * m, zval * n, zval * generator);
+void tensor_gaussian(zval * return_value, zval * m, zval * n, zval * generator);
+void tensor_poisson(zval * return_value, zval * m, zval * n, zval * lambda, zval * generator);
+void tensor_uniform(zval * return_value, zval * m, zval * n, zval * generator);
+void tensor_random_uniform(zval * return_value, zval * m, zval * n, zval * lower, zval * upper, zval * generator);
+void tensor_random_normal(zval * return_value, zval * m, zval * n, zval * mean, zval * std, zval * generator);
+void tensor_truncated_normal(zval * return_value, zval * m, zval * n, zval * mean, zval * std, zval * generator);
+void tensor_bernoulli(zval * return_value, zval * m, zval * n, zval * p, zval * generator);
+void tensor_categorical(zval * return_value, zval * n, zval * p, zval * generator);
+
+void tensor_random_seed(zval * return_value, zval * seed);
+void tensor_random_jump(zval * return_value, zval * state);
+
+#endif
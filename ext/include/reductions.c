@@ -0,0 +1,512 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <php.h>
+#include <math.h>
+#include "kernel/operators.h"
+#include "buffer.h"
+#include "parallel.h"
+#include "reductions.h"
+
+typedef double (*tensor_reduce_row)(const double * a, size_t n);
+typedef void (*tensor_reduce_column)(const double * a, zend_long m, zend_long n, zend_long stride, double * b);
+typedef zend_long (*tensor_reduce_index)(const double * a, size_t n, size_t stride);
+
+/**
+ * Sum an array of doubles by recursively splitting it in half. Blocks at the bottom of the
+ * recursion are summed with eight independent accumulators so the compiler can keep them in
+ * vector registers. The rounding error grows with O(log n) instead of O(n).
+ *
+ * @param a
+ * @param n
+ * @return double
+ */
+double tensor_pairwise_sum(const double * a, size_t n)
+{
+    size_t i, j;
+
+    if (n < 8) {
+        double sigma = 0.0;
+
+        for (i = 0; i < n; ++i) {
+            sigma += a[i];
+        }
+
+        return sigma;
+    }
+
+    if (n <= TENSOR_PAIRWISE_BLOCK) {
+        double r[8];
+
+        for (j = 0; j < 8; ++j) {
+            r[j] = a[j];
+        }
+
+        for (i = 8; i + 8 <= n; i += 8) {
+            for (j = 0; j < 8; ++j) {
+                r[j] += a[i + j];
+            }
+        }
+
+        double sigma = ((r[0] + r[1]) + (r[2] + r[3])) + ((r[4] + r[5]) + (r[6] + r[7]));
+
+        for (; i < n; ++i) {
+            sigma += a[i];
+        }
+
+        return sigma;
+    }
+
+    size_t half = n / 2;
+
+    half -= half % 8;
+
+    return tensor_pairwise_sum(a, half) + tensor_pairwise_sum(a + half, n - half);
+}
+
+static double tensor_row_product(const double * a, size_t n)
+{
+    size_t i;
+
+    double pi = 1.0;
+
+    for (i = 0; i < n; ++i) {
+        pi *= a[i];
+    }
+
+    return pi;
+}
+
+static double tensor_row_min(const double * a, size_t n)
+{
+    size_t i;
+
+    double min = n > 0 ? a[0] : NAN;
+
+    for (i = 1; i < n; ++i) {
+        min = a[i] < min ? a[i] : min;
+    }
+
+    return min;
+}
+
+static double tensor_row_max(const double * a, size_t n)
+{
+    size_t i;
+
+    double max = n > 0 ? a[0] : NAN;
+
+    for (i = 1; i < n; ++i) {
+        max = a[i] > max ? a[i] : max;
+    }
+
+    return max;
+}
+
+/**
+ * Sum n columns of an m row matrix whose rows are stride elements apart with Kahan compensated
+ * summation. The running sums and compensations are kept per column so the inner loop runs over
+ * contiguous memory.
+ *
+ * @param a
+ * @param m
+ * @param n
+ * @param stride
+ * @param b
+ */
+static void tensor_column_sum(const double * a, zend_long m, zend_long n, zend_long stride, double * b)
+{
+    zend_long i, j;
+
+    double * c = calloc(MAX(n, 1), sizeof(double));
+
+    memset(b, 0, n * sizeof(double));
+
+    for (i = 0; i < m; ++i) {
+        const double * row = a + i * stride;
+
+        for (j = 0; j < n; ++j) {
+            double y = row[j] - c[j];
+            double t = b[j] + y;
+
+            c[j] = (t - b[j]) - y;
+            b[j] = t;
+        }
+    }
+
+    free(c);
+}
+
+static void tensor_column_product(const double * a, zend_long m, zend_long n, zend_long stride, double * b)
+{
+    zend_long i, j;
+
+    for (j = 0; j < n; ++j) {
+        b[j] = 1.0;
+    }
+
+    for (i = 0; i < m; ++i) {
+        const double * row = a + i * stride;
+
+        for (j = 0; j < n; ++j) {
+            b[j] *= row[j];
+        }
+    }
+}
+
+static void tensor_column_min(const double * a, zend_long m, zend_long n, zend_long stride, double * b)
+{
+    zend_long i, j;
+
+    for (j = 0; j < n; ++j) {
+        b[j] = m > 0 ? a[j] : NAN;
+    }
+
+    for (i = 1; i < m; ++i) {
+        const double * row = a + i * stride;
+
+        for (j = 0; j < n; ++j) {
+            b[j] = row[j] < b[j] ? row[j] : b[j];
+        }
+    }
+}
+
+static void tensor_column_max(const double * a, zend_long m, zend_long n, zend_long stride, double * b)
+{
+    zend_long i, j;
+
+    for (j = 0; j < n; ++j) {
+        b[j] = m > 0 ? a[j] : NAN;
+    }
+
+    for (i = 1; i < m; ++i) {
+        const double * row = a + i * stride;
+
+        for (j = 0; j < n; ++j) {
+            b[j] = row[j] > b[j] ? row[j] : b[j];
+        }
+    }
+}
+
+static zend_long tensor_index_min(const double * a, size_t n, size_t stride)
+{
+    size_t i;
+
+    zend_long index = 0;
+
+    for (i = 1; i < n; ++i) {
+        if (a[i * stride] < a[index * stride]) {
+            index = i;
+        }
+    }
+
+    return index;
+}
+
+static zend_long tensor_index_max(const double * a, size_t n, size_t stride)
+{
+    size_t i;
+
+    zend_long index = 0;
+
+    for (i = 1; i < n; ++i) {
+        if (a[i * stride] > a[index * stride]) {
+            index = i;
+        }
+    }
+
+    return index;
+}
+
+typedef struct _tensor_reduce_job {
+    const double * a;
+    double * b;
+    zend_long m;
+    zend_long n;
+    tensor_reduce_row row_op;
+    tensor_reduce_column column_op;
+} tensor_reduce_job;
+
+static void tensor_reduce_rows_task(void * context, size_t start, size_t end)
+{
+    size_t i;
+
+    tensor_reduce_job * job = context;
+
+    for (i = start; i < end; ++i) {
+        job->b[i] = job->row_op(job->a + i * job->n, job->n);
+    }
+}
+
+static void tensor_reduce_columns_task(void * context, size_t start, size_t end)
+{
+    tensor_reduce_job * job = context;
+
+    job->column_op(job->a + start, job->m, end - start, job->n, job->b + start);
+}
+
+/**
+ * Reduce buffer A along the given axis and return the result in a new 1 x k buffer. Axis 1
+ * reduces each row and axis 0 reduces each column. Large matrices are split into bands of rows
+ * or columns across the thread pool.
+ *
+ * @param return_value
+ * @param a
+ * @param axis
+ * @param row_op
+ * @param column_op
+ * @return tensor_buffer
+ */
+static tensor_buffer * tensor_reduce(zval * return_value, zval * a, zval * axis, tensor_reduce_row row_op, tensor_reduce_column column_op)
+{
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    zend_long m = ba->m;
+    zend_long n = ba->n;
+
+    tensor_reduce_job job = { .a = ba->data, .m = m, .n = n, .row_op = row_op, .column_op = column_op };
+
+    if (zephir_get_intval(axis) == 0) {
+        tensor_buffer * bb = tensor_buffer_alloc(return_value, n > 0 ? 1 : 0, n);
+
+        job.b = bb->data;
+
+        tensor_parallel_for(n, MAX(1, tensor_grain_size / MAX(m, 1)), tensor_reduce_columns_task, &job);
+
+        return bb;
+    }
+
+    tensor_buffer * bb = tensor_buffer_alloc(return_value, m > 0 ? 1 : 0, m);
+
+    job.b = bb->data;
+
+    tensor_parallel_for(m, MAX(1, tensor_grain_size / MAX(n, 1)), tensor_reduce_rows_task, &job);
+
+    return bb;
+}
+
+/**
+ * Return the index of the extreme value of each row or column of buffer A in an array.
+ *
+ * @param return_value
+ * @param a
+ * @param axis
+ * @param op
+ */
+static void tensor_reduce_indices(zval * return_value, zval * a, zval * axis, tensor_reduce_index op)
+{
+    zend_long i;
+    zval indices;
+
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    zend_long m = ba->m;
+    zend_long n = ba->n;
+
+    if (zephir_get_intval(axis) == 0) {
+        array_init_size(&indices, n);
+
+        for (i = 0; i < n; ++i) {
+            add_next_index_long(&indices, op(ba->data + i, m, n));
+        }
+    } else {
+        array_init_size(&indices, m);
+
+        for (i = 0; i < m; ++i) {
+            add_next_index_long(&indices, op(ba->data + i * n, n, 1));
+        }
+    }
+
+    RETVAL_ARR(Z_ARR(indices));
+}
+
+void tensor_sum(zval * return_value, zval * a, zval * axis)
+{
+    tensor_reduce(return_value, a, axis, tensor_pairwise_sum, tensor_column_sum);
+}
+
+void tensor_product(zval * return_value, zval * a, zval * axis)
+{
+    tensor_reduce(return_value, a, axis, tensor_row_product, tensor_column_product);
+}
+
+void tensor_min(zval * return_value, zval * a, zval * axis)
+{
+    tensor_reduce(return_value, a, axis, tensor_row_min, tensor_column_min);
+}
+
+void tensor_max(zval * return_value, zval * a, zval * axis)
+{
+    tensor_reduce(return_value, a, axis, tensor_row_max, tensor_column_max);
+}
+
+void tensor_mean(zval * return_value, zval * a, zval * axis)
+{
+    zend_long i;
+
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    tensor_buffer * bb = tensor_reduce(return_value, a, axis, tensor_pairwise_sum, tensor_column_sum);
+
+    double count = zephir_get_intval(axis) == 0 ? ba->m : ba->n;
+
+    for (i = 0; i < bb->n; ++i) {
+        bb->data[i] /= count;
+    }
+}
+
+void tensor_argmin(zval * return_value, zval * a, zval * axis)
+{
+    tensor_reduce_indices(return_value, a, axis, tensor_index_min);
+}
+
+void tensor_argmax(zval * return_value, zval * a, zval * axis)
+{
+    tensor_reduce_indices(return_value, a, axis, tensor_index_max);
+}
+
+void tensor_vector_sum(zval * return_value, zval * a)
+{
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    RETURN_DOUBLE(tensor_pairwise_sum(ba->data, ba->m * ba->n));
+}
+
+void tensor_vector_product(zval * return_value, zval * a)
+{
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    RETURN_DOUBLE(tensor_row_product(ba->data, ba->m * ba->n));
+}
+
+void tensor_vector_min(zval * return_value, zval * a)
+{
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    RETURN_DOUBLE(tensor_row_min(ba->data, ba->m * ba->n));
+}
+
+void tensor_vector_max(zval * return_value, zval * a)
+{
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    RETURN_DOUBLE(tensor_row_max(ba->data, ba->m * ba->n));
+}
+
+void tensor_vector_argmin(zval * return_value, zval * a)
+{
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    RETURN_LONG(tensor_index_min(ba->data, ba->m * ba->n, 1));
+}
+
+void tensor_vector_argmax(zval * return_value, zval * a)
+{
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    RETURN_LONG(tensor_index_max(ba->data, ba->m * ba->n, 1));
+}
+
+/**
+ * Fold the statistics of a second set of nb samples with column means meanB and sums of squared
+ * deviations m2B into the statistics of the first set of na samples using Chan's parallel formula.
+ *
+ * @param mean
+ * @param m2
+ * @param na
+ * @param meanB
+ * @param m2B
+ * @param nb
+ * @param n
+ */
+static void tensor_running_stats_combine(double * mean, double * m2, zend_long na, const double * meanB, const double * m2B, zend_long nb, zend_long n)
+{
+    zend_long j;
+
+    double total = (double) (na + nb);
+
+    if (nb == 0) {
+        return;
+    }
+
+    double weight = nb / total;
+    double scale = ((double) na * nb) / total;
+
+    for (j = 0; j < n; ++j) {
+        double delta = meanB[j] - mean[j];
+
+        mean[j] += delta * weight;
+        m2[j] += m2B[j] + delta * delta * scale;
+    }
+}
+
+/**
+ * Update the running column statistics held in the 2 x n state buffer, whose rows are the means and
+ * the sums of squared deviations of count samples, with the rows of matrix A. The statistics of the
+ * chunk are accumulated with Welford's method in a single pass whose inner loop runs across the
+ * columns so it vectorizes, and then merged into the state.
+ *
+ * @param return_value
+ * @param state
+ * @param count
+ * @param a
+ */
+void tensor_running_stats_update(zval * return_value, zval * state, zval * count, zval * a)
+{
+    zend_long i, j;
+
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    zend_long m = ba->m;
+    zend_long n = ba->n;
+
+    tensor_buffer * bs = tensor_buffer_separate(return_value, state);
+
+    if (m == 0 || n == 0) {
+        return;
+    }
+
+    double * chunk = ecalloc(2 * n, sizeof(double));
+
+    double * mean = chunk;
+    double * m2 = chunk + n;
+
+    for (i = 0; i < m; ++i) {
+        const double * row = ba->data + i * n;
+
+        double inverse = 1.0 / (i + 1);
+
+        for (j = 0; j < n; ++j) {
+            double delta = row[j] - mean[j];
+
+            mean[j] += delta * inverse;
+            m2[j] += delta * (row[j] - mean[j]);
+        }
+    }
+
+    tensor_running_stats_combine(bs->data, bs->data + n, zephir_get_intval(count), mean, m2, m, n);
+
+    efree(chunk);
+}
+
+/**
+ * Merge the running statistics of count B samples held in state buffer B into state buffer A of
+ * count A samples.
+ *
+ * @param return_value
+ * @param state
+ * @param count
+ * @param stateB
+ * @param countB
+ */
+void tensor_running_stats_merge(zval * return_value, zval * state, zval * count, zval * stateB, zval * countB)
+{
+    tensor_buffer * bb = Z_TENSOR_BUFFER_P(stateB);
+
+    zend_long n = bb->n;
+
+    tensor_buffer * bs = tensor_buffer_separate(return_value, state);
+
+    tensor_running_stats_combine(bs->data, bs->data + n, zephir_get_intval(count), bb->data, bb->data + n, zephir_get_intval(countB), n);
+}
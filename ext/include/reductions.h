@@ -0,0 +1,28 @@
+#ifndef TENSOR_REDUCTIONS_H
+#define TENSOR_REDUCTIONS_H
+
+#include <Zend/zend.h>
+
+#define TENSOR_PAIRWISE_BLOCK 128
+
+double tensor_pairwise_sum(const double * a, size_t n);
+
+void tensor_sum(zval * return_value, zval * a, zval * axis);
+void tensor_product(zval * return_value, zval * a, zval * axis);
+void tensor_min(zval * return_value, zval * a, zval * axis);
+void tensor_max(zval * return_value, zval * a, zval * axis);
+void tensor_mean(zval * return_value, zval * a, zval * axis);
+void tensor_argmin(zval * return_value, zval * a, zval * axis);
+void tensor_argmax(zval * return_value, zval * a, zval * axis);
+
+void tensor_vector_sum(zval * return_value, zval * a);
+void tensor_vector_product(zval * return_value, zval * a);
+void tensor_vector_min(zval * return_value, zval * a);
+void tensor_vector_max(zval * return_value, zval * a);
+void tensor_vector_argmin(zval * return_value, zval * a);
+void tensor_vector_argmax(zval * return_value, zval * a);
+
+void tensor_running_stats_update(zval * return_value, zval * state, zval * count, zval * a);
+void tensor_running_stats_merge(zval * return_value, zval * state, zval * count, zval * stateB, zval * countB);
+
+#endif
@@ -0,0 +1,523 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <php.h>
+#include <math.h>
+#include "kernel/operators.h"
+#include "buffer.h"
+#include "parallel.h"
+#include "selection.h"
+
+/**
+ * Does entry x rank before entry y? Ties are broken by the lower index so that the selection is
+ * deterministic.
+ *
+ * @param x
+ * @param y
+ * @param largest
+ * @return bool
+ */
+static zend_always_inline zend_bool tensor_ranks_before(const tensor_ranked * x, const tensor_ranked * y, zend_bool largest)
+{
+    if (x->value != y->value) {
+        return largest ? x->value > y->value : x->value < y->value;
+    }
+
+    return x->index < y->index;
+}
+
+/**
+ * Restore the heap property below node i of a heap of n entries whose root is the entry that
+ * ranks last.
+ *
+ * @param heap
+ * @param n
+ * @param i
+ * @param largest
+ */
+static void tensor_heap_sift_down(tensor_ranked * heap, size_t n, size_t i, zend_bool largest)
+{
+    size_t worst, left, right;
+    tensor_ranked temp;
+
+    while (1) {
+        worst = i;
+        left = 2 * i + 1;
+        right = left + 1;
+
+        if (left < n && tensor_ranks_before(&heap[worst], &heap[left], largest)) {
+            worst = left;
+        }
+
+        if (right < n && tensor_ranks_before(&heap[worst], &heap[right], largest)) {
+            worst = right;
+        }
+
+        if (worst == i) {
+            break;
+        }
+
+        temp = heap[i];
+        heap[i] = heap[worst];
+        heap[worst] = temp;
+
+        i = worst;
+    }
+}
+
+/**
+ * Select the k entries of an array of n doubles that rank first and write them to the heap in rank
+ * order. A bounded heap of size k is kept so the row is scanned once in O(n log k) time.
+ *
+ * @param a
+ * @param n
+ * @param heap
+ * @param k
+ * @param largest
+ */
+static void tensor_select_top_k(const double * a, size_t n, tensor_ranked * heap, size_t k, zend_bool largest)
+{
+    size_t i;
+    tensor_ranked temp;
+
+    for (i = 0; i < k; ++i) {
+        heap[i].value = a[i];
+        heap[i].index = i;
+    }
+
+    for (i = k / 2; i > 0; --i) {
+        tensor_heap_sift_down(heap, k, i - 1, largest);
+    }
+
+    for (i = k; i < n; ++i) {
+        temp.value = a[i];
+        temp.index = i;
+
+        if (tensor_ranks_before(&temp, &heap[0], largest)) {
+            heap[0] = temp;
+
+            tensor_heap_sift_down(heap, k, 0, largest);
+        }
+    }
+
+    for (i = k - 1; i > 0; --i) {
+        temp = heap[0];
+        heap[0] = heap[i];
+        heap[i] = temp;
+
+        tensor_heap_sift_down(heap, i, 0, largest);
+    }
+}
+
+/**
+ * Comparison function for sorting doubles in ascending order.
+ *
+ * @param a
+ * @param b
+ * @return int
+ */
+static int tensor_compare_doubles(const void * a, const void * b)
+{
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * Partially order the range [lo, hi) of array A so that the element at offset k is the one that would
+ * be there if the range were sorted, every element before it is no greater, and every element after it
+ * is no less. Quickselect with a median of three pivot runs in expected linear time and falls back to
+ * a full sort of the remaining range once the recursion depth budget is spent.
+ *
+ * @param a
+ * @param lo
+ * @param hi
+ * @param k
+ * @param depth
+ */
+static void tensor_nth_element(double * a, zend_long lo, zend_long hi, zend_long k, zend_long depth)
+{
+    zend_long i, j;
+    double pivot, x, y, z, temp;
+
+    while (hi - lo > TENSOR_SELECTION_CUTOFF) {
+        if (depth-- == 0) {
+            qsort(a + lo, hi - lo, sizeof(double), tensor_compare_doubles);
+
+            return;
+        }
+
+        x = a[lo];
+        y = a[lo + (hi - lo) / 2];
+        z = a[hi - 1];
+
+        pivot = x < y ? (y < z ? y : (x < z ? z : x)) : (x < z ? x : (y < z ? z : y));
+
+        i = lo;
+        j = hi - 1;
+
+        while (i <= j) {
+            while (a[i] < pivot) {
+                ++i;
+            }
+
+            while (a[j] > pivot) {
+                --j;
+            }
+
+            if (i <= j) {
+                temp = a[i];
+                a[i] = a[j];
+                a[j] = temp;
+
+                ++i;
+                --j;
+            }
+        }
+
+        if (k <= j) {
+            hi = j + 1;
+        } else if (k >= i) {
+            lo = i;
+        } else {
+            return;
+        }
+    }
+
+    for (i = lo + 1; i < hi; ++i) {
+        temp = a[i];
+
+        for (j = i - 1; j >= lo && a[j] > temp; --j) {
+            a[j + 1] = a[j];
+        }
+
+        a[j + 1] = temp;
+    }
+}
+
+/**
+ * Place every one of the nk sorted offsets in ks at its sorted position within the range [lo, hi)
+ * of array A. Each selection splits the range so later selections only partition the part of the
+ * array that can still contain their offset.
+ *
+ * @param a
+ * @param lo
+ * @param hi
+ * @param ks
+ * @param nk
+ * @param depth
+ */
+static void tensor_multiselect(double * a, zend_long lo, zend_long hi, const zend_long * ks, size_t nk, zend_long depth)
+{
+    size_t mid;
+
+    if (nk == 0 || hi - lo < 2) {
+        return;
+    }
+
+    mid = nk / 2;
+
+    tensor_nth_element(a, lo, hi, ks[mid], depth);
+
+    tensor_multiselect(a, lo, ks[mid], ks, mid, depth);
+    tensor_multiselect(a, ks[mid] + 1, hi, ks + mid + 1, nk - mid - 1, depth);
+}
+
+/**
+ * Comparison function for sorting offsets in ascending order.
+ *
+ * @param a
+ * @param b
+ * @return int
+ */
+static int tensor_compare_offsets(const void * a, const void * b)
+{
+    zend_long x = *(const zend_long *) a;
+    zend_long y = *(const zend_long *) b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * Compute the nq quantiles q of an array of n doubles using linear interpolation between the two
+ * closest ranks. The array is partitioned in place for all requested quantiles at once.
+ *
+ * @param a
+ * @param n
+ * @param q
+ * @param nq
+ * @param ks
+ * @param out
+ * @param stride
+ */
+static void tensor_row_quantiles(double * a, zend_long n, const double * q, size_t nq, zend_long * ks, double * out, zend_long stride)
+{
+    size_t i, nk = 0, unique = 0;
+    zend_long lo, depth = 0;
+    double position, t;
+
+    if (n == 0) {
+        for (i = 0; i < nq; ++i) {
+            out[i * stride] = NAN;
+        }
+
+        return;
+    }
+
+    for (lo = n; lo > 1; lo >>= 1) {
+        depth += 2;
+    }
+
+    for (i = 0; i < nq; ++i) {
+        position = q[i] * (n - 1);
+
+        lo = (zend_long) position;
+
+        ks[nk++] = lo;
+
+        if (lo + 1 < n) {
+            ks[nk++] = lo + 1;
+        }
+    }
+
+    qsort(ks, nk, sizeof(zend_long), tensor_compare_offsets);
+
+    for (i = 0; i < nk; ++i) {
+        if (unique == 0 || ks[i] != ks[unique - 1]) {
+            ks[unique++] = ks[i];
+        }
+    }
+
+    tensor_multiselect(a, 0, n, ks, unique, depth);
+
+    for (i = 0; i < nq; ++i) {
+        position = q[i] * (n - 1);
+
+        lo = (zend_long) position;
+
+        t = a[lo];
+
+        out[i * stride] = lo + 1 < n ? t + (position - lo) * (a[lo + 1] - t) : t;
+    }
+}
+
+/**
+ * Decode a list of quantiles into an array of doubles.
+ *
+ * @param qs
+ * @param nq
+ * @return double
+ */
+static double * tensor_quantiles_decode(zval * qs, size_t * nq)
+{
+    size_t i = 0;
+    zval * value;
+
+    zend_array * aq = Z_ARR_P(qs);
+
+    double * q = safe_emalloc(MAX(zend_array_count(aq), 1), sizeof(double), 0);
+
+    ZEND_HASH_FOREACH_VAL(aq, value) {
+        q[i++] = zephir_get_doubleval(value);
+    } ZEND_HASH_FOREACH_END();
+
+    *nq = i;
+
+    return q;
+}
+
+typedef struct _tensor_quantiles_job {
+    const double * a;
+    double * c;
+    const double * q;
+    size_t nq;
+    zend_long m;
+    zend_long n;
+} tensor_quantiles_job;
+
+/**
+ * Compute the quantiles of rows start through end. Runs on pool threads so the scratch space is
+ * allocated with malloc rather than the request allocator.
+ *
+ * @param context
+ * @param start
+ * @param end
+ */
+static void tensor_quantiles_task(void * context, size_t start, size_t end)
+{
+    size_t i;
+
+    tensor_quantiles_job * job = context;
+
+    double * row = malloc(MAX(job->n, 1) * sizeof(double));
+    zend_long * ks = malloc(MAX(2 * job->nq, 1) * sizeof(zend_long));
+
+    for (i = start; i < end; ++i) {
+        memcpy(row, job->a + i * job->n, job->n * sizeof(double));
+
+        tensor_row_quantiles(row, job->n, job->q, job->nq, ks, job->c + i, job->m);
+    }
+
+    free(row);
+    free(ks);
+}
+
+/**
+ * Return the quantiles q of each row of matrix A. Row j of the result holds the j'th quantile of
+ * every row of A so that a single quantile can be handed out as a column vector without copying.
+ * Rows are handed to the work-stealing scheduler since selection takes longer on some rows than
+ * others.
+ *
+ * @param return_value
+ * @param a
+ * @param qs
+ */
+void tensor_quantiles(zval * return_value, zval * a, zval * qs)
+{
+    size_t nq;
+
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    zend_long m = ba->m;
+    zend_long n = ba->n;
+
+    double * q = tensor_quantiles_decode(qs, &nq);
+
+    tensor_buffer * bc = tensor_buffer_alloc(return_value, nq, m);
+
+    tensor_quantiles_job job = { .a = ba->data, .c = bc->data, .q = q, .nq = nq, .m = m, .n = n };
+
+    tensor_parallel_rows(m, MAX(1, tensor_grain_size / MAX(n, 1)), tensor_quantiles_task, &job);
+
+    efree(q);
+}
+
+/**
+ * Return the quantiles q of vector A in an array.
+ *
+ * @param return_value
+ * @param a
+ * @param qs
+ */
+void tensor_vector_quantiles(zval * return_value, zval * a, zval * qs)
+{
+    size_t i, nq;
+
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    zend_long n = ba->m * ba->n;
+
+    double * q = tensor_quantiles_decode(qs, &nq);
+
+    double * row = safe_emalloc(MAX(n, 1), sizeof(double), 0);
+    double * out = safe_emalloc(MAX(nq, 1), sizeof(double), 0);
+    zend_long * ks = safe_emalloc(MAX(2 * nq, 1), sizeof(zend_long), 0);
+
+    memcpy(row, ba->data, n * sizeof(double));
+
+    tensor_row_quantiles(row, n, q, nq, ks, out, 1);
+
+    array_init_size(return_value, nq);
+
+    for (i = 0; i < nq; ++i) {
+        add_next_index_double(return_value, out[i]);
+    }
+
+    efree(row);
+    efree(out);
+    efree(ks);
+    efree(q);
+}
+
+typedef struct _tensor_top_k_job {
+    const double * a;
+    double * values;
+    zend_long * offsets;
+    zend_long n;
+    zend_long k;
+    zend_bool largest;
+} tensor_top_k_job;
+
+/**
+ * Select the top k values and offsets of rows start through end.
+ *
+ * @param context
+ * @param start
+ * @param end
+ */
+static void tensor_top_k_task(void * context, size_t start, size_t end)
+{
+    size_t i;
+    zend_long j;
+
+    tensor_top_k_job * job = context;
+
+    tensor_ranked * heap = malloc(MAX(job->k, 1) * sizeof(tensor_ranked));
+
+    for (i = start; i < end; ++i) {
+        tensor_select_top_k(job->a + i * job->n, job->n, heap, job->k, job->largest);
+
+        for (j = 0; j < job->k; ++j) {
+            job->values[i * job->k + j] = heap[j].value;
+            job->offsets[i * job->k + j] = heap[j].index;
+        }
+    }
+
+    free(heap);
+}
+
+/**
+ * Return the k largest or smallest values of each row of matrix A in rank order along with their
+ * column offsets in a tuple. Rows are selected on the work-stealing scheduler and the arrays of
+ * offsets are built afterwards on the calling thread.
+ *
+ * @param return_value
+ * @param a
+ * @param k
+ * @param largest
+ */
+void tensor_top_k(zval * return_value, zval * a, zval * k, zval * largest)
+{
+    zend_long i, j;
+    zval values, indices, rowIndices, tuple;
+
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    zend_long m = ba->m;
+    zend_long n = ba->n;
+    zend_long kk = zephir_get_intval(k);
+
+    tensor_buffer * bc = tensor_buffer_alloc(&values, m, kk);
+
+    zend_long * offsets = safe_emalloc(MAX(m * kk, 1), sizeof(zend_long), 0);
+
+    tensor_top_k_job job = {
+        .a = ba->data, .values = bc->data, .offsets = offsets,
+        .n = n, .k = kk, .largest = zephir_is_true(largest),
+    };
+
+    tensor_parallel_rows(m, MAX(1, tensor_grain_size / MAX(n, 1)), tensor_top_k_task, &job);
+
+    array_init_size(&indices, m);
+
+    for (i = 0; i < m; ++i) {
+        array_init_size(&rowIndices, kk);
+
+        for (j = 0; j < kk; ++j) {
+            add_next_index_long(&rowIndices, offsets[i * kk + j]);
+        }
+
+        add_next_index_zval(&indices, &rowIndices);
+    }
+
+    efree(offsets);
+
+    array_init_size(&tuple, 2);
+
+    add_next_index_zval(&tuple, &values);
+    add_next_index_zval(&tuple, &indices);
+
+    RETVAL_ARR(Z_ARR(tuple));
+}
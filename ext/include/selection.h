@@ -0,0 +1,17 @@
+#ifndef TENSOR_SELECTION_H
+#define TENSOR_SELECTION_H
+
+#include <Zend/zend.h>
+
+#define TENSOR_SELECTION_CUTOFF 16
+
+typedef struct _tensor_ranked {
+    double value;
+    zend_long index;
+} tensor_ranked;
+
+void tensor_quantiles(zval * return_value, zval * a, zval * qs);
+void tensor_vector_quantiles(zval * return_value, zval * a, zval * qs);
+void tensor_top_k(zval * return_value, zval * a, zval * k, zval * largest);
+
+#endif
@@ -3,8 +3,11 @@
 #endif
 
 #include <php.h>
-#include <cblas.h>
 #include "kernel/operators.h"
+#include "context.h"
+#include "functions.h"
+#include "parallel.h"
+#include "settings.h"
 
 /**
  * Sets the number of threads to use when parallel processesing.
@@ -14,9 +17,7 @@
  */
 void tensor_set_num_threads(zval * return_value, zval * threads)
 {
-    int n = zephir_get_intval(threads);
-    
-    openblas_set_num_threads(n);
+    tensor_context_set_threads(zephir_get_intval(threads));
 
     RETURN_TRUE;
 }
@@ -28,7 +29,97 @@ void tensor_set_num_threads(zval * return_value, zval * threads)
  */
 void tensor_get_num_threads(zval * return_value)
 {
-    long threads = openblas_get_num_threads();
+    RETURN_LONG(tensor_num_threads);
+}
+
+/**
+ * Switch between the fast vectorized approximations and libm for transcendental functions.
+ * 
+ * @param return_value
+ * @param enabled
+ */
+void tensor_set_fast_math(zval * return_value, zval * enabled)
+{
+    tensor_fast_math = zephir_is_true(enabled);
+
+    RETURN_TRUE;
+}
+
+/**
+ * Return whether the fast approximations are used for transcendental functions.
+ * 
+ * @param return_value
+ */
+void tensor_get_fast_math(zval * return_value)
+{
+    RETURN_BOOL(tensor_fast_math);
+}
+
+/**
+ * Set the minimum number of elements that a thread is handed when a kernel is split up.
+ * 
+ * @param return_value
+ * @param size
+ */
+void tensor_set_grain_size(zval * return_value, zval * size)
+{
+    tensor_grain_size = zephir_get_intval(size);
+
+    RETURN_TRUE;
+}
+
+/**
+ * Return the minimum number of elements that a thread is handed when a kernel is split up.
+ * 
+ * @param return_value
+ */
+void tensor_get_grain_size(zval * return_value)
+{
+    RETURN_LONG(tensor_grain_size);
+}
+
+/**
+ * Return the work done by each thread of the row scheduler since the counters were last reset.
+ * Utilization is the fraction of the scheduler's wall time that the thread spent running rows.
+ * The counters are a consistent snapshot of the process-wide totals.
+ * 
+ * @param return_value
+ */
+void tensor_get_utilization(zval * return_value)
+{
+    zend_long i, count;
+    double wall;
+    zval workers, worker;
+
+    tensor_worker_stats stats[TENSOR_MAX_THREADS];
+
+    count = tensor_parallel_stats(stats, &wall);
 
-    RETURN_LONG(threads);
+    array_init_size(&workers, count);
+
+    for (i = 0; i < count; ++i) {
+        array_init_size(&worker, 5);
+
+        add_assoc_double(&worker, "busy", stats[i].busy);
+        add_assoc_double(&worker, "utilization", wall > 0.0 ? stats[i].busy / wall : 0.0);
+        add_assoc_long(&worker, "rows", stats[i].rows);
+        add_assoc_long(&worker, "tasks", stats[i].tasks);
+        add_assoc_long(&worker, "steals", stats[i].steals);
+
+        add_next_index_zval(&workers, &worker);
+    }
+
+    RETVAL_ARR(Z_ARR(workers));
+}
+
+/**
+ * Reset the utilization counters of the row scheduler.
+ * 
+ * @param return_value
+ */
+void tensor_reset_utilization(zval * return_value)
+{
+    tensor_parallel_reset_stats();
+
+    RETURN_TRUE;
 }
@@ -5,5 +5,11 @@
 
 void tensor_set_num_threads(zval * return_value, zval * threads);
 void tensor_get_num_threads(zval * return_value);
+void tensor_set_fast_math(zval * return_value, zval * enabled);
+void tensor_get_fast_math(zval * return_value);
+void tensor_set_grain_size(zval * return_value, zval * size);
+void tensor_get_grain_size(zval * return_value);
+void tensor_get_utilization(zval * return_value);
+void tensor_reset_utilization(zval * return_value);
 
 #endif
@@ -0,0 +1,600 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include "simd.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define TENSOR_SIMD_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define TENSOR_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+/**
+ * Define a portable element-wise kernel over two arrays of the given element type.
+ */
+#define TENSOR_SCALAR_BINARY(name, type, op) \
+static void name(const type * a, const type * b, type * c, size_t n) \
+{ \
+    size_t i; \
+    for (i = 0; i < n; ++i) { \
+        c[i] = a[i] op b[i]; \
+    } \
+}
+
+/**
+ * Define a portable element-wise kernel over an array of the given element type and a scalar.
+ */
+#define TENSOR_SCALAR_SCALAR(name, type, op) \
+static void name(const type * a, type b, type * c, size_t n) \
+{ \
+    size_t i; \
+    for (i = 0; i < n; ++i) { \
+        c[i] = a[i] op b; \
+    } \
+}
+
+TENSOR_SCALAR_BINARY(tensor_scalar_multiply, double, *)
+TENSOR_SCALAR_BINARY(tensor_scalar_divide, double, /)
+TENSOR_SCALAR_BINARY(tensor_scalar_add, double, +)
+TENSOR_SCALAR_BINARY(tensor_scalar_subtract, double, -)
+
+TENSOR_SCALAR_SCALAR(tensor_scalar_multiply_scalar, double, *)
+TENSOR_SCALAR_SCALAR(tensor_scalar_divide_scalar, double, /)
+TENSOR_SCALAR_SCALAR(tensor_scalar_add_scalar, double, +)
+TENSOR_SCALAR_SCALAR(tensor_scalar_subtract_scalar, double, -)
+
+TENSOR_SCALAR_BINARY(tensor_scalar_multiply32, float, *)
+TENSOR_SCALAR_BINARY(tensor_scalar_divide32, float, /)
+TENSOR_SCALAR_BINARY(tensor_scalar_add32, float, +)
+TENSOR_SCALAR_BINARY(tensor_scalar_subtract32, float, -)
+
+TENSOR_SCALAR_SCALAR(tensor_scalar_multiply_scalar32, float, *)
+TENSOR_SCALAR_SCALAR(tensor_scalar_divide_scalar32, float, /)
+TENSOR_SCALAR_SCALAR(tensor_scalar_add_scalar32, float, +)
+TENSOR_SCALAR_SCALAR(tensor_scalar_subtract_scalar32, float, -)
+
+/**
+ * Inputs beyond these magnitudes fall outside of the range reduction used by the fast
+ * approximations below and are handed to libm instead.
+ */
+#define TENSOR_FAST_EXP_LIMIT 708.0
+#define TENSOR_FAST_TRIG_LIMIT 823549.0
+
+#define TENSOR_SHIFT 0x1.8p52
+#define TENSOR_LOG2E 1.44269504088896338700e+00
+#define TENSOR_LN2_HI 6.93147180369123816490e-01
+#define TENSOR_LN2_LO 1.90821492927058770002e-10
+#define TENSOR_2_PI 6.36619772367581382433e-01
+#define TENSOR_PIO2_1 1.57079632673412561417e+00
+#define TENSOR_PIO2_2 6.07710050630396597660e-11
+#define TENSOR_PIO2_3 2.02226624871116645580e-21
+#define TENSOR_SQRT_HALF 0x3fe6a09e667f3bcdULL
+
+static inline uint64_t tensor_as_u64(double x)
+{
+    uint64_t u;
+
+    memcpy(&u, &x, sizeof(u));
+
+    return u;
+}
+
+static inline double tensor_as_f64(uint64_t u)
+{
+    double x;
+
+    memcpy(&x, &u, sizeof(x));
+
+    return x;
+}
+
+/**
+ * Exponential of x for |x| <= 708. The argument is reduced to x = n ln(2) + r with
+ * |r| <= ln(2) / 2 and e^r is evaluated with a degree 13 polynomial.
+ *
+ * @param x
+ * @return double
+ */
+static inline double tensor_fast_exp(double x)
+{
+    double kd = x * TENSOR_LOG2E + TENSOR_SHIFT;
+
+    uint64_t ki = tensor_as_u64(kd);
+
+    kd -= TENSOR_SHIFT;
+
+    double r = x - kd * TENSOR_LN2_HI - kd * TENSOR_LN2_LO;
+
+    double p = 1.0 / 6227020800.0;
+
+    p = p * r + 1.0 / 479001600.0;
+    p = p * r + 1.0 / 39916800.0;
+    p = p * r + 1.0 / 3628800.0;
+    p = p * r + 1.0 / 362880.0;
+    p = p * r + 1.0 / 40320.0;
+    p = p * r + 1.0 / 5040.0;
+    p = p * r + 1.0 / 720.0;
+    p = p * r + 1.0 / 120.0;
+    p = p * r + 1.0 / 24.0;
+    p = p * r + 1.0 / 6.0;
+    p = p * r + 0.5;
+    p = p * r + 1.0;
+    p = p * r + 1.0;
+
+    return p * tensor_as_f64((ki + 1023) << 52);
+}
+
+/**
+ * Natural logarithm of a positive normal x. The argument is reduced to x = 2^e m with
+ * sqrt(1/2) <= m < sqrt(2) and log(m) is evaluated with the fdlibm polynomial.
+ *
+ * @param x
+ * @return double
+ */
+static inline double tensor_fast_log(double x)
+{
+    uint64_t u = tensor_as_u64(x) - TENSOR_SQRT_HALF;
+
+    double e = (double) (int32_t) ((int64_t) u >> 52);
+
+    double f = tensor_as_f64((u & 0x000fffffffffffffULL) + TENSOR_SQRT_HALF) - 1.0;
+
+    double s = f / (2.0 + f);
+    double z = s * s;
+    double w = z * z;
+
+    double t1 = w * (3.999999999940941908e-01 + w * (2.222219843214978396e-01 + w * 1.531383769920937332e-01));
+    double t2 = z * (6.666666666666735130e-01 + w * (2.857142874366239149e-01 + w * (1.818357216161805012e-01 + w * 1.479819860511658591e-01)));
+
+    double hfsq = 0.5 * f * f;
+
+    return e * TENSOR_LN2_HI - ((hfsq - (s * (hfsq + t1 + t2) + e * TENSOR_LN2_LO)) - f);
+}
+
+/**
+ * Sine of r for |r| <= pi / 4.
+ *
+ * @param r
+ * @return double
+ */
+static inline double tensor_kernel_sin(double r)
+{
+    double z = r * r;
+
+    double p = 1.58969099521155010221e-10;
+
+    p = p * z - 2.50507602534068634195e-08;
+    p = p * z + 2.75573137070700676789e-06;
+    p = p * z - 1.98412698298579493134e-04;
+    p = p * z + 8.33333333332248946124e-03;
+    p = p * z - 1.66666666666666324348e-01;
+
+    return r + r * z * p;
+}
+
+/**
+ * Cosine of r for |r| <= pi / 4.
+ *
+ * @param r
+ * @return double
+ */
+static inline double tensor_kernel_cos(double r)
+{
+    double z = r * r;
+
+    double p = -1.13596475577881948265e-11;
+
+    p = p * z + 2.08757232129817482790e-09;
+    p = p * z - 2.75573143513906633035e-07;
+    p = p * z + 2.48015872894767294178e-05;
+    p = p * z - 1.38888888888741095749e-03;
+    p = p * z + 4.16666666666666019037e-02;
+
+    return 1.0 - 0.5 * z + z * z * p;
+}
+
+/**
+ * Reduce x to r = x - k pi / 2 with |r| <= pi / 4 and return the quadrant k.
+ *
+ * @param x
+ * @param r
+ * @return uint64_t
+ */
+static inline uint64_t tensor_reduce_pio2(double x, double * r)
+{
+    double kd = x * TENSOR_2_PI + TENSOR_SHIFT;
+
+    uint64_t k = tensor_as_u64(kd);
+
+    kd -= TENSOR_SHIFT;
+
+    *r = ((x - kd * TENSOR_PIO2_1) - kd * TENSOR_PIO2_2) - kd * TENSOR_PIO2_3;
+
+    return k;
+}
+
+/**
+ * Select b where the mask is set and a otherwise without branching.
+ *
+ * @param a
+ * @param b
+ * @param mask
+ * @return double
+ */
+static inline double tensor_select(double a, double b, uint64_t mask)
+{
+    return tensor_as_f64((tensor_as_u64(a) & ~mask) | (tensor_as_u64(b) & mask));
+}
+
+static inline double tensor_fast_sin(double x)
+{
+    double r;
+
+    uint64_t k = tensor_reduce_pio2(x, &r);
+
+    double y = tensor_select(tensor_kernel_sin(r), tensor_kernel_cos(r), 0 - (k & 1));
+
+    return tensor_as_f64(tensor_as_u64(y) ^ ((k & 2) << 62));
+}
+
+static inline double tensor_fast_cos(double x)
+{
+    double r;
+
+    uint64_t k = tensor_reduce_pio2(x, &r) + 1;
+
+    double y = tensor_select(tensor_kernel_sin(r), tensor_kernel_cos(r), 0 - (k & 1));
+
+    return tensor_as_f64(tensor_as_u64(y) ^ ((k & 2) << 62));
+}
+
+static inline double tensor_fast_tan(double x)
+{
+    double r;
+
+    uint64_t k = tensor_reduce_pio2(x, &r);
+
+    uint64_t mask = 0 - (k & 1);
+
+    double s = tensor_kernel_sin(r);
+    double c = tensor_kernel_cos(r);
+
+    return tensor_select(s, -c, mask) / tensor_select(c, s, mask);
+}
+
+static inline int tensor_exp_in_range(double x)
+{
+    return fabs(x) <= TENSOR_FAST_EXP_LIMIT;
+}
+
+static inline int tensor_log_in_range(double x)
+{
+    return x >= DBL_MIN && x <= DBL_MAX;
+}
+
+static inline int tensor_trig_in_range(double x)
+{
+    return fabs(x) <= TENSOR_FAST_TRIG_LIMIT;
+}
+
+/**
+ * Define a kernel that applies a fast approximation to an array of doubles. The main loop is
+ * free of branches and calls so the compiler can vectorize it for the target. Elements outside
+ * of the range of the approximation, including infinities and NaN, are recomputed with libm.
+ */
+#define TENSOR_FAST_UNARY(name, attributes, fast, strict, in_range) \
+attributes \
+static void name(const double * a, double * b, size_t n) \
+{ \
+    size_t i; \
+    for (i = 0; i < n; ++i) { \
+        b[i] = fast(a[i]); \
+    } \
+    for (i = 0; i < n; ++i) { \
+        if (!in_range(a[i])) { \
+            b[i] = strict(a[i]); \
+        } \
+    } \
+}
+
+#define TENSOR_FAST_UNARY_SET(prefix, attributes) \
+TENSOR_FAST_UNARY(prefix##_exp, attributes, tensor_fast_exp, exp, tensor_exp_in_range) \
+TENSOR_FAST_UNARY(prefix##_log, attributes, tensor_fast_log, log, tensor_log_in_range) \
+TENSOR_FAST_UNARY(prefix##_sin, attributes, tensor_fast_sin, sin, tensor_trig_in_range) \
+TENSOR_FAST_UNARY(prefix##_cos, attributes, tensor_fast_cos, cos, tensor_trig_in_range) \
+TENSOR_FAST_UNARY(prefix##_tan, attributes, tensor_fast_tan, tan, tensor_trig_in_range)
+
+TENSOR_FAST_UNARY_SET(tensor_scalar, )
+
+/**
+ * Square root of an array of doubles. Square root is correctly rounded in every instruction
+ * set so there is no separate fast variant.
+ *
+ * @param a
+ * @param b
+ * @param n
+ */
+static void tensor_scalar_sqrt(const double * a, double * b, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; ++i) {
+        b[i] = sqrt(a[i]);
+    }
+}
+
+#ifdef TENSOR_SIMD_X86
+
+/**
+ * Define an element-wise kernel that processes a full register of lanes per iteration and
+ * finishes the remainder one element at a time. Each kernel is compiled for the given target
+ * so the rest of the extension can be built without any -m flags.
+ */
+#define TENSOR_X86_BINARY(name, isa, type, width, vtype, load, store, vop, op) \
+__attribute__((target(isa))) \
+static void name(const type * a, const type * b, type * c, size_t n) \
+{ \
+    size_t i = 0; \
+    for (; i + width <= n; i += width) { \
+        vtype va = load(a + i); \
+        vtype vb = load(b + i); \
+        store(c + i, vop(va, vb)); \
+    } \
+    for (; i < n; ++i) { \
+        c[i] = a[i] op b[i]; \
+    } \
+}
+
+#define TENSOR_X86_SCALAR(name, isa, type, width, vtype, load, store, set1, vop, op) \
+__attribute__((target(isa))) \
+static void name(const type * a, type b, type * c, size_t n) \
+{ \
+    size_t i = 0; \
+    vtype vb = set1(b); \
+    for (; i + width <= n; i += width) { \
+        store(c + i, vop(load(a + i), vb)); \
+    } \
+    for (; i < n; ++i) { \
+        c[i] = a[i] op b; \
+    } \
+}
+
+#define TENSOR_X86_SQRT(name, isa, width, vtype, load, store, vsqrt) \
+__attribute__((target(isa))) \
+static void name(const double * a, double * b, size_t n) \
+{ \
+    size_t i = 0; \
+    for (; i + width <= n; i += width) { \
+        store(b + i, vsqrt(load(a + i))); \
+    } \
+    for (; i < n; ++i) { \
+        b[i] = sqrt(a[i]); \
+    } \
+}
+
+TENSOR_X86_BINARY(tensor_avx2_multiply, "avx2", double, 4, __m256d, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_mul_pd, *)
+TENSOR_X86_BINARY(tensor_avx2_divide, "avx2", double, 4, __m256d, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_div_pd, /)
+TENSOR_X86_BINARY(tensor_avx2_add, "avx2", double, 4, __m256d, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_add_pd, +)
+TENSOR_X86_BINARY(tensor_avx2_subtract, "avx2", double, 4, __m256d, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_sub_pd, -)
+
+TENSOR_X86_SCALAR(tensor_avx2_multiply_scalar, "avx2", double, 4, __m256d, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_mul_pd, *)
+TENSOR_X86_SCALAR(tensor_avx2_divide_scalar, "avx2", double, 4, __m256d, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_div_pd, /)
+TENSOR_X86_SCALAR(tensor_avx2_add_scalar, "avx2", double, 4, __m256d, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_add_pd, +)
+TENSOR_X86_SCALAR(tensor_avx2_subtract_scalar, "avx2", double, 4, __m256d, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_sub_pd, -)
+
+TENSOR_X86_BINARY(tensor_avx512_multiply, "avx512f", double, 8, __m512d, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_mul_pd, *)
+TENSOR_X86_BINARY(tensor_avx512_divide, "avx512f", double, 8, __m512d, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_div_pd, /)
+TENSOR_X86_BINARY(tensor_avx512_add, "avx512f", double, 8, __m512d, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_add_pd, +)
+TENSOR_X86_BINARY(tensor_avx512_subtract, "avx512f", double, 8, __m512d, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_sub_pd, -)
+
+TENSOR_X86_SCALAR(tensor_avx512_multiply_scalar, "avx512f", double, 8, __m512d, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_set1_pd, _mm512_mul_pd, *)
+TENSOR_X86_SCALAR(tensor_avx512_divide_scalar, "avx512f", double, 8, __m512d, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_set1_pd, _mm512_div_pd, /)
+TENSOR_X86_SCALAR(tensor_avx512_add_scalar, "avx512f", double, 8, __m512d, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_set1_pd, _mm512_add_pd, +)
+TENSOR_X86_SCALAR(tensor_avx512_subtract_scalar, "avx512f", double, 8, __m512d, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_set1_pd, _mm512_sub_pd, -)
+
+TENSOR_X86_BINARY(tensor_avx2_multiply32, "avx2", float, 8, __m256, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_mul_ps, *)
+TENSOR_X86_BINARY(tensor_avx2_divide32, "avx2", float, 8, __m256, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_div_ps, /)
+TENSOR_X86_BINARY(tensor_avx2_add32, "avx2", float, 8, __m256, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_add_ps, +)
+TENSOR_X86_BINARY(tensor_avx2_subtract32, "avx2", float, 8, __m256, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_sub_ps, -)
+
+TENSOR_X86_SCALAR(tensor_avx2_multiply_scalar32, "avx2", float, 8, __m256, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, _mm256_mul_ps, *)
+TENSOR_X86_SCALAR(tensor_avx2_divide_scalar32, "avx2", float, 8, __m256, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, _mm256_div_ps, /)
+TENSOR_X86_SCALAR(tensor_avx2_add_scalar32, "avx2", float, 8, __m256, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, _mm256_add_ps, +)
+TENSOR_X86_SCALAR(tensor_avx2_subtract_scalar32, "avx2", float, 8, __m256, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, _mm256_sub_ps, -)
+
+TENSOR_X86_BINARY(tensor_avx512_multiply32, "avx512f", float, 16, __m512, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_mul_ps, *)
+TENSOR_X86_BINARY(tensor_avx512_divide32, "avx512f", float, 16, __m512, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_div_ps, /)
+TENSOR_X86_BINARY(tensor_avx512_add32, "avx512f", float, 16, __m512, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_add_ps, +)
+TENSOR_X86_BINARY(tensor_avx512_subtract32, "avx512f", float, 16, __m512, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_sub_ps, -)
+
+TENSOR_X86_SCALAR(tensor_avx512_multiply_scalar32, "avx512f", float, 16, __m512, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_set1_ps, _mm512_mul_ps, *)
+TENSOR_X86_SCALAR(tensor_avx512_divide_scalar32, "avx512f", float, 16, __m512, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_set1_ps, _mm512_div_ps, /)
+TENSOR_X86_SCALAR(tensor_avx512_add_scalar32, "avx512f", float, 16, __m512, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_set1_ps, _mm512_add_ps, +)
+TENSOR_X86_SCALAR(tensor_avx512_subtract_scalar32, "avx512f", float, 16, __m512, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_set1_ps, _mm512_sub_ps, -)
+
+TENSOR_X86_SQRT(tensor_avx2_sqrt, "avx2", 4, __m256d, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_sqrt_pd)
+TENSOR_X86_SQRT(tensor_avx512_sqrt, "avx512f", 8, __m512d, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_sqrt_pd)
+
+TENSOR_FAST_UNARY_SET(tensor_avx2, __attribute__((target("avx2,fma"))))
+TENSOR_FAST_UNARY_SET(tensor_avx512, __attribute__((target("avx512f,avx512dq"))))
+
+#endif
+
+#ifdef TENSOR_SIMD_NEON
+
+#define TENSOR_NEON_BINARY(name, type, width, load, store, vop, op) \
+static void name(const type * a, const type * b, type * c, size_t n) \
+{ \
+    size_t i = 0; \
+    for (; i + width <= n; i += width) { \
+        store(c + i, vop(load(a + i), load(b + i))); \
+    } \
+    for (; i < n; ++i) { \
+        c[i] = a[i] op b[i]; \
+    } \
+}
+
+#define TENSOR_NEON_SCALAR(name, type, width, vtype, load, store, dup, vop, op) \
+static void name(const type * a, type b, type * c, size_t n) \
+{ \
+    size_t i = 0; \
+    vtype vb = dup(b); \
+    for (; i + width <= n; i += width) { \
+        store(c + i, vop(load(a + i), vb)); \
+    } \
+    for (; i < n; ++i) { \
+        c[i] = a[i] op b; \
+    } \
+}
+
+TENSOR_NEON_BINARY(tensor_neon_multiply, double, 2, vld1q_f64, vst1q_f64, vmulq_f64, *)
+TENSOR_NEON_BINARY(tensor_neon_divide, double, 2, vld1q_f64, vst1q_f64, vdivq_f64, /)
+TENSOR_NEON_BINARY(tensor_neon_add, double, 2, vld1q_f64, vst1q_f64, vaddq_f64, +)
+TENSOR_NEON_BINARY(tensor_neon_subtract, double, 2, vld1q_f64, vst1q_f64, vsubq_f64, -)
+
+TENSOR_NEON_SCALAR(tensor_neon_multiply_scalar, double, 2, float64x2_t, vld1q_f64, vst1q_f64, vdupq_n_f64, vmulq_f64, *)
+TENSOR_NEON_SCALAR(tensor_neon_divide_scalar, double, 2, float64x2_t, vld1q_f64, vst1q_f64, vdupq_n_f64, vdivq_f64, /)
+TENSOR_NEON_SCALAR(tensor_neon_add_scalar, double, 2, float64x2_t, vld1q_f64, vst1q_f64, vdupq_n_f64, vaddq_f64, +)
+TENSOR_NEON_SCALAR(tensor_neon_subtract_scalar, double, 2, float64x2_t, vld1q_f64, vst1q_f64, vdupq_n_f64, vsubq_f64, -)
+
+TENSOR_NEON_BINARY(tensor_neon_multiply32, float, 4, vld1q_f32, vst1q_f32, vmulq_f32, *)
+TENSOR_NEON_BINARY(tensor_neon_divide32, float, 4, vld1q_f32, vst1q_f32, vdivq_f32, /)
+TENSOR_NEON_BINARY(tensor_neon_add32, float, 4, vld1q_f32, vst1q_f32, vaddq_f32, +)
+TENSOR_NEON_BINARY(tensor_neon_subtract32, float, 4, vld1q_f32, vst1q_f32, vsubq_f32, -)
+
+TENSOR_NEON_SCALAR(tensor_neon_multiply_scalar32, float, 4, float32x4_t, vld1q_f32, vst1q_f32, vdupq_n_f32, vmulq_f32, *)
+TENSOR_NEON_SCALAR(tensor_neon_divide_scalar32, float, 4, float32x4_t, vld1q_f32, vst1q_f32, vdupq_n_f32, vdivq_f32, /)
+TENSOR_NEON_SCALAR(tensor_neon_add_scalar32, float, 4, float32x4_t, vld1q_f32, vst1q_f32, vdupq_n_f32, vaddq_f32, +)
+TENSOR_NEON_SCALAR(tensor_neon_subtract_scalar32, float, 4, float32x4_t, vld1q_f32, vst1q_f32, vdupq_n_f32, vsubq_f32, -)
+
+#endif
+
+/**
+ * The element-wise kernels selected for this CPU. Defaults to the portable implementations
+ * until the dispatcher runs at module startup and is never written to afterwards.
+ */
+tensor_simd_kernels tensor_simd = {
+    tensor_scalar_multiply,
+    tensor_scalar_divide,
+    tensor_scalar_add,
+    tensor_scalar_subtract,
+    tensor_scalar_multiply_scalar,
+    tensor_scalar_divide_scalar,
+    tensor_scalar_add_scalar,
+    tensor_scalar_subtract_scalar,
+    tensor_scalar_exp,
+    tensor_scalar_log,
+    tensor_scalar_sin,
+    tensor_scalar_cos,
+    tensor_scalar_tan,
+    tensor_scalar_sqrt,
+};
+
+/**
+ * The single precision element-wise kernels selected for this CPU.
+ */
+tensor_simd_kernels32 tensor_simd32 = {
+    tensor_scalar_multiply32,
+    tensor_scalar_divide32,
+    tensor_scalar_add32,
+    tensor_scalar_subtract32,
+    tensor_scalar_multiply_scalar32,
+    tensor_scalar_divide_scalar32,
+    tensor_scalar_add_scalar32,
+    tensor_scalar_subtract_scalar32,
+};
+
+/**
+ * Select the widest instruction set supported by the host CPU. Called once at module startup.
+ * Each set is only chosen when the CPU has every extension that its fast approximations were
+ * compiled for.
+ */
+void tensor_simd_init()
+{
+#ifdef TENSOR_SIMD_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) {
+        tensor_simd.multiply = tensor_avx512_multiply;
+        tensor_simd.divide = tensor_avx512_divide;
+        tensor_simd.add = tensor_avx512_add;
+        tensor_simd.subtract = tensor_avx512_subtract;
+        tensor_simd.multiply_scalar = tensor_avx512_multiply_scalar;
+        tensor_simd.divide_scalar = tensor_avx512_divide_scalar;
+        tensor_simd.add_scalar = tensor_avx512_add_scalar;
+        tensor_simd.subtract_scalar = tensor_avx512_subtract_scalar;
+        tensor_simd.exp = tensor_avx512_exp;
+        tensor_simd.log = tensor_avx512_log;
+        tensor_simd.sin = tensor_avx512_sin;
+        tensor_simd.cos = tensor_avx512_cos;
+        tensor_simd.tan = tensor_avx512_tan;
+        tensor_simd.sqrt = tensor_avx512_sqrt;
+
+        tensor_simd32.multiply = tensor_avx512_multiply32;
+        tensor_simd32.divide = tensor_avx512_divide32;
+        tensor_simd32.add = tensor_avx512_add32;
+        tensor_simd32.subtract = tensor_avx512_subtract32;
+        tensor_simd32.multiply_scalar = tensor_avx512_multiply_scalar32;
+        tensor_simd32.divide_scalar = tensor_avx512_divide_scalar32;
+        tensor_simd32.add_scalar = tensor_avx512_add_scalar32;
+        tensor_simd32.subtract_scalar = tensor_avx512_subtract_scalar32;
+
+        return;
+    }
+
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        tensor_simd.multiply = tensor_avx2_multiply;
+        tensor_simd.divide = tensor_avx2_divide;
+        tensor_simd.add = tensor_avx2_add;
+        tensor_simd.subtract = tensor_avx2_subtract;
+        tensor_simd.multiply_scalar = tensor_avx2_multiply_scalar;
+        tensor_simd.divide_scalar = tensor_avx2_divide_scalar;
+        tensor_simd.add_scalar = tensor_avx2_add_scalar;
+        tensor_simd.subtract_scalar = tensor_avx2_subtract_scalar;
+        tensor_simd.exp = tensor_avx2_exp;
+        tensor_simd.log = tensor_avx2_log;
+        tensor_simd.sin = tensor_avx2_sin;
+        tensor_simd.cos = tensor_avx2_cos;
+        tensor_simd.tan = tensor_avx2_tan;
+        tensor_simd.sqrt = tensor_avx2_sqrt;
+
+        tensor_simd32.multiply = tensor_avx2_multiply32;
+        tensor_simd32.divide = tensor_avx2_divide32;
+        tensor_simd32.add = tensor_avx2_add32;
+        tensor_simd32.subtract = tensor_avx2_subtract32;
+        tensor_simd32.multiply_scalar = tensor_avx2_multiply_scalar32;
+        tensor_simd32.divide_scalar = tensor_avx2_divide_scalar32;
+        tensor_simd32.add_scalar = tensor_avx2_add_scalar32;
+        tensor_simd32.subtract_scalar = tensor_avx2_subtract_scalar32;
+
+        return;
+    }
+#endif
+
+#ifdef TENSOR_SIMD_NEON
+    tensor_simd.multiply = tensor_neon_multiply;
+    tensor_simd.divide = tensor_neon_divide;
+    tensor_simd.add = tensor_neon_add;
+    tensor_simd.subtract = tensor_neon_subtract;
+    tensor_simd.multiply_scalar = tensor_neon_multiply_scalar;
+    tensor_simd.divide_scalar = tensor_neon_divide_scalar;
+    tensor_simd.add_scalar = tensor_neon_add_scalar;
+    tensor_simd.subtract_scalar = tensor_neon_subtract_scalar;
+
+    tensor_simd32.multiply = tensor_neon_multiply32;
+    tensor_simd32.divide = tensor_neon_divide32;
+    tensor_simd32.add = tensor_neon_add32;
+    tensor_simd32.subtract = tensor_neon_subtract32;
+    tensor_simd32.multiply_scalar = tensor_neon_multiply_scalar32;
+    tensor_simd32.divide_scalar = tensor_neon_divide_scalar32;
+    tensor_simd32.add_scalar = tensor_neon_add_scalar32;
+    tensor_simd32.subtract_scalar = tensor_neon_subtract_scalar32;
+#endif
+}
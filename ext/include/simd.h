@@ -0,0 +1,46 @@
+#ifndef TENSOR_SIMD_H
+#define TENSOR_SIMD_H
+
+#include <stddef.h>
+
+typedef void (*tensor_simd_binary)(const double * a, const double * b, double * c, size_t n);
+typedef void (*tensor_simd_scalar)(const double * a, double b, double * c, size_t n);
+typedef void (*tensor_simd_unary)(const double * a, double * b, size_t n);
+
+typedef void (*tensor_simd_binary32)(const float * a, const float * b, float * c, size_t n);
+typedef void (*tensor_simd_scalar32)(const float * a, float b, float * c, size_t n);
+
+typedef struct _tensor_simd_kernels {
+    tensor_simd_binary multiply;
+    tensor_simd_binary divide;
+    tensor_simd_binary add;
+    tensor_simd_binary subtract;
+    tensor_simd_scalar multiply_scalar;
+    tensor_simd_scalar divide_scalar;
+    tensor_simd_scalar add_scalar;
+    tensor_simd_scalar subtract_scalar;
+    tensor_simd_unary exp;
+    tensor_simd_unary log;
+    tensor_simd_unary sin;
+    tensor_simd_unary cos;
+    tensor_simd_unary tan;
+    tensor_simd_unary sqrt;
+} tensor_simd_kernels;
+
+typedef struct _tensor_simd_kernels32 {
+    tensor_simd_binary32 multiply;
+    tensor_simd_binary32 divide;
+    tensor_simd_binary32 add;
+    tensor_simd_binary32 subtract;
+    tensor_simd_scalar32 multiply_scalar;
+    tensor_simd_scalar32 divide_scalar;
+    tensor_simd_scalar32 add_scalar;
+    tensor_simd_scalar32 subtract_scalar;
+} tensor_simd_kernels32;
+
+extern tensor_simd_kernels tensor_simd;
+extern tensor_simd_kernels32 tensor_simd32;
+
+void tensor_simd_init();
+
+#endif
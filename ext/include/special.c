@@ -0,0 +1,130 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <php.h>
+#include <math.h>
+#include "kernel/operators.h"
+#include "buffer.h"
+#include "parallel.h"
+#include "special.h"
+
+typedef struct _tensor_clip_job {
+    const void * a;
+    void * b;
+    zend_long n;
+    double lower;
+    double upper;
+} tensor_clip_job;
+
+/**
+ * Define a task that clips the elements of rows start through end to the range [lower, upper].
+ */
+#define TENSOR_CLIP_TASK(name, type) \
+static void name(void * context, size_t start, size_t end) \
+{ \
+    size_t i; \
+    tensor_clip_job * job = context; \
+    const type * a = job->a; \
+    type * b = job->b; \
+    type lower = (type) job->lower; \
+    type upper = (type) job->upper; \
+    for (i = start * job->n; i < end * job->n; ++i) { \
+        type value = a[i]; \
+        if (value > upper) { \
+            b[i] = upper; \
+        } else if (value < lower) { \
+            b[i] = lower; \
+        } else { \
+            b[i] = value; \
+        } \
+    } \
+}
+
+TENSOR_CLIP_TASK(tensor_clip_task, double)
+TENSOR_CLIP_TASK(tensor_clip_task32, float)
+
+/**
+ * Clip the m x n elements of buffer A to the range [lower, upper] and store them in buffer B of
+ * the same dtype using the row scheduler. A and B may be the same buffer.
+ *
+ * @param ba
+ * @param bb
+ * @param lower
+ * @param upper
+ */
+static void tensor_clip_rows(const tensor_buffer * ba, tensor_buffer * bb, double lower, double upper)
+{
+    zend_long n = ba->n;
+
+    tensor_clip_job job = { .a = ba->data, .b = bb->data, .n = n, .lower = lower, .upper = upper };
+
+    tensor_parallel_rows(ba->m, MAX(1, tensor_grain_size / MAX(n, 1)), ba->dtype == TENSOR_DTYPE_FLOAT32 ? tensor_clip_task32 : tensor_clip_task, &job);
+}
+
+/**
+ * Clip the elements of buffer A to the range [min, max] and return the result in a new buffer of
+ * the same dtype.
+ *
+ * @param return_value
+ * @param a
+ * @param min
+ * @param max
+ */
+void tensor_clip(zval * return_value, zval * a, zval * min, zval * max)
+{
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    tensor_buffer * bb = tensor_buffer_alloc_dtype(return_value, ba->m, ba->n, ba->dtype);
+
+    tensor_clip_rows(ba, bb, zephir_get_doubleval(min), zephir_get_doubleval(max));
+}
+
+/**
+ * Clip the elements of buffer A to a lower bound and return the result in a new buffer of the
+ * same dtype.
+ *
+ * @param return_value
+ * @param a
+ * @param min
+ */
+void tensor_clip_lower(zval * return_value, zval * a, zval * min)
+{
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    tensor_buffer * bb = tensor_buffer_alloc_dtype(return_value, ba->m, ba->n, ba->dtype);
+
+    tensor_clip_rows(ba, bb, zephir_get_doubleval(min), INFINITY);
+}
+
+/**
+ * Clip the elements of buffer A to an upper bound and return the result in a new buffer of the
+ * same dtype.
+ *
+ * @param return_value
+ * @param a
+ * @param max
+ */
+void tensor_clip_upper(zval * return_value, zval * a, zval * max)
+{
+    tensor_buffer * ba = Z_TENSOR_BUFFER_P(a);
+
+    tensor_buffer * bb = tensor_buffer_alloc_dtype(return_value, ba->m, ba->n, ba->dtype);
+
+    tensor_clip_rows(ba, bb, -INFINITY, zephir_get_doubleval(max));
+}
+
+/**
+ * Clip the elements of buffer A to the range [min, max] in place and return A.
+ *
+ * @param return_value
+ * @param a
+ * @param min
+ * @param max
+ */
+void tensor_clip_in_place(zval * return_value, zval * a, zval * min, zval * max)
+{
+    tensor_buffer * bc = tensor_buffer_separate(return_value, a);
+
+    tensor_clip_rows(bc, bc, zephir_get_doubleval(min), zephir_get_doubleval(max));
+}
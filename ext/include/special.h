@@ -0,0 +1,11 @@
+#ifndef TENSOR_SPECIAL_H
+#define TENSOR_SPECIAL_H
+
+#include <Zend/zend.h>
+
+void tensor_clip(zval * return_value, zval * a, zval * min, zval * max);
+void tensor_clip_lower(zval * return_value, zval * a, zval * min);
+void tensor_clip_upper(zval * return_value, zval * a, zval * max);
+void tensor_clip_in_place(zval * return_value, zval * a, zval * min, zval * max);
+
+#endif
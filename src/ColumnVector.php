@@ -45,6 +45,46 @@ class ColumnVector extends Vector
         return Vector::quick($this->a);
     }
 
+    /**
+     * Compare this column vector to another tensor or a scalar element-wise and return a mask
+     * that holds where the comparison does. The comparison is one of ==, !=, >, >=, <, or <=.
+     *
+     * @param mixed $b
+     * @param string $comparison
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @throws DimensionalityMismatch
+     * @return \Tensor\Mask
+     */
+    public function compare($b, string $comparison) : Mask
+    {
+        if ($b instanceof Matrix) {
+            $op = Mask::comparison($comparison);
+
+            if ($this->n !== $b->m()) {
+                throw new DimensionalityMismatch('Vector A expects'
+                    . " {$this->n} rows but Matrix B has {$b->m()}.");
+            }
+
+            $c = [];
+
+            foreach ($b->asArray() as $i => $rowB) {
+                $valueA = $this->a[$i];
+
+                $rowC = [];
+
+                foreach ($rowB as $valueB) {
+                    $rowC[] = Mask::holds($valueA, $valueB, $op);
+                }
+
+                $c[] = $rowC;
+            }
+
+            return new Mask($c);
+        }
+
+        return parent::compare($b, $comparison);
+    }
+
     /**
      * Compute the vector-matrix product of this vector and matrix a.
      *
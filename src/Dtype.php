@@ -0,0 +1,74 @@
+<?php
+
+namespace Tensor;
+
+use Tensor\Exceptions\InvalidArgumentException;
+
+/**
+ * Dtype
+ *
+ * The precisions that the elements of a matrix or vector can be stored in. Single precision
+ * tensors take half of the memory of double precision ones when the extension is loaded. The PHP
+ * implementation always stores and computes in double precision, so every tensor reports float64
+ * and asType() only validates the dtype and returns a copy.
+ *
+ * @category    Scientific Computing
+ * @package     Rubix/Tensor
+ * @author      Andrew DalPino
+ */
+class Dtype
+{
+    /**
+     * Double precision (64-bit) floating point elements.
+     *
+     * @var int
+     */
+    public const FLOAT64 = 0;
+
+    /**
+     * Single precision (32-bit) floating point elements.
+     *
+     * @var int
+     */
+    public const FLOAT32 = 1;
+
+    /**
+     * Boolean elements stored in a single byte each, used by masks.
+     *
+     * @var int
+     */
+    public const BOOL = 2;
+
+    /**
+     * Return the name of a dtype.
+     *
+     * @param int $dtype
+     * @return string
+     */
+    public static function name(int $dtype) : string
+    {
+        switch ($dtype) {
+            case self::FLOAT32:
+                return 'float32';
+
+            case self::BOOL:
+                return 'bool';
+        }
+
+        return 'float64';
+    }
+
+    /**
+     * Throw an exception if the dtype is not supported.
+     *
+     * @param int $dtype
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     */
+    public static function check(int $dtype) : void
+    {
+        if ($dtype !== self::FLOAT64 and $dtype !== self::FLOAT32) {
+            throw new InvalidArgumentException('Dtype must be'
+                . " float64 or float32, $dtype given.");
+        }
+    }
+}
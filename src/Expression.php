@@ -0,0 +1,507 @@
+<?php
+
+namespace Tensor;
+
+use Tensor\Exceptions\InvalidArgumentException;
+use Tensor\Exceptions\DimensionalityMismatch;
+
+use function gettype;
+
+/**
+ * Expression
+ *
+ * A lazily evaluated chain of element-wise operations over a matrix. Operations are recorded
+ * as they are called and then applied in order when the expression is evaluated.
+ *
+ * @category    Scientific Computing
+ * @package     Rubix/Tensor
+ * @author      Andrew DalPino
+ */
+class Expression
+{
+    /**
+     * The matrix that the expression is evaluated over.
+     *
+     * @var \Tensor\Matrix
+     */
+    protected $a;
+
+    /**
+     * The recorded list of [method, arguments] tuples.
+     *
+     * @var list<array>
+     */
+    protected $ops = [];
+
+    /**
+     * @param \Tensor\Matrix $a
+     */
+    public function __construct(Matrix $a)
+    {
+        $this->a = $a;
+    }
+
+    /**
+     * Multiply the expression by another tensor or scalar element-wise.
+     *
+     * @param mixed $b
+     * @return self
+     */
+    public function multiply($b) : self
+    {
+        return $this->binary('multiply', $b);
+    }
+
+    /**
+     * Divide the expression by another tensor or scalar element-wise.
+     *
+     * @param mixed $b
+     * @return self
+     */
+    public function divide($b) : self
+    {
+        return $this->binary('divide', $b);
+    }
+
+    /**
+     * Add another tensor or scalar to the expression element-wise.
+     *
+     * @param mixed $b
+     * @return self
+     */
+    public function add($b) : self
+    {
+        return $this->binary('add', $b);
+    }
+
+    /**
+     * Subtract another tensor or scalar from the expression element-wise.
+     *
+     * @param mixed $b
+     * @return self
+     */
+    public function subtract($b) : self
+    {
+        return $this->binary('subtract', $b);
+    }
+
+    /**
+     * Raise the expression to the power of another tensor or scalar element-wise.
+     *
+     * @param mixed $b
+     * @return self
+     */
+    public function pow($b) : self
+    {
+        return $this->binary('pow', $b);
+    }
+
+    /**
+     * Compute the integer modulus of the expression and another tensor or scalar element-wise.
+     *
+     * @param mixed $b
+     * @return self
+     */
+    public function mod($b) : self
+    {
+        return $this->binary('mod', $b);
+    }
+
+    /**
+     * Compare the expression for equality with another tensor or scalar element-wise.
+     *
+     * @param mixed $b
+     * @return self
+     */
+    public function equal($b) : self
+    {
+        return $this->binary('equal', $b);
+    }
+
+    /**
+     * Compare the expression for inequality with another tensor or scalar element-wise.
+     *
+     * @param mixed $b
+     * @return self
+     */
+    public function notEqual($b) : self
+    {
+        return $this->binary('notEqual', $b);
+    }
+
+    /**
+     * Return a greater than comparison of the expression and another tensor or scalar.
+     *
+     * @param mixed $b
+     * @return self
+     */
+    public function greater($b) : self
+    {
+        return $this->binary('greater', $b);
+    }
+
+    /**
+     * Return a greater than or equal to comparison of the expression and another tensor or scalar.
+     *
+     * @param mixed $b
+     * @return self
+     */
+    public function greaterEqual($b) : self
+    {
+        return $this->binary('greaterEqual', $b);
+    }
+
+    /**
+     * Return a less than comparison of the expression and another tensor or scalar.
+     *
+     * @param mixed $b
+     * @return self
+     */
+    public function less($b) : self
+    {
+        return $this->binary('less', $b);
+    }
+
+    /**
+     * Return a less than or equal to comparison of the expression and another tensor or scalar.
+     *
+     * @param mixed $b
+     * @return self
+     */
+    public function lessEqual($b) : self
+    {
+        return $this->binary('lessEqual', $b);
+    }
+
+    /**
+     * Take the absolute value of the expression.
+     *
+     * @return self
+     */
+    public function abs() : self
+    {
+        return $this->push(['abs', []]);
+    }
+
+    /**
+     * Square the expression.
+     *
+     * @return self
+     */
+    public function square() : self
+    {
+        return $this->push(['square', []]);
+    }
+
+    /**
+     * Take the square root of the expression.
+     *
+     * @return self
+     */
+    public function sqrt() : self
+    {
+        return $this->push(['sqrt', []]);
+    }
+
+    /**
+     * Exponentiate the expression.
+     *
+     * @return self
+     */
+    public function exp() : self
+    {
+        return $this->push(['exp', []]);
+    }
+
+    /**
+     * Exponentiate the expression and subtract 1.
+     *
+     * @return self
+     */
+    public function expm1() : self
+    {
+        return $this->push(['expm1', []]);
+    }
+
+    /**
+     * Take the log of the expression to a given base.
+     *
+     * @param float $base
+     * @return self
+     */
+    public function log(float $base = M_E) : self
+    {
+        return $this->push(['log', [$base]]);
+    }
+
+    /**
+     * Take the log of 1 plus the expression.
+     *
+     * @return self
+     */
+    public function log1p() : self
+    {
+        return $this->push(['log1p', []]);
+    }
+
+    /**
+     * Return the sine of the expression.
+     *
+     * @return self
+     */
+    public function sin() : self
+    {
+        return $this->push(['sin', []]);
+    }
+
+    /**
+     * Compute the arc sine of the expression.
+     *
+     * @return self
+     */
+    public function asin() : self
+    {
+        return $this->push(['asin', []]);
+    }
+
+    /**
+     * Return the cosine of the expression.
+     *
+     * @return self
+     */
+    public function cos() : self
+    {
+        return $this->push(['cos', []]);
+    }
+
+    /**
+     * Compute the arc cosine of the expression.
+     *
+     * @return self
+     */
+    public function acos() : self
+    {
+        return $this->push(['acos', []]);
+    }
+
+    /**
+     * Return the tangent of the expression.
+     *
+     * @return self
+     */
+    public function tan() : self
+    {
+        return $this->push(['tan', []]);
+    }
+
+    /**
+     * Compute the arc tangent of the expression.
+     *
+     * @return self
+     */
+    public function atan() : self
+    {
+        return $this->push(['atan', []]);
+    }
+
+    /**
+     * Convert angles from radians to degrees.
+     *
+     * @return self
+     */
+    public function rad2deg() : self
+    {
+        return $this->push(['rad2deg', []]);
+    }
+
+    /**
+     * Convert angles from degrees to radians.
+     *
+     * @return self
+     */
+    public function deg2rad() : self
+    {
+        return $this->push(['deg2rad', []]);
+    }
+
+    /**
+     * Negate the expression.
+     *
+     * @return self
+     */
+    public function negate() : self
+    {
+        return $this->push(['negate', []]);
+    }
+
+    /**
+     * Take the reciprocal of the expression.
+     *
+     * @return self
+     */
+    public function reciprocal() : self
+    {
+        return $this->push(['reciprocal', []]);
+    }
+
+    /**
+     * Return the element-wise sign indication of the expression.
+     *
+     * @return self
+     */
+    public function sign() : self
+    {
+        return $this->push(['sign', []]);
+    }
+
+    /**
+     * Round the expression down to the nearest integer.
+     *
+     * @return self
+     */
+    public function floor() : self
+    {
+        return $this->push(['floor', []]);
+    }
+
+    /**
+     * Round the expression up to the nearest integer.
+     *
+     * @return self
+     */
+    public function ceil() : self
+    {
+        return $this->push(['ceil', []]);
+    }
+
+    /**
+     * Clip the expression to a given range.
+     *
+     * @param float $min
+     * @param float $max
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return self
+     */
+    public function clip(float $min, float $max) : self
+    {
+        if ($min > $max) {
+            throw new InvalidArgumentException('Minimum cannot be greater than maximum.');
+        }
+
+        return $this->push(['clip', [$min, $max]]);
+    }
+
+    /**
+     * Clip the expression to a given lower bound.
+     *
+     * @param float $min
+     * @return self
+     */
+    public function clipLower(float $min) : self
+    {
+        return $this->push(['clipLower', [$min]]);
+    }
+
+    /**
+     * Clip the expression to a given upper bound.
+     *
+     * @param float $max
+     * @return self
+     */
+    public function clipUpper(float $max) : self
+    {
+        return $this->push(['clipUpper', [$max]]);
+    }
+
+    /**
+     * Apply every recorded operation in order and return the result.
+     *
+     * @return \Tensor\Matrix
+     */
+    public function evaluate() : Matrix
+    {
+        $b = $this->a;
+
+        foreach ($this->ops as [$method, $args]) {
+            $b = $b->$method(...$args);
+        }
+
+        return $b;
+    }
+
+    /**
+     * Apply every recorded operation and return the row sums.
+     *
+     * @return \Tensor\ColumnVector
+     */
+    public function sum() : ColumnVector
+    {
+        return $this->evaluate()->sum();
+    }
+
+    /**
+     * Record an element-wise operation with a tensor or scalar operand.
+     *
+     * @param string $method
+     * @param mixed $b
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    protected function binary(string $method, $b) : self
+    {
+        switch (gettype($b)) {
+            case 'object':
+                switch (true) {
+                    case $b instanceof Matrix:
+                        if ($b->shape() !== $this->a->shape()) {
+                            throw new DimensionalityMismatch("{$this->a->shapeString()}"
+                                . " matrix expected but {$b->shapeString()} given.");
+                        }
+
+                        return $this->push([$method . 'Matrix', [$b]]);
+
+                    case $b instanceof ColumnVector:
+                        if ($b->m() !== $this->a->m()) {
+                            throw new DimensionalityMismatch('Matrix A expects'
+                                . " {$this->a->m()} rows but Vector B has {$b->m()}.");
+                        }
+
+                        return $this->push([$method . 'ColumnVector', [$b]]);
+
+                    case $b instanceof Vector:
+                        if ($b->n() !== $this->a->n()) {
+                            throw new DimensionalityMismatch('Matrix A expects'
+                                . " {$this->a->n()} columns but Vector B has {$b->n()}.");
+                        }
+
+                        return $this->push([$method . 'Vector', [$b]]);
+                }
+
+                break;
+
+            case 'double':
+            case 'integer':
+                return $this->push([$method . 'Scalar', [$b]]);
+        }
+
+        throw new InvalidArgumentException('Cannot apply'
+            . ' expression to the given input.');
+    }
+
+    /**
+     * Return a copy of the expression with an instruction appended to its program so that a
+     * partially built expression can be reused.
+     *
+     * @param mixed[] $instruction
+     * @return self
+     */
+    protected function push(array $instruction) : self
+    {
+        $expression = clone $this;
+
+        $expression->ops[] = $instruction;
+
+        return $expression;
+    }
+}
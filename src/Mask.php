@@ -0,0 +1,323 @@
+<?php
+
+namespace Tensor;
+
+use Tensor\Exceptions\InvalidArgumentException;
+use Tensor\Exceptions\DimensionalityMismatch;
+
+use function count;
+
+/**
+ * Mask
+ *
+ * A boolean tensor returned by the compare() method of a matrix or vector. Masks select elements
+ * of the tensor they were compared from with where() and maskedSum(). The PHP implementation
+ * stores the booleans in a two dimensional array with a single row for masks of vectors.
+ *
+ * @category    Scientific Computing
+ * @package     Rubix/Tensor
+ * @author      Andrew DalPino
+ */
+class Mask
+{
+    /**
+     * The rows of booleans that back the mask.
+     *
+     * @var list<list<bool>>
+     */
+    protected array $a;
+
+    /**
+     * The number of rows in the mask.
+     *
+     * @var int<0,max>
+     */
+    protected int $m;
+
+    /**
+     * The number of columns in the mask.
+     *
+     * @var int<0,max>
+     */
+    protected int $n;
+
+    /**
+     * Does the mask have the shape of a vector?
+     *
+     * @var bool
+     */
+    protected bool $flat;
+
+    /**
+     * Return the code of the native kernel for a comparison operator.
+     *
+     * @internal
+     *
+     * @param string $comparison
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return int
+     */
+    public static function comparison(string $comparison) : int
+    {
+        switch ($comparison) {
+            case '==':
+                return 0;
+
+            case '!=':
+                return 1;
+
+            case '>':
+                return 2;
+
+            case '>=':
+                return 3;
+
+            case '<':
+                return 4;
+
+            case '<=':
+                return 5;
+        }
+
+        throw new InvalidArgumentException('Comparison must be ==, !=,'
+            . " >, >=, <, or <=, $comparison given.");
+    }
+
+    /**
+     * Does the comparison with the given code hold between a and b?
+     *
+     * @internal
+     *
+     * @param float $a
+     * @param float $b
+     * @param int $op
+     * @return bool
+     */
+    public static function holds(float $a, float $b, int $op) : bool
+    {
+        switch ($op) {
+            case 0:
+                return $a == $b;
+
+            case 1:
+                return $a != $b;
+
+            case 2:
+                return $a > $b;
+
+            case 3:
+                return $a >= $b;
+
+            case 4:
+                return $a < $b;
+        }
+
+        return $a <= $b;
+    }
+
+    /**
+     * @internal
+     *
+     * @param list<list<bool>> $a
+     * @param bool $flat
+     */
+    public function __construct(array $a, bool $flat = false)
+    {
+        $this->a = $a;
+        $this->m = count($a);
+        $this->n = $a ? count($a[0]) : 0;
+        $this->flat = $flat;
+    }
+
+    /**
+     * Return a tuple with the dimensionality of the mask.
+     *
+     * @return int[]
+     */
+    public function shape() : array
+    {
+        if ($this->flat) {
+            return [$this->n];
+        }
+
+        return [$this->m, $this->n];
+    }
+
+    /**
+     * Return the shape of the mask as a string.
+     *
+     * @return string
+     */
+    public function shapeString() : string
+    {
+        if ($this->flat) {
+            return (string) $this->n;
+        }
+
+        return "{$this->m} x {$this->n}";
+    }
+
+    /**
+     * Return the number of elements in the mask.
+     *
+     * @return int
+     */
+    public function size() : int
+    {
+        return $this->m * $this->n;
+    }
+
+    /**
+     * Return the number of elements where the mask holds.
+     *
+     * @return int
+     */
+    public function count() : int
+    {
+        $count = 0;
+
+        foreach ($this->a as $rowA) {
+            $count += count(array_filter($rowA));
+        }
+
+        return $count;
+    }
+
+    /**
+     * Does the mask hold for any element?
+     *
+     * @return bool
+     */
+    public function any() : bool
+    {
+        return $this->count() > 0;
+    }
+
+    /**
+     * Does the mask hold for every element?
+     *
+     * @return bool
+     */
+    public function all() : bool
+    {
+        return $this->count() === $this->size();
+    }
+
+    /**
+     * Return a mask that holds where both this mask and mask B hold.
+     *
+     * @param \Tensor\Mask $b
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function logicalAnd(Mask $b) : self
+    {
+        $this->checkShape($b);
+
+        $c = [];
+
+        foreach ($b->rows() as $i => $rowB) {
+            $rowA = $this->a[$i];
+
+            $rowC = [];
+
+            foreach ($rowB as $j => $valueB) {
+                $rowC[] = ($rowA[$j] and $valueB);
+            }
+
+            $c[] = $rowC;
+        }
+
+        return new self($c, $this->flat);
+    }
+
+    /**
+     * Return a mask that holds where either this mask or mask B holds.
+     *
+     * @param \Tensor\Mask $b
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function logicalOr(Mask $b) : self
+    {
+        $this->checkShape($b);
+
+        $c = [];
+
+        foreach ($b->rows() as $i => $rowB) {
+            $rowA = $this->a[$i];
+
+            $rowC = [];
+
+            foreach ($rowB as $j => $valueB) {
+                $rowC[] = ($rowA[$j] or $valueB);
+            }
+
+            $c[] = $rowC;
+        }
+
+        return new self($c, $this->flat);
+    }
+
+    /**
+     * Return a mask that holds where this mask does not.
+     *
+     * @return self
+     */
+    public function logicalNot() : self
+    {
+        $c = [];
+
+        foreach ($this->a as $rowA) {
+            $rowC = [];
+
+            foreach ($rowA as $valueA) {
+                $rowC[] = !$valueA;
+            }
+
+            $c[] = $rowC;
+        }
+
+        return new self($c, $this->flat);
+    }
+
+    /**
+     * Return the mask as an array of booleans.
+     *
+     * @return list<bool>|list<list<bool>>
+     */
+    public function asArray() : array
+    {
+        if ($this->flat) {
+            return $this->a[0] ?? [];
+        }
+
+        return $this->a;
+    }
+
+    /**
+     * Return the rows of booleans that back the mask.
+     *
+     * @internal
+     *
+     * @return list<list<bool>>
+     */
+    public function rows() : array
+    {
+        return $this->a;
+    }
+
+    /**
+     * Throw an exception if mask B does not have the same shape as this mask.
+     *
+     * @param \Tensor\Mask $b
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     */
+    protected function checkShape(Mask $b) : void
+    {
+        if ($b->shape() !== $this->shape()) {
+            throw new DimensionalityMismatch("{$this->shapeString()} mask"
+                . " expected but {$b->shapeString()} given.");
+        }
+    }
+}
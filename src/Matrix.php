@@ -108,11 +108,13 @@ class Matrix implements Tensor
      *
      * @param int $m
      * @param int $n
+     * @param int $dtype
+     * @throws InvalidArgumentException
      * @return self
      */
-    public static function zeros(int $m, int $n) : self
+    public static function zeros(int $m, int $n, int $dtype = Dtype::FLOAT64) : self
     {
-        return self::fill(0.0, $m, $n);
+        return self::fill(0.0, $m, $n, $dtype);
     }
 
     /**
@@ -120,11 +122,13 @@ class Matrix implements Tensor
      *
      * @param int $m
      * @param int $n
+     * @param int $dtype
+     * @throws InvalidArgumentException
      * @return self
      */
-    public static function ones(int $m, int $n) : self
+    public static function ones(int $m, int $n, int $dtype = Dtype::FLOAT64) : self
     {
-        return self::fill(1.0, $m, $n);
+        return self::fill(1.0, $m, $n, $dtype);
     }
 
     /**
@@ -160,10 +164,11 @@ class Matrix implements Tensor
      * @param float $value
      * @param int $m
      * @param int $n
+     * @param int $dtype
      * @throws InvalidArgumentException
      * @return self
      */
-    public static function fill(float $value, int $m, int $n) : self
+    public static function fill(float $value, int $m, int $n, int $dtype = Dtype::FLOAT64) : self
     {
         if ($m < 1) {
             throw new InvalidArgumentException('M must be'
@@ -175,6 +180,8 @@ class Matrix implements Tensor
                 . " greater than 0, $n given.");
         }
 
+        Dtype::check($dtype);
+
         return self::quick(array_fill(0, $m, array_fill(0, $n, $value)));
     }
 
@@ -183,10 +190,11 @@ class Matrix implements Tensor
      *
      * @param int $m
      * @param int $n
+     * @param \Tensor\Random|null $generator
      * @throws InvalidArgumentException
      * @return self
      */
-    public static function rand(int $m, int $n) : self
+    public static function rand(int $m, int $n, ?Random $generator = null) : self
     {
         if ($m < 1) {
             throw new InvalidArgumentException('M must be'
@@ -206,7 +214,7 @@ class Matrix implements Tensor
             $rowA = [];
 
             while (count($rowA) < $n) {
-                $rowA[] = rand() / $max;
+                $rowA[] = $generator ? $generator->next() : rand() / $max;
             }
 
             $a[] = $rowA;
@@ -220,10 +228,11 @@ class Matrix implements Tensor
      *
      * @param int $m
      * @param int $n
+     * @param \Tensor\Random|null $generator
      * @throws InvalidArgumentException
      * @return self
      */
-    public static function gaussian(int $m, int $n) : self
+    public static function gaussian(int $m, int $n, ?Random $generator = null) : self
     {
         if ($m < 1) {
             throw new InvalidArgumentException('M must be'
@@ -247,9 +256,9 @@ class Matrix implements Tensor
             }
 
             while (count($rowA) < $n) {
-                $r = sqrt(-2.0 * log(rand() / $max));
+                $r = sqrt(-2.0 * log($generator ? 1.0 - $generator->next() : rand() / $max));
 
-                $phi = rand() / $max * TWO_PI;
+                $phi = ($generator ? $generator->next() : rand() / $max) * TWO_PI;
 
                 $rowA[] = $r * sin($phi);
                 $rowA[] = $r * cos($phi);
@@ -271,10 +280,11 @@ class Matrix implements Tensor
      * @param int $m
      * @param int $n
      * @param float $lambda
+     * @param \Tensor\Random|null $generator
      * @throws InvalidArgumentException
      * @return self
      */
-    public static function poisson(int $m, int $n, float $lambda = 1.0) : self
+    public static function poisson(int $m, int $n, float $lambda = 1.0, ?Random $generator = null) : self
     {
         if ($m < 1) {
             throw new InvalidArgumentException('M must be'
@@ -302,7 +312,7 @@ class Matrix implements Tensor
                 while ($p > $l) {
                     ++$k;
 
-                    $p *= rand() / $max;
+                    $p *= $generator ? $generator->next() : rand() / $max;
                 }
 
                 $rowA[] = $k - 1.0;
@@ -319,10 +329,11 @@ class Matrix implements Tensor
      *
      * @param int $m
      * @param int $n
+     * @param \Tensor\Random|null $generator
      * @throws InvalidArgumentException
      * @return self
      */
-    public static function uniform(int $m, int $n) : self
+    public static function uniform(int $m, int $n, ?Random $generator = null) : self
     {
         if ($m < 1) {
             throw new InvalidArgumentException('M must be'
@@ -342,7 +353,7 @@ class Matrix implements Tensor
             $rowA = [];
 
             while (count($rowA) < $n) {
-                $rowA[] = rand(-$max, $max) / $max;
+                $rowA[] = $generator ? 2.0 * $generator->next() - 1.0 : rand(-$max, $max) / $max;
             }
 
             $a[] = $rowA;
@@ -351,6 +362,148 @@ class Matrix implements Tensor
         return self::quick($a);
     }
 
+    /**
+     * Return a mask of ones with probability p and zeros otherwise such as for dropout.
+     *
+     * @param int $m
+     * @param int $n
+     * @param float $p
+     * @param \Tensor\Random|null $generator
+     * @throws InvalidArgumentException
+     * @return self
+     */
+    public static function bernoulli(int $m, int $n, float $p = 0.5, ?Random $generator = null) : self
+    {
+        if ($m < 1) {
+            throw new InvalidArgumentException('M must be'
+                . " greater than 0, $m given.");
+        }
+
+        if ($n < 1) {
+            throw new InvalidArgumentException('N must be'
+                . " greater than 0, $n given.");
+        }
+
+        if ($p < 0.0 or $p > 1.0) {
+            throw new InvalidArgumentException('Probability must be'
+                . " between 0 and 1, $p given.");
+        }
+
+        $max = getrandmax();
+
+        $a = [];
+
+        while (count($a) < $m) {
+            $rowA = [];
+
+            while (count($rowA) < $n) {
+                $rowA[] = ($generator ? $generator->next() : rand() / $max) < $p ? 1.0 : 0.0;
+            }
+
+            $a[] = $rowA;
+        }
+
+        return self::quick($a);
+    }
+
+    /**
+     * Return a normally distributed random matrix with values redrawn until they are within two
+     * standard deviations of the mean.
+     *
+     * @param int $m
+     * @param int $n
+     * @param float $mean
+     * @param float $std
+     * @param \Tensor\Random|null $generator
+     * @throws InvalidArgumentException
+     * @return self
+     */
+    public static function truncatedNormal(int $m, int $n, float $mean = 0.0, float $std = 1.0, ?Random $generator = null) : self
+    {
+        if ($m < 1) {
+            throw new InvalidArgumentException('M must be'
+                . " greater than 0, $m given.");
+        }
+
+        if ($n < 1) {
+            throw new InvalidArgumentException('N must be'
+                . " greater than 0, $n given.");
+        }
+
+        if ($std < 0.0) {
+            throw new InvalidArgumentException('Standard deviation'
+                . " must be greater than 0, $std given.");
+        }
+
+        $a = [];
+
+        while (count($a) < $m) {
+            $a[] = Vector::truncatedNormal($n, $mean, $std, $generator)->asArray();
+        }
+
+        return self::quick($a);
+    }
+
+    /**
+     * Return a m x n weight matrix initialized with the method of Glorot and Bengio which scales
+     * the values by the number of inputs and outputs.
+     *
+     * @param int $m
+     * @param int $n
+     * @param bool $normal
+     * @param \Tensor\Random|null $generator
+     * @throws InvalidArgumentException
+     * @return self
+     */
+    public static function glorot(int $m, int $n, bool $normal = false, ?Random $generator = null) : self
+    {
+        if ($m < 1) {
+            throw new InvalidArgumentException('M must be'
+                . " greater than 0, $m given.");
+        }
+
+        if ($n < 1) {
+            throw new InvalidArgumentException('N must be'
+                . " greater than 0, $n given.");
+        }
+
+        if ($normal) {
+            return self::gaussian($m, $n, $generator)->multiplyScalar(sqrt(2.0 / ($m + $n)));
+        }
+
+        return self::uniform($m, $n, $generator)->multiplyScalar(sqrt(6.0 / ($m + $n)));
+    }
+
+    /**
+     * Return a m x n weight matrix initialized with the method of He et al. which scales the
+     * values by the number of inputs n.
+     *
+     * @param int $m
+     * @param int $n
+     * @param bool $normal
+     * @param \Tensor\Random|null $generator
+     * @throws InvalidArgumentException
+     * @return self
+     */
+    public static function he(int $m, int $n, bool $normal = false, ?Random $generator = null) : self
+    {
+        if ($m < 1) {
+            throw new InvalidArgumentException('M must be'
+                . " greater than 0, $m given.");
+        }
+
+        if ($n < 1) {
+            throw new InvalidArgumentException('N must be'
+                . " greater than 0, $n given.");
+        }
+
+        if ($normal) {
+            return self::gaussian($m, $n, $generator)->multiplyScalar(sqrt(2.0 / $n));
+        }
+
+        return self::uniform($m, $n, $generator)->multiplyScalar(sqrt(6.0 / $n));
+    }
+
     /**
      * @param array<array<int|float>> $a
      * @param bool $validate
@@ -426,6 +579,32 @@ class Matrix implements Tensor
         return $this->m * $this->n;
     }
 
+    /**
+     * Return the precision that the elements of the matrix are stored in. The PHP implementation
+     * always stores doubles.
+     *
+     * @return int
+     */
+    public function dtype() : int
+    {
+        return Dtype::FLOAT64;
+    }
+
+    /**
+     * Return a copy of the matrix with its elements converted to the given dtype. The PHP
+     * implementation keeps the elements in double precision.
+     *
+     * @param int $dtype
+     * @throws InvalidArgumentException
+     * @return self
+     */
+    public function asType(int $dtype) : self
+    {
+        Dtype::check($dtype);
+
+        return self::quick($this->a);
+    }
+
     /**
      * Return the number of rows in the matrix.
      *
@@ -536,6 +715,16 @@ class Matrix implements Tensor
         return Vector::quick(array_merge(...$this->a));
     }
 
+    /**
+     * Begin a fused expression of element-wise operations over the matrix.
+     *
+     * @return \Tensor\Expression
+     */
+    public function expr() : Expression
+    {
+        return new Expression($this);
+    }
+
     /**
      * Run a function over all of the elements in the matrix.
      *
@@ -758,6 +947,61 @@ class Matrix implements Tensor
         return self::quick($c);
     }
 
+    /**
+     * General matrix-matrix product i.e. alpha * op(A) * op(B) + beta * C where op() optionally
+     * transposes its operand. If matrix C is given then it is updated in place and returned,
+     * otherwise the product is returned as a new matrix and beta is ignored.
+     *
+     * @param \Tensor\Matrix $b
+     * @param bool $transA
+     * @param bool $transB
+     * @param float $alpha
+     * @param float $beta
+     * @param \Tensor\Matrix|null $c
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function gemm(Matrix $b, bool $transA = false, bool $transB = false, float $alpha = 1.0, float $beta = 0.0, ?Matrix $c = null) : self
+    {
+        $a = $transA ? $this->transpose() : $this;
+        $b = $transB ? $b->transpose() : $b;
+
+        $product = $a->matmul($b);
+
+        if ($alpha != 1.0) {
+            $product = $product->multiplyScalar($alpha);
+        }
+
+        if (!$c) {
+            return $product;
+        }
+
+        if ($c->shape() !== $product->shape()) {
+            throw new DimensionalityMismatch("{$product->shapeString()} matrix"
+                . " expected but {$c->shapeString()} given.");
+        }
+
+        if ($beta != 0.0) {
+            $product = $product->addMatrix($c->multiplyScalar($beta));
+        }
+
+        $c->a = $product->asArray();
+
+        return $c;
+    }
+
+    /**
+     * Return the Gram matrix alpha * A * A^T, or alpha * A^T * A if trans is true.
+     *
+     * @param bool $trans
+     * @param float $alpha
+     * @return self
+     */
+    public function gram(bool $trans = false, float $alpha = 1.0) : self
+    {
+        return $this->gemm($this, $trans, !$trans, $alpha);
+    }
+
     /**
      * Compute the dot product of this matrix and a vector.
      *
@@ -772,7 +1016,99 @@ class Matrix implements Tensor
                 . " {$this->n} elements but Vector B has {$b->size()}.");
         }
 
-        return $this->matmul($b->asColumnMatrix())->columnAsVector(0);
+        $bHat = $b->asArray();
+
+        $c = [];
+
+        foreach ($this->a as $rowA) {
+            $sigma = 0.0;
+
+            foreach ($rowA as $j => $valueA) {
+                $sigma += $valueA * $bHat[$j];
+            }
+
+            $c[] = $sigma;
+        }
+
+        return ColumnVector::quick($c);
+    }
+
+    /**
+     * Return the matrix of distances between every row of this matrix and every row of matrix B
+     * under the given metric i.e. euclidean, cosine, or manhattan.
+     *
+     * @param Matrix $b
+     * @param string $metric
+     * @throws InvalidArgumentException
+     * @throws DimensionalityMismatch
+     * @return self
+     */
+    public function pairwiseDistances(Matrix $b, string $metric = 'euclidean') : self
+    {
+        if (!in_array($metric, ['euclidean', 'cosine', 'manhattan'])) {
+            throw new InvalidArgumentException('Metric must be euclidean,'
+                . " cosine, or manhattan, $metric given.");
+        }
+
+        if ($this->n !== $b->n()) {
+            throw new DimensionalityMismatch('Matrix A expects'
+                . " {$this->n} columns but Matrix B has {$b->n()}.");
+        }
+
+        $bHat = $b->asArray();
+
+        $c = [];
+
+        foreach ($this->a as $rowA) {
+            $rowC = [];
+
+            foreach ($bHat as $rowB) {
+                $sigma = $dot = $normA = $normB = 0.0;
+
+                foreach ($rowA as $j => $valueA) {
+                    $valueB = $rowB[$j];
+
+                    switch ($metric) {
+                        case 'manhattan':
+                            $sigma += abs($valueA - $valueB);
+
+                            break;
+
+                        case 'cosine':
+                            $dot += $valueA * $valueB;
+                            $normA += $valueA ** 2;
+                            $normB += $valueB ** 2;
+
+                            break;
+
+                        default:
+                            $sigma += ($valueA - $valueB) ** 2;
+                    }
+                }
+
+                switch ($metric) {
+                    case 'manhattan':
+                        $rowC[] = $sigma;
+
+                        break;
+
+                    case 'cosine':
+                        $normA = $normA > 0.0 ? sqrt($normA) : 1.0;
+                        $normB = $normB > 0.0 ? sqrt($normB) : 1.0;
+
+                        $rowC[] = max(0.0, min(2.0, 1.0 - $dot / ($normA * $normB)));
+
+                        break;
+
+                    default:
+                        $rowC[] = sqrt($sigma);
+                }
+            }
+
+            $c[] = $rowC;
+        }
+
+        return self::quick($c);
     }
 
     /**
@@ -907,7 +1243,7 @@ class Matrix implements Tensor
      */
     public function l1Norm() : float
     {
-        return $this->transpose()->abs()->sum()->max();
+        return $this->abs()->sum(0)->max();
     }
 
     /**
@@ -1344,6 +1680,190 @@ class Matrix implements Tensor
             . ' matrix to the given input.');
     }
 
+    /**
+     * Compare this matrix to another tensor or a scalar element-wise and return a mask that holds
+     * where the comparison does. The comparison is one of ==, !=, >, >=, <, or <=.
+     *
+     * @param mixed $b
+     * @param string $comparison
+     * @throws InvalidArgumentException
+     * @throws DimensionalityMismatch
+     * @return \Tensor\Mask
+     */
+    public function compare($b, string $comparison) : Mask
+    {
+        $op = Mask::comparison($comparison);
+
+        switch (gettype($b)) {
+            case 'object':
+                switch (true) {
+                    case $b instanceof Matrix:
+                        if ($b->shape() !== $this->shape()) {
+                            throw new DimensionalityMismatch("{$this->shapeString()} matrix"
+                                . " expected but {$b->shapeString()} given.");
+                        }
+
+                        $c = [];
+
+                        foreach ($b->asArray() as $i => $rowB) {
+                            $rowA = $this->a[$i];
+
+                            $rowC = [];
+
+                            foreach ($rowA as $j => $valueA) {
+                                $rowC[] = Mask::holds($valueA, $rowB[$j], $op);
+                            }
+
+                            $c[] = $rowC;
+                        }
+
+                        return new Mask($c);
+
+                    case $b instanceof ColumnVector:
+                        if ($b->m() !== $this->m) {
+                            throw new DimensionalityMismatch('Matrix A expects'
+                                . " {$this->m} rows but Vector B has {$b->m()}.");
+                        }
+
+                        $c = [];
+
+                        foreach ($b->asArray() as $i => $valueB) {
+                            $rowC = [];
+
+                            foreach ($this->a[$i] as $valueA) {
+                                $rowC[] = Mask::holds($valueA, $valueB, $op);
+                            }
+
+                            $c[] = $rowC;
+                        }
+
+                        return new Mask($c);
+
+                    case $b instanceof Vector:
+                        if ($b->n() !== $this->n) {
+                            throw new DimensionalityMismatch('Matrix A expects'
+                                . " {$this->n} columns but Vector B has {$b->n()}.");
+                        }
+
+                        $b = $b->asArray();
+
+                        $c = [];
+
+                        foreach ($this->a as $rowA) {
+                            $rowC = [];
+
+                            foreach ($b as $j => $valueB) {
+                                $rowC[] = Mask::holds($rowA[$j], $valueB, $op);
+                            }
+
+                            $c[] = $rowC;
+                        }
+
+                        return new Mask($c);
+                }
+
+                break;
+
+            case 'double':
+            case 'integer':
+                $c = [];
+
+                foreach ($this->a as $rowA) {
+                    $rowC = [];
+
+                    foreach ($rowA as $valueA) {
+                        $rowC[] = Mask::holds($valueA, $b, $op);
+                    }
+
+                    $c[] = $rowC;
+                }
+
+                return new Mask($c);
+        }
+
+        throw new InvalidArgumentException('Cannot compare'
+            . ' matrix to the given input.');
+    }
+
+    /**
+     * Return the elements of this matrix where the mask holds and the elements of matrix or
+     * scalar B everywhere else.
+     *
+     * @param \Tensor\Mask $mask
+     * @param mixed $b
+     * @throws InvalidArgumentException
+     * @throws DimensionalityMismatch
+     * @return self
+     */
+    public function where(Mask $mask, $b) : self
+    {
+        if ($mask->shape() !== $this->shape()) {
+            throw new DimensionalityMismatch("{$this->shapeString()} mask"
+                . " expected but {$mask->shapeString()} given.");
+        }
+
+        if ($b instanceof Matrix) {
+            if ($b->shape() !== $this->shape()) {
+                throw new DimensionalityMismatch("{$this->shapeString()} matrix"
+                    . " expected but {$b->shapeString()} given.");
+            }
+
+            $b = $b->asArray();
+        } elseif (!is_int($b) and !is_float($b)) {
+            throw new InvalidArgumentException('Cannot select from'
+                . ' matrix and the given input.');
+        }
+
+        $c = [];
+
+        foreach ($mask->rows() as $i => $rowMask) {
+            $rowA = $this->a[$i];
+
+            $rowC = [];
+
+            foreach ($rowMask as $j => $holds) {
+                $rowC[] = $holds ? $rowA[$j] : (float) (is_array($b) ? $b[$i][$j] : $b);
+            }
+
+            $c[] = $rowC;
+        }
+
+        return self::quick($c);
+    }
+
+    /**
+     * Return the sum of each row of the matrix over the elements where the mask holds.
+     *
+     * @param \Tensor\Mask $mask
+     * @throws DimensionalityMismatch
+     * @return \Tensor\ColumnVector
+     */
+    public function maskedSum(Mask $mask) : ColumnVector
+    {
+        if ($mask->shape() !== $this->shape()) {
+            throw new DimensionalityMismatch("{$this->shapeString()} mask"
+                . " expected but {$mask->shapeString()} given.");
+        }
+
+        $b = [];
+
+        foreach ($mask->rows() as $i => $rowMask) {
+            $rowA = $this->a[$i];
+
+            $sigma = 0.0;
+
+            foreach ($rowMask as $j => $holds) {
+                if ($holds) {
+                    $sigma += $rowA[$j];
+                }
+            }
+
+            $b[] = $sigma;
+        }
+
+        return ColumnVector::quick($b);
+    }
+
     /**
      * Return the element-wise reciprocal of the matrix.
      *
@@ -1519,54 +2039,133 @@ class Matrix implements Tensor
     }
 
     /**
-     * Sum the rows of the matrix and return a vector.
+     * Sum the matrix along an axis and return a vector. Axis 1 sums each row into a column vector
+     * and axis 0 sums each column into a vector.
      *
-     * @return ColumnVector
+     * @param int $axis
+     * @throws InvalidArgumentException
+     * @return Vector
      */
-    public function sum() : ColumnVector
+    public function sum(int $axis = 1) : Vector
     {
-        return ColumnVector::quick(array_map('array_sum', $this->a));
+        return $this->axisVector(array_map('array_sum', $this->axisRows($axis)), $axis);
     }
 
     /**
-     * Calculate the row product of the matrix.
+     * Calculate the product of the matrix along an axis.
      *
-     * @return ColumnVector
+     * @param int $axis
+     * @throws InvalidArgumentException
+     * @return Vector
      */
-    public function product() : ColumnVector
+    public function product(int $axis = 1) : Vector
     {
-        return ColumnVector::quick(array_map('array_product', $this->a));
+        return $this->axisVector(array_map('array_product', $this->axisRows($axis)), $axis);
     }
 
     /**
-     * Return the minimum of each row in the matrix.
+     * Return the minimum of the matrix along an axis.
      *
-     * @return ColumnVector
+     * @param int $axis
+     * @throws InvalidArgumentException
+     * @return Vector
      */
-    public function min() : ColumnVector
+    public function min(int $axis = 1) : Vector
     {
-        return ColumnVector::quick(array_map('min', $this->a));
+        return $this->axisVector(array_map('min', $this->axisRows($axis)), $axis);
     }
 
     /**
-     * Return the maximum of each row in the matrix.
+     * Return the maximum of the matrix along an axis.
      *
-     * @return ColumnVector
+     * @param int $axis
+     * @throws InvalidArgumentException
+     * @return Vector
      */
-    public function max() : ColumnVector
+    public function max(int $axis = 1) : Vector
     {
-        return ColumnVector::quick(array_map('max', $this->a));
+        return $this->axisVector(array_map('max', $this->axisRows($axis)), $axis);
     }
 
     /**
-     * Compute the means of each row and return them in a vector.
+     * Return the offset of the minimum of the matrix along an axis.
      *
+     * @param int $axis
      * @throws InvalidArgumentException
-     * @return ColumnVector
+     * @return list<int>
      */
-    public function mean() : ColumnVector
+    public function argmin(int $axis = 1) : array
     {
-        return $this->sum()->divideScalar($this->n);
+        $b = [];
+
+        foreach ($this->axisRows($axis) as $rowA) {
+            $b[] = (int) array_search(min($rowA), $rowA);
+        }
+
+        return $b;
+    }
+
+    /**
+     * Return the offset of the maximum of the matrix along an axis.
+     *
+     * @param int $axis
+     * @throws InvalidArgumentException
+     * @return list<int>
+     */
+    public function argmax(int $axis = 1) : array
+    {
+        $b = [];
+
+        foreach ($this->axisRows($axis) as $rowA) {
+            $b[] = (int) array_search(max($rowA), $rowA);
+        }
+
+        return $b;
+    }
+
+    /**
+     * Return the k largest or smallest values of each row in rank order along with their column offsets.
+     *
+     * @param int $k
+     * @param bool $largest
+     * @throws InvalidArgumentException
+     * @return array{self,list<list<int>>}
+     */
+    public function topK(int $k, bool $largest = true) : array
+    {
+        if ($k < 1 or $k > $this->n) {
+            throw new InvalidArgumentException('K must be between 1'
+                . " and {$this->n}, $k given.");
+        }
+
+        $values = $indices = [];
+
+        foreach ($this->a as $rowA) {
+            if ($largest) {
+                arsort($rowA);
+            } else {
+                asort($rowA);
+            }
+
+            $top = array_slice($rowA, 0, $k, true);
+
+            $values[] = array_values($top);
+            $indices[] = array_keys($top);
+        }
+
+        return [self::quick($values), $indices];
+    }
+
+    /**
+     * Compute the means of the matrix along an axis and return them in a vector.
+     *
+     * @param int $axis
+     * @throws InvalidArgumentException
+     * @return Vector
+     */
+    public function mean(int $axis = 1) : Vector
+    {
+        return $this->sum($axis)->divideScalar($axis === 0 ? $this->m : $this->n);
     }
 
     /**
@@ -1659,6 +2258,37 @@ class Matrix implements Tensor
         return ColumnVector::quick($b);
     }
 
+    /**
+     * Return several quantiles of each row at once. Column j of the result holds the q[j]'th
+     * quantile of every row.
+     *
+     * @param list<float> $q
+     * @throws InvalidArgumentException
+     * @return self
+     */
+    public function quantiles(array $q) : self
+    {
+        if (empty($q)) {
+            throw new InvalidArgumentException('At least one'
+                . ' quantile must be given.');
+        }
+
+        foreach ($q as $value) {
+            if (!is_numeric($value) or $value < 0.0 or $value > 1.0) {
+                throw new InvalidArgumentException('Q must be between'
+                    . " 0 and 1, $value given.");
+            }
+        }
+
+        $b = [];
+
+        foreach ($this->a as $rowA) {
+            $b[] = Vector::quick($rowA)->quantiles($q);
+        }
+
+        return self::quick($b);
+    }
+
     /**
      * Compute the covariance matrix.
      *
@@ -1679,8 +2309,7 @@ class Matrix implements Tensor
 
         $b = $this->subtractColumnVector($mean);
 
-        return $b->matmul($b->transpose())
-            ->divideScalar($this->m);
+        return $b->gram(false, 1.0 / $this->m);
     }
 
     /**
@@ -3238,6 +3867,94 @@ class Matrix implements Tensor
         return self::quick($c);
     }
 
+    /**
+     * Add a matrix to this matrix in place. Every reference to this matrix observes the change.
+     *
+     * @param \Tensor\Matrix $b
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function addMatrixInPlace(Matrix $b) : self
+    {
+        return $this->axpy(1.0, $b);
+    }
+
+    /**
+     * Subtract a matrix from this matrix in place.
+     *
+     * @param \Tensor\Matrix $b
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function subtractMatrixInPlace(Matrix $b) : self
+    {
+        return $this->axpy(-1.0, $b);
+    }
+
+    /**
+     * Add alpha times matrix X to this matrix in place i.e. A = alpha * X + A.
+     *
+     * @param float $alpha
+     * @param \Tensor\Matrix $x
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function axpy(float $alpha, Matrix $x) : self
+    {
+        if ($x->shape() !== $this->shape()) {
+            throw new DimensionalityMismatch("{$this->shapeString()} matrix"
+                . " expected but {$x->shapeString()} given.");
+        }
+
+        foreach ($x->asArray() as $i => $rowX) {
+            foreach ($rowX as $j => $valueX) {
+                $this->a[$i][$j] += $alpha * $valueX;
+            }
+        }
+
+        return $this;
+    }
+
+    /**
+     * Multiply this matrix by a scalar in place.
+     *
+     * @param float $b
+     * @return self
+     */
+    public function multiplyScalarInPlace(float $b) : self
+    {
+        foreach ($this->a as $i => $rowA) {
+            foreach ($rowA as $j => $valueA) {
+                $this->a[$i][$j] = $valueA * $b;
+            }
+        }
+
+        return $this;
+    }
+
+    /**
+     * Clip the elements of this matrix to a given range in place.
+     *
+     * @param float $min
+     * @param float $max
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return self
+     */
+    public function clipInPlace(float $min, float $max) : self
+    {
+        if ($min > $max) {
+            throw new InvalidArgumentException('Minimum cannot be greater than maximum.');
+        }
+
+        foreach ($this->a as $i => $rowA) {
+            foreach ($rowA as $j => $valueA) {
+                $this->a[$i][$j] = max($min, min($max, $valueA));
+            }
+        }
+
+        return $this;
+    }
+
     /**
      * Return the element-wise equality comparison of this matrix and a scalar.
      *
@@ -3442,4 +4159,38 @@ class Matrix implements Tensor
             yield Vector::quick($row);
         }
     }
+
+    /**
+     * Return the rows to reduce along the given axis. Axis 1 reduces each row and axis 0 reduces
+     * each column.
+     *
+     * @param int $axis
+     * @throws InvalidArgumentException
+     * @return list<list<float>>
+     */
+    protected function axisRows(int $axis) : array
+    {
+        switch ($axis) {
+            case 0:
+                return $this->transpose()->asArray();
+
+            case 1:
+                return $this->a;
+        }
+
+        throw new InvalidArgumentException("Axis must be 0 or 1, $axis given.");
+    }
+
+    /**
+     * Wrap the result of a reduction along the given axis in a vector. Reducing each row yields
+     * a column vector and reducing each column yields a row vector.
+     *
+     * @param list<float> $b
+     * @param int $axis
+     * @return Vector
+     */
+    protected function axisVector(array $b, int $axis) : Vector
+    {
+        return $axis === 1 ? ColumnVector::quick($b) : Vector::quick($b);
+    }
 }
@@ -0,0 +1,207 @@
+<?php
+
+namespace Tensor;
+
+/**
+ * Random
+ *
+ * A seedable random number generator for the random factories of Matrix and Vector. Generators
+ * with the same seed produce the same sequence of tensors. Independent streams for parallel work
+ * are handed out with split(), which never overlap with each other or with the parent.
+ *
+ * The PHP implementation uses xoshiro128** since PHP has no unsigned 64-bit arithmetic, so a seed
+ * reproduces the same tensors within an implementation but not between PHP and the extension.
+ *
+ * @category    Scientific Computing
+ * @package     Rubix/Tensor
+ * @author      Andrew DalPino
+ */
+class Random
+{
+    /**
+     * The mask of the lower 32 bits of an integer.
+     *
+     * @var int
+     */
+    protected const MASK = 0xFFFFFFFF;
+
+    /**
+     * The polynomial that advances the generator by 2^64 draws.
+     *
+     * @var list<int>
+     */
+    protected const JUMP = [0x8764000B, 0xF542D2D3, 0x6FA035C3, 0x77F2DB5B];
+
+    /**
+     * The seed that the generator was started with.
+     *
+     * @var int
+     */
+    protected $seed;
+
+    /**
+     * The four 32-bit words of the generator state.
+     *
+     * @var list<int>
+     */
+    protected $state;
+
+    /**
+     * @param int|null $seed
+     */
+    public function __construct(?int $seed = null)
+    {
+        if ($seed === null) {
+            $seed = random_int(PHP_INT_MIN, PHP_INT_MAX);
+        }
+
+        $low = $seed & self::MASK;
+        $high = ($seed >> 32) & self::MASK;
+
+        $state = [];
+
+        for ($i = 1; $i <= 4; ++$i) {
+            $low = ($low + 0x9E3779B9) & self::MASK;
+
+            $state[] = self::mix(self::mix($low) ^ $high);
+        }
+
+        if ($state === [0, 0, 0, 0]) {
+            $state[0] = 1;
+        }
+
+        $this->seed = $seed;
+        $this->state = $state;
+    }
+
+    /**
+     * Return the seed that the generator was started with.
+     *
+     * @return int
+     */
+    public function seed() : int
+    {
+        return $this->seed;
+    }
+
+    /**
+     * Advance the generator by 2^64 draws.
+     *
+     * @return self
+     */
+    public function jump() : self
+    {
+        $jumped = [0, 0, 0, 0];
+
+        foreach (self::JUMP as $word) {
+            for ($b = 0; $b < 32; ++$b) {
+                if ($word & (1 << $b)) {
+                    foreach ($this->state as $i => $value) {
+                        $jumped[$i] ^= $value;
+                    }
+                }
+
+                $this->next32();
+            }
+        }
+
+        $this->state = $jumped;
+
+        return $this;
+    }
+
+    /**
+     * Return a generator that continues the current stream and jump this generator ahead so
+     * that the two never draw the same numbers. Calling split() repeatedly hands out one stream
+     * per worker.
+     *
+     * @return self
+     */
+    public function split() : self
+    {
+        $child = clone $this;
+
+        $this->jump();
+
+        return $child;
+    }
+
+    /**
+     * Draw a uniform random number between 0 and 1 with 53 bits of precision.
+     *
+     * @internal
+     *
+     * @return float
+     */
+    public function next() : float
+    {
+        $a = $this->next32() >> 5;
+        $b = $this->next32() >> 6;
+
+        return ($a * 67108864 + $b) / 9007199254740992.0;
+    }
+
+    /**
+     * Return the next 32 bits of the stream.
+     *
+     * @return int
+     */
+    protected function next32() : int
+    {
+        [$s0, $s1, $s2, $s3] = $this->state;
+
+        $result = (self::rotate(($s1 * 5) & self::MASK, 7) * 9) & self::MASK;
+
+        $t = ($s1 << 9) & self::MASK;
+
+        $s2 ^= $s0;
+        $s3 ^= $s1;
+        $s1 ^= $s2;
+        $s0 ^= $s3;
+        $s2 ^= $t;
+
+        $s3 = self::rotate($s3, 11);
+
+        $this->state = [$s0, $s1, $s2, $s3];
+
+        return $result;
+    }
+
+    /**
+     * Rotate a 32-bit word left by k bits.
+     *
+     * @param int $x
+     * @param int $k
+     * @return int
+     */
+    protected static function rotate(int $x, int $k) : int
+    {
+        return (($x << $k) | ($x >> (32 - $k))) & self::MASK;
+    }
+
+    /**
+     * Scramble the bits of a 32-bit word with the finalizer of MurmurHash3.
+     *
+     * @param int $x
+     * @return int
+     */
+    protected static function mix(int $x) : int
+    {
+        $x = self::multiply($x ^ ($x >> 16), 0x85EBCA6B);
+        $x = self::multiply($x ^ ($x >> 13), 0xC2B2AE35);
+
+        return $x ^ ($x >> 16);
+    }
+
+    /**
+     * Multiply two 32-bit words modulo 2^32 without overflowing into a float.
+     *
+     * @param int $a
+     * @param int $b
+     * @return int
+     */
+    protected static function multiply(int $a, int $b) : int
+    {
+        return ($a * ($b & 0xFFFF) + ((($a * ($b >> 16)) & 0xFFFF) << 16)) & self::MASK;
+    }
+}
@@ -0,0 +1,205 @@
+<?php
+
+namespace Tensor;
+
+use Tensor\Exceptions\InvalidArgumentException;
+use Tensor\Exceptions\DimensionalityMismatch;
+
+/**
+ * Running Stats
+ *
+ * Streaming column means and variances that are updated one chunk of samples at a time in a
+ * single pass using Welford's method. Partial states computed over separate chunks can be merged
+ * with Chan's parallel formula and give the same result as reducing all of the samples at once.
+ *
+ * @category    Scientific Computing
+ * @package     Rubix/Tensor
+ * @author      Andrew DalPino
+ */
+class RunningStats
+{
+    /**
+     * The number of columns i.e. the dimensionality of each sample.
+     *
+     * @var int
+     */
+    protected $n;
+
+    /**
+     * The number of samples that have been observed so far.
+     *
+     * @var int
+     */
+    protected $count = 0;
+
+    /**
+     * The running mean of each column.
+     *
+     * @var list<float>
+     */
+    protected $mean;
+
+    /**
+     * The running sum of squared deviations from the mean of each column.
+     *
+     * @var list<float>
+     */
+    protected $m2;
+
+    /**
+     * @param int $n
+     * @throws InvalidArgumentException
+     */
+    public function __construct(int $n)
+    {
+        if ($n < 1) {
+            throw new InvalidArgumentException('The number of columns'
+                . " must be greater than 0, $n given.");
+        }
+
+        $this->n = $n;
+        $this->mean = $this->m2 = array_fill(0, $n, 0.0);
+    }
+
+    /**
+     * Return the number of columns.
+     *
+     * @return int
+     */
+    public function n() : int
+    {
+        return $this->n;
+    }
+
+    /**
+     * Return the number of samples that have been observed so far.
+     *
+     * @return int
+     */
+    public function count() : int
+    {
+        return $this->count;
+    }
+
+    /**
+     * Update the statistics with a chunk of samples given as the rows of a matrix or a single sample given as a vector.
+     *
+     * @param Matrix|Vector $a
+     * @throws InvalidArgumentException
+     * @throws DimensionalityMismatch
+     * @return self
+     */
+    public function update($a) : self
+    {
+        switch (true) {
+            case $a instanceof Matrix:
+                $samples = $a->asArray();
+
+                break;
+
+            case $a instanceof Vector:
+                $samples = [$a->asArray()];
+
+                break;
+
+            default:
+                throw new InvalidArgumentException('Cannot update running'
+                    . ' stats with the given input.');
+        }
+
+        $n = $a instanceof Matrix ? $a->n() : $a->size();
+
+        if ($n !== $this->n) {
+            throw new DimensionalityMismatch('Running stats require'
+                . " {$this->n} columns but $n given.");
+        }
+
+        $mean = $m2 = array_fill(0, $this->n, 0.0);
+
+        foreach ($samples as $i => $sample) {
+            $inverse = 1.0 / ($i + 1);
+
+            foreach ($sample as $j => $value) {
+                $delta = $value - $mean[$j];
+
+                $mean[$j] += $delta * $inverse;
+                $m2[$j] += $delta * ($value - $mean[$j]);
+            }
+        }
+
+        $this->combine($mean, $m2, count($samples));
+
+        return $this;
+    }
+
+    /**
+     * Merge the partial statistics of another running stats object into this one.
+     *
+     * @param RunningStats $b
+     * @throws DimensionalityMismatch
+     * @return self
+     */
+    public function merge(RunningStats $b) : self
+    {
+        if ($b->n() !== $this->n) {
+            throw new DimensionalityMismatch('Running stats require'
+                . " {$this->n} columns but {$b->n()} given.");
+        }
+
+        $this->combine($b->mean, $b->m2, $b->count);
+
+        return $this;
+    }
+
+    /**
+     * Return the mean of each column.
+     *
+     * @return Vector
+     */
+    public function mean() : Vector
+    {
+        return Vector::quick($this->mean);
+    }
+
+    /**
+     * Return the population variance of each column.
+     *
+     * @return Vector
+     */
+    public function variance() : Vector
+    {
+        if ($this->count < 1) {
+            return Vector::zeros($this->n);
+        }
+
+        return Vector::quick($this->m2)->divideScalar($this->count);
+    }
+
+    /**
+     * Fold the statistics of another set of samples into this one using Chan's parallel formula.
+     *
+     * @param list<float> $mean
+     * @param list<float> $m2
+     * @param int $count
+     */
+    protected function combine(array $mean, array $m2, int $count) : void
+    {
+        if ($count === 0) {
+            return;
+        }
+
+        $total = $this->count + $count;
+
+        $weight = $count / $total;
+        $scale = ($this->count * $count) / $total;
+
+        foreach ($mean as $j => $valueB) {
+            $delta = $valueB - $this->mean[$j];
+
+            $this->mean[$j] += $delta * $weight;
+            $this->m2[$j] += $m2[$j] + $delta * $delta * $scale;
+        }
+
+        $this->count = $total;
+    }
+}
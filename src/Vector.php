@@ -65,22 +65,26 @@ class Vector implements Tensor
      * Build a vector of zeros with n elements.
      *
      * @param int $n
+     * @param int $dtype
+     * @throws InvalidArgumentException
      * @return self
      */
-    public static function zeros(int $n) : self
+    public static function zeros(int $n, int $dtype = Dtype::FLOAT64) : self
     {
-        return static::fill(0.0, $n);
+        return static::fill(0.0, $n, $dtype);
     }
 
     /**
      * Build a vector of ones with n elements.
      *
      * @param int $n
+     * @param int $dtype
+     * @throws InvalidArgumentException
      * @return self
      */
-    public static function ones(int $n) : self
+    public static function ones(int $n, int $dtype = Dtype::FLOAT64) : self
     {
-        return static::fill(1.0, $n);
+        return static::fill(1.0, $n, $dtype);
     }
 
     /**
@@ -88,16 +92,19 @@ class Vector implements Tensor
      *
      * @param float $value
      * @param int $n
+     * @param int $dtype
      * @throws InvalidArgumentException
      * @return self
      */
-    public static function fill(float $value, int $n) : self
+    public static function fill(float $value, int $n, int $dtype = Dtype::FLOAT64) : self
     {
         if ($n < 1) {
             throw new InvalidArgumentException('Number of elements'
                 . " must be greater than 0, $n given.");
         }
 
+        Dtype::check($dtype);
+
         return static::quick(array_fill(0, $n, $value));
     }
 
@@ -105,10 +112,11 @@ class Vector implements Tensor
      * Return a random uniform vector with values between 0 and 1.
      *
      * @param int $n
+     * @param \Tensor\Random|null $generator
      * @throws InvalidArgumentException
      * @return self
      */
-    public static function rand(int $n) : self
+    public static function rand(int $n, ?Random $generator = null) : self
     {
         if ($n < 1) {
             throw new InvalidArgumentException('Number of elements'
@@ -120,7 +128,7 @@ class Vector implements Tensor
         $a = [];
 
         while (count($a) < $n) {
-            $a[] = rand() / $max;
+            $a[] = $generator ? $generator->next() : rand() / $max;
         }
 
         return static::quick($a);
@@ -131,10 +139,11 @@ class Vector implements Tensor
      * and unit variance.
      *
      * @param int $n
+     * @param \Tensor\Random|null $generator
      * @throws InvalidArgumentException
      * @return self
      */
-    public static function gaussian(int $n) : self
+    public static function gaussian(int $n, ?Random $generator = null) : self
     {
         if ($n < 1) {
             throw new InvalidArgumentException('Number of elements'
@@ -146,9 +155,9 @@ class Vector implements Tensor
         $a = [];
 
         while (count($a) < $n) {
-            $r = sqrt(-2.0 * log(rand() / $max));
+            $r = sqrt(-2.0 * log($generator ? 1.0 - $generator->next() : rand() / $max));
 
-            $phi = rand() / $max * TWO_PI;
+            $phi = ($generator ? $generator->next() : rand() / $max) * TWO_PI;
 
             $a[] = $r * sin($phi);
             $a[] = $r * cos($phi);
@@ -166,10 +175,11 @@ class Vector implements Tensor
      *
      * @param int $n
      * @param float $lambda
+     * @param \Tensor\Random|null $generator
      * @throws InvalidArgumentException
      * @return self
      */
-    public static function poisson(int $n, float $lambda = 1.0) : self
+    public static function poisson(int $n, float $lambda = 1.0, ?Random $generator = null) : self
     {
         if ($n < 1) {
             throw new InvalidArgumentException('Number of elements'
@@ -189,7 +199,7 @@ class Vector implements Tensor
             while ($p > $l) {
                 ++$k;
 
-                $p *= rand() / $max;
+                $p *= $generator ? $generator->next() : rand() / $max;
             }
 
             $a[] = $k - 1.0;
@@ -202,22 +212,160 @@ class Vector implements Tensor
      * Return a uniform random vector with mean 0 and unit variance.
      *
      * @param int $n
+     * @param \Tensor\Random|null $generator
+     * @throws InvalidArgumentException
+     * @return self
+     */
+    public static function uniform(int $n, ?Random $generator = null) : self
+    {
+        if ($n < 1) {
+            throw new InvalidArgumentException('Number of elements'
+                . " must be greater than 0, $n given.");
+        }
+
+        $max = getrandmax();
+
+        $a = [];
+
+        while (count($a) < $n) {
+            $a[] = $generator ? 2.0 * $generator->next() - 1.0 : rand(-$max, $max) / $max;
+        }
+
+        return static::quick($a);
+    }
+
+    /**
+     * Return a mask of ones with probability p and zeros otherwise such as for dropout.
+     *
+     * @param int $n
+     * @param float $p
+     * @param \Tensor\Random|null $generator
+     * @throws InvalidArgumentException
+     * @return self
+     */
+    public static function bernoulli(int $n, float $p = 0.5, ?Random $generator = null) : self
+    {
+        if ($n < 1) {
+            throw new InvalidArgumentException('Number of elements'
+                . " must be greater than 0, $n given.");
+        }
+
+        if ($p < 0.0 or $p > 1.0) {
+            throw new InvalidArgumentException('Probability must be'
+                . " between 0 and 1, $p given.");
+        }
+
+        $max = getrandmax();
+
+        $a = [];
+
+        while (count($a) < $n) {
+            $a[] = ($generator ? $generator->next() : rand() / $max) < $p ? 1.0 : 0.0;
+        }
+
+        return static::quick($a);
+    }
+
+    /**
+     * Return a normally distributed random vector with values redrawn until they are within two
+     * standard deviations of the mean.
+     *
+     * @param int $n
+     * @param float $mean
+     * @param float $std
+     * @param \Tensor\Random|null $generator
+     * @throws InvalidArgumentException
+     * @return self
+     */
+    public static function truncatedNormal(int $n, float $mean = 0.0, float $std = 1.0, ?Random $generator = null) : self
+    {
+        if ($n < 1) {
+            throw new InvalidArgumentException('Number of elements'
+                . " must be greater than 0, $n given.");
+        }
+
+        if ($std < 0.0) {
+            throw new InvalidArgumentException('Standard deviation'
+                . " must be greater than 0, $std given.");
+        }
+
+        $max = getrandmax();
+
+        $a = [];
+
+        while (count($a) < $n) {
+            $r = sqrt(-2.0 * log($generator ? 1.0 - $generator->next() : (rand() + 1) / ($max + 1)));
+
+            $z = $r * cos(($generator ? $generator->next() : rand() / $max) * TWO_PI);
+
+            if (abs($z) <= 2.0) {
+                $a[] = $mean + $std * $z;
+            }
+        }
+
+        return static::quick($a);
+    }
+
+    /**
+     * Draw n category offsets with the probabilities given by a vector of non-negative weights
+     * that do not need to sum to 1.
+     *
+     * @param int $n
+     * @param \Tensor\Vector $probabilities
+     * @param \Tensor\Random|null $generator
      * @throws InvalidArgumentException
      * @return self
      */
-    public static function uniform(int $n) : self
+    public static function categorical(int $n, Vector $probabilities, ?Random $generator = null) : self
     {
         if ($n < 1) {
             throw new InvalidArgumentException('Number of elements'
                 . " must be greater than 0, $n given.");
         }
 
+        if ($probabilities->n() < 1) {
+            throw new InvalidArgumentException('Probabilities'
+                . ' must contain at least 1 element.');
+        }
+
+        if ($probabilities->min() < 0.0) {
+            throw new InvalidArgumentException('Probabilities'
+                . ' must not be negative.');
+        }
+
+        $total = $probabilities->sum();
+
+        if ($total <= 0.0) {
+            throw new InvalidArgumentException('Probabilities'
+                . ' must sum to greater than 0.');
+        }
+
+        $cdf = [];
+
+        $sigma = 0.0;
+
+        foreach ($probabilities as $probability) {
+            $sigma += $probability;
+
+            $cdf[] = $sigma / $total;
+        }
+
+        $k = count($cdf) - 1;
+
         $max = getrandmax();
 
         $a = [];
 
         while (count($a) < $n) {
-            $a[] = rand(-$max, $max) / $max;
+            $u = $generator ? $generator->next() : rand() / ($max + 1);
+
+            $offset = 0;
+
+            while ($offset < $k and $u >= $cdf[$offset]) {
+                ++$offset;
+            }
+
+            $a[] = (float) $offset;
         }
 
         return static::quick($a);
@@ -322,6 +470,32 @@ class Vector implements Tensor
         return $this->n;
     }
 
+    /**
+     * Return the precision that the elements of the vector are stored in. The PHP implementation
+     * always stores doubles.
+     *
+     * @return int
+     */
+    public function dtype() : int
+    {
+        return Dtype::FLOAT64;
+    }
+
+    /**
+     * Return a copy of the vector with its elements converted to the given dtype. The PHP
+     * implementation keeps the elements in double precision.
+     *
+     * @param int $dtype
+     * @throws InvalidArgumentException
+     * @return self
+     */
+    public function asType(int $dtype) : self
+    {
+        Dtype::check($dtype);
+
+        return static::quick($this->a);
+    }
+
     /**
      * Return the number of rows in the vector.
      *
@@ -977,6 +1151,138 @@ class Vector implements Tensor
             . ' vector with the given input.');
     }
 
+    /**
+     * Compare this vector to another tensor or a scalar element-wise and return a mask that holds
+     * where the comparison does. The comparison is one of ==, !=, >, >=, <, or <=.
+     *
+     * @param mixed $b
+     * @param string $comparison
+     * @throws InvalidArgumentException
+     * @throws DimensionalityMismatch
+     * @return \Tensor\Mask
+     */
+    public function compare($b, string $comparison) : Mask
+    {
+        $op = Mask::comparison($comparison);
+
+        switch (gettype($b)) {
+            case 'object':
+                switch (true) {
+                    case $b instanceof Matrix:
+                        if ($this->n !== $b->n()) {
+                            throw new DimensionalityMismatch('Vector A expects'
+                                . " {$this->n} columns but Matrix B has {$b->n()}.");
+                        }
+
+                        $c = [];
+
+                        foreach ($b->asArray() as $rowB) {
+                            $rowC = [];
+
+                            foreach ($this->a as $j => $valueA) {
+                                $rowC[] = Mask::holds($valueA, $rowB[$j], $op);
+                            }
+
+                            $c[] = $rowC;
+                        }
+
+                        return new Mask($c);
+
+                    case $b instanceof Vector:
+                        if ($this->n !== $b->size()) {
+                            throw new DimensionalityMismatch('Vector A requires'
+                                . " {$this->n} elements but Vector B has {$b->size()}.");
+                        }
+
+                        $c = [];
+
+                        foreach ($b->asArray() as $i => $valueB) {
+                            $c[] = Mask::holds($this->a[$i], $valueB, $op);
+                        }
+
+                        return new Mask([$c], true);
+                }
+
+                break;
+
+            case 'double':
+            case 'integer':
+                $c = [];
+
+                foreach ($this->a as $valueA) {
+                    $c[] = Mask::holds($valueA, $b, $op);
+                }
+
+                return new Mask([$c], true);
+        }
+
+        throw new InvalidArgumentException('Cannot compare'
+            . ' vector to the given input.');
+    }
+
+    /**
+     * Return the elements of this vector where the mask holds and the elements of vector or
+     * scalar B everywhere else.
+     *
+     * @param \Tensor\Mask $mask
+     * @param mixed $b
+     * @throws InvalidArgumentException
+     * @throws DimensionalityMismatch
+     * @return self
+     */
+    public function where(Mask $mask, $b) : self
+    {
+        if ($mask->shape() !== $this->shape()) {
+            throw new DimensionalityMismatch("{$this->shapeString()} mask"
+                . " expected but {$mask->shapeString()} given.");
+        }
+
+        if ($b instanceof Vector) {
+            if ($this->n !== $b->size()) {
+                throw new DimensionalityMismatch('Vector A requires'
+                    . " {$this->n} elements but Vector B has {$b->size()}.");
+            }
+
+            $b = $b->asArray();
+        } elseif (!is_int($b) and !is_float($b)) {
+            throw new InvalidArgumentException('Cannot select from'
+                . ' vector and the given input.');
+        }
+
+        $c = [];
+
+        foreach ($mask->asArray() as $i => $holds) {
+            $c[] = $holds ? $this->a[$i] : (float) (is_array($b) ? $b[$i] : $b);
+        }
+
+        return static::quick($c);
+    }
+
+    /**
+     * Return the sum of the elements of the vector where the mask holds.
+     *
+     * @param \Tensor\Mask $mask
+     * @throws DimensionalityMismatch
+     * @return float
+     */
+    public function maskedSum(Mask $mask) : float
+    {
+        if ($mask->shape() !== $this->shape()) {
+            throw new DimensionalityMismatch("{$this->shapeString()} mask"
+                . " expected but {$mask->shapeString()} given.");
+        }
+
+        $sigma = 0.0;
+
+        foreach ($mask->asArray() as $i => $holds) {
+            if ($holds) {
+                $sigma += $this->a[$i];
+            }
+        }
+
+        return $sigma;
+    }
+
     /**
      * Return the reciprocal of the vector element-wise.
      *
@@ -1185,6 +1491,54 @@ class Vector implements Tensor
         return (float) max($this->a);
     }
 
+    /**
+     * Return the offset of the minimum element in the vector.
+     *
+     * @return int
+     */
+    public function argmin() : int
+    {
+        return (int) array_search(min($this->a), $this->a);
+    }
+
+    /**
+     * Return the offset of the maximum element in the vector.
+     *
+     * @return int
+     */
+    public function argmax() : int
+    {
+        return (int) array_search(max($this->a), $this->a);
+    }
+
+    /**
+     * Return the k largest or smallest values of the vector in rank order along with their offsets.
+     *
+     * @param int $k
+     * @param bool $largest
+     * @throws InvalidArgumentException
+     * @return array{static,list<int>}
+     */
+    public function topK(int $k, bool $largest = true) : array
+    {
+        if ($k < 1 or $k > $this->n) {
+            throw new InvalidArgumentException('K must be between 1'
+                . " and {$this->n}, $k given.");
+        }
+
+        $a = $this->a;
+
+        if ($largest) {
+            arsort($a);
+        } else {
+            asort($a);
+        }
+
+        $top = array_slice($a, 0, $k, true);
+
+        return [static::quick(array_values($top)), array_keys($top)];
+    }
+
     /**
      * Return the mean of the vector.
      *
@@ -1246,6 +1600,44 @@ class Vector implements Tensor
         return $t + $remainder * ($a[$xHat] - $t);
     }
 
+    /**
+     * Return several quantiles of the vector at once. The vector is only sorted once for all of them.
+     *
+     * @param list<float> $q
+     * @throws InvalidArgumentException
+     * @return list<float>
+     */
+    public function quantiles(array $q) : array
+    {
+        if (empty($q)) {
+            throw new InvalidArgumentException('At least one'
+                . ' quantile must be given.');
+        }
+
+        $a = $this->a;
+
+        sort($a);
+
+        $b = [];
+
+        foreach ($q as $value) {
+            if (!is_numeric($value) or $value < 0.0 or $value > 1.0) {
+                throw new InvalidArgumentException('Q must be between'
+                    . " 0 and 1, $value given.");
+            }
+
+            $x = $value * ($this->n - 1);
+
+            $xHat = (int) $x;
+
+            $t = $a[$xHat];
+
+            $b[] = $xHat + 1 < $this->n ? $t + ($x - $xHat) * ($a[$xHat + 1] - $t) : $t;
+        }
+
+        return $b;
+    }
+
     /**
      * Return the variance of the vector.
      *
@@ -2155,6 +2547,88 @@ class Vector implements Tensor
         return static::quick($c);
     }
 
+    /**
+     * Add a vector to this vector in place. Every reference to this vector observes the change.
+     *
+     * @param \Tensor\Vector $b
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function addVectorInPlace(Vector $b) : self
+    {
+        return $this->axpy(1.0, $b);
+    }
+
+    /**
+     * Subtract a vector from this vector in place.
+     *
+     * @param \Tensor\Vector $b
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function subtractVectorInPlace(Vector $b) : self
+    {
+        return $this->axpy(-1.0, $b);
+    }
+
+    /**
+     * Add alpha times vector X to this vector in place i.e. A = alpha * X + A.
+     *
+     * @param float $alpha
+     * @param \Tensor\Vector $x
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function axpy(float $alpha, Vector $x) : self
+    {
+        if ($this->n !== $x->size()) {
+            throw new DimensionalityMismatch('Vector A expects'
+                . " {$this->n} elements but Vector B has {$x->size()}.");
+        }
+
+        foreach ($x->asArray() as $i => $valueX) {
+            $this->a[$i] += $alpha * $valueX;
+        }
+
+        return $this;
+    }
+
+    /**
+     * Multiply this vector by a scalar in place.
+     *
+     * @param float $b
+     * @return self
+     */
+    public function multiplyScalarInPlace(float $b) : self
+    {
+        foreach ($this->a as $i => $valueA) {
+            $this->a[$i] = $valueA * $b;
+        }
+
+        return $this;
+    }
+
+    /**
+     * Clip the elements of this vector to a given range in place.
+     *
+     * @param float $min
+     * @param float $max
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return self
+     */
+    public function clipInPlace(float $min, float $max) : self
+    {
+        if ($min > $max) {
+            throw new InvalidArgumentException('Minimum cannot be greater than maximum.');
+        }
+
+        foreach ($this->a as $i => $valueA) {
+            $this->a[$i] = max($min, min($max, $valueA));
+        }
+
+        return $this;
+    }
+
     /**
      * Return the element-wise equality comparison of this vector and a scalar.
      *
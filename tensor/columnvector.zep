@@ -63,7 +63,7 @@ class ColumnVector extends Vector
      */
     public function transpose()
     {
-        return Vector::quick(this->a);
+        return Vector::quick(this->asArray());
     }
 
     /**
@@ -77,6 +77,33 @@ class ColumnVector extends Vector
         return this->asColumnMatrix()->matmul(b);
     }
 
+    /**
+     * Compare this column vector to another tensor or a scalar element-wise and return a mask
+     * that holds where the comparison does. The comparison is one of ==, !=, >, >=, <, or <=.
+     *
+     * @param mixed b
+     * @param string comparison
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return \Tensor\Mask
+     */
+    public function compare(const var b, const string comparison) -> <Mask>
+    {
+        if b instanceof Matrix {
+            if unlikely this->n !== b->m() {
+                throw new DimensionalityMismatch("Vector A expects "
+                    . (string) this->n . " rows but Matrix B has "
+                    . (string) b->m() . ".");
+            }
+
+            this->checkDtype(b);
+
+            return new Mask(tensor_compare(this->typedBuffer(), b->typedBuffer(), Mask::comparison(comparison), true));
+        }
+
+        return parent::compare(b, comparison);
+    }
+
     /**
      * Multiply this column vector with a matrix.
      *
@@ -92,24 +119,9 @@ class ColumnVector extends Vector
                 . (string) b->m() . ".");
         }
 
-        var i, rowB, valueB, valueA;
+        this->checkDtype(b);
 
-        array c = [];
-        array rowC = [];
-
-        for i, rowB in b->asArray() {
-            let valueA = this->a[i];
-
-            let rowC = [];
-
-            for valueB in rowB {
-                let rowC[] = valueA * valueB;
-            }
-
-            let c[] = rowC;
-        }
-
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_multiply_column(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -127,24 +139,9 @@ class ColumnVector extends Vector
                 . (string) b->m() . ".");
         }
 
-        var i, rowB, valueB, valueA;
-
-        array c = [];
-        array rowC = [];
-
-        for i, rowB in b->asArray() {
-            let valueA = this->a[i];
-
-            let rowC = [];
-
-            for valueB in rowB {
-                let rowC[] = valueA / valueB;
-            }
-
-            let c[] = rowC;
-        }
+        this->checkDtype(b);
 
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_divide_column(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -162,24 +159,9 @@ class ColumnVector extends Vector
                 . (string) b->m() . ".");
         }
 
-        var i, rowB, valueB, valueA;
-
-        array c = [];
-        array rowC = [];
-
-        for i, rowB in b->asArray() {
-            let valueA = this->a[i];
-
-            let rowC = [];
-
-            for valueB in rowB {
-                let rowC[] = valueA + valueB;
-            }
-
-            let c[] = rowC;
-        }
+        this->checkDtype(b);
 
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_add_column(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -197,24 +179,9 @@ class ColumnVector extends Vector
                 . (string) b->m() . ".");
         }
 
-        var i, rowB, valueB, valueA;
-
-        array c = [];
-        array rowC = [];
-
-        for i, rowB in b->asArray() {
-            let valueA = this->a[i];
-
-            let rowC = [];
+        this->checkDtype(b);
 
-            for valueB in rowB {
-                let rowC[] = valueA - valueB;
-            }
-
-            let c[] = rowC;
-        }
-
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_subtract_column(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -232,24 +199,9 @@ class ColumnVector extends Vector
                 . (string) b->m() . ".");
         }
 
-        var i, rowB, valueB, valueA;
-
-        array c = [];
-        array rowC = [];
-
-        for i, rowB in b->asArray() {
-            let valueA = this->a[i];
+        this->checkDtype(b);
 
-            let rowC = [];
-
-            for valueB in rowB {
-                let rowC[] = pow(valueA, valueB);
-            }
-
-            let c[] = rowC;
-        }
-
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_pow_column(this->typedBuffer(), b->typedBuffer()));
     }
  
     /**
@@ -267,24 +219,9 @@ class ColumnVector extends Vector
                 . (string) b->m() . ".");
         }
 
-        var i, rowB, valueB, valueA;
-
-        array c = [];
-        array rowC = [];
+        this->checkDtype(b);
 
-        for i, rowB in b->asArray() {
-            let valueA = this->a[i];
-
-            let rowC = [];
-
-            for valueB in rowB {
-                let rowC[] = valueA % valueB;
-            }
-
-            let c[] = rowC;
-        }
-
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_mod_column(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -302,24 +239,9 @@ class ColumnVector extends Vector
                 . (string) b->m() . ".");
         }
 
-        var i, rowB, valueB, valueA;
-
-        array c = [];
-        array rowC = [];
-
-        for i, rowB in b->asArray() {
-            let valueA = this->a[i];
-
-            let rowC = [];
-
-            for valueB in rowB {
-                let rowC[] = valueA == valueB ? 1 : 0;
-            }
-
-            let c[] = rowC;
-        }
+        this->checkDtype(b);
 
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_equal_column(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -337,24 +259,9 @@ class ColumnVector extends Vector
                 . (string) b->m() . ".");
         }
 
-        var i, rowB, valueB, valueA;
-
-        array c = [];
-        array rowC = [];
-
-        for i, rowB in b->asArray() {
-            let valueA = this->a[i];
-
-            let rowC = [];
-
-            for valueB in rowB {
-                let rowC[] = valueA != valueB ? 1 : 0;
-            }
-
-            let c[] = rowC;
-        }
+        this->checkDtype(b);
 
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_not_equal_column(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -372,24 +279,9 @@ class ColumnVector extends Vector
                 . (string) b->m() . ".");
         }
 
-        var i, rowB, valueB, valueA;
-
-        array c = [];
-        array rowC = [];
+        this->checkDtype(b);
 
-        for i, rowB in b->asArray() {
-            let valueA = this->a[i];
-
-            let rowC = [];
-
-            for valueB in rowB {
-                let rowC[] = valueA > valueB ? 1 : 0;
-            }
-
-            let c[] = rowC;
-        }
-
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_greater_column(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -407,24 +299,9 @@ class ColumnVector extends Vector
                 . (string) b->m() . ".");
         }
 
-        var i, rowB, valueB, valueA;
-
-        array c = [];
-        array rowC = [];
-
-        for i, rowB in b->asArray() {
-            let valueA = this->a[i];
-
-            let rowC = [];
+        this->checkDtype(b);
 
-            for valueB in rowB {
-                let rowC[] = valueA >= valueB ? 1 : 0;
-            }
-
-            let c[] = rowC;
-        }
-
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_greater_equal_column(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -442,24 +319,9 @@ class ColumnVector extends Vector
                 . (string) b->m() . ".");
         }
 
-        var i, rowB, valueB, valueA;
-
-        array c = [];
-        array rowC = [];
-
-        for i, rowB in b->asArray() {
-            let valueA = this->a[i];
+        this->checkDtype(b);
 
-            let rowC = [];
-
-            for valueB in rowB {
-                let rowC[] = valueA < valueB ? 1 : 0;
-            }
-
-            let c[] = rowC;
-        }
-
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_less_column(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -477,23 +339,8 @@ class ColumnVector extends Vector
                 . (string) b->m() . ".");
         }
 
-        var i, rowB, valueB, valueA;
-        
-        array c = [];
-        array rowC = [];
-
-        for i, rowB in b->asArray() {
-            let valueA = this->a[i];
-
-            let rowC = [];
-
-            for valueB in rowB {
-                let rowC[] = valueA <= valueB ? 1 : 0;
-            }
-
-            let c[] = rowC;
-        }
+        this->checkDtype(b);
 
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_less_equal_column(this->typedBuffer(), b->typedBuffer()));
     }
 }
\ No newline at end of file
@@ -0,0 +1,177 @@
+namespace Tensor;
+
+use Tensor\Exceptions\InvalidArgumentException;
+use Tensor\Exceptions\RuntimeException;
+
+/**
+ * Context
+ *
+ * A scope for the thread budget, precision mode, and allocator used by the native kernels. The
+ * settings of a context only apply to the calling thread, so requests that share a process under
+ * ZTS or an async server do not see each other's configuration, and the previous settings are
+ * restored when the context is exited. Contexts that are still entered at the end of a request are
+ * unwound, whereas settings made outside of a context, such as with Settings::setNumThreads() at
+ * bootstrap, carry over to later requests served by the same process or thread.
+ *
+ * @category    Scientific Computing
+ * @package     Rubix/Tensor
+ * @author      Andrew DalPino
+ */
+class Context
+{
+    /**
+     * Allocate buffers from the request memory manager so they count towards the memory limit.
+     *
+     * @var int
+     */
+    const REQUEST_ALLOCATOR = 0;
+
+    /**
+     * Allocate buffers from the system so their memory is returned to the OS as soon as they are freed.
+     *
+     * @var int
+     */
+    const SYSTEM_ALLOCATOR = 1;
+
+    /**
+     * The number of threads that native kernels may be split across.
+     *
+     * @var int
+     */
+    protected threads;
+
+    /**
+     * Should the fast approximations of transcendental functions be used?
+     *
+     * @var bool
+     */
+    protected fastMath;
+
+    /**
+     * The allocator that new buffers are allocated with.
+     *
+     * @var int
+     */
+    protected allocator;
+
+    /**
+     * The settings that were replaced each time the context was entered.
+     *
+     * @var list<array>
+     */
+    protected saved = [];
+
+    /**
+     * @param int threads
+     * @param bool fastMath
+     * @param int allocator
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     */
+    public function __construct(const int threads = 1, const bool fastMath = false, const int allocator = self::REQUEST_ALLOCATOR)
+    {
+        if unlikely threads < 1 {
+            throw new InvalidArgumentException("The number of threads"
+                . " must be greater than 0, " . strval(threads) . " given.");
+        }
+
+        if unlikely allocator !== self::REQUEST_ALLOCATOR && allocator !== self::SYSTEM_ALLOCATOR {
+            throw new InvalidArgumentException("Allocator must be"
+                . " a request or system allocator, " . strval(allocator) . " given.");
+        }
+
+        let this->threads = threads;
+        let this->fastMath = fastMath;
+        let this->allocator = allocator;
+    }
+
+    /**
+     * Return the number of threads that native kernels may be split across.
+     *
+     * @return int
+     */
+    public function threads() -> int
+    {
+        return this->threads;
+    }
+
+    /**
+     * Return whether the fast approximations of transcendental functions are used.
+     *
+     * @return bool
+     */
+    public function fastMath() -> bool
+    {
+        return this->fastMath;
+    }
+
+    /**
+     * Return the allocator that new buffers are allocated with.
+     *
+     * @return int
+     */
+    public function allocator() -> int
+    {
+        return this->allocator;
+    }
+
+    /**
+     * Apply the settings of the context to the calling thread until it is exited.
+     *
+     * @return self
+     */
+    public function enter() -> <Context>
+    {
+        let this->saved[] = tensor_context_enter(this->threads, this->fastMath, this->allocator);
+
+        return this;
+    }
+
+    /**
+     * Restore the settings that were in place when the context was last entered.
+     *
+     * @throws \Tensor\Exceptions\RuntimeException
+     */
+    public function exit() -> void
+    {
+        var saved, previous;
+
+        if unlikely empty this->saved {
+            throw new RuntimeException("Context must be"
+                . " entered before it can be exited.");
+        }
+
+        let saved = this->saved;
+
+        let previous = array_pop(saved);
+
+        let this->saved = saved;
+
+        var status = tensor_context_exit(previous);
+    }
+
+    /**
+     * Call a function with the settings of the context applied and return its result. The
+     * previous settings are restored even if the function throws.
+     *
+     * @param callable callback
+     * @return mixed
+     */
+    public function run(const var callback)
+    {
+        var result, e;
+
+        this->enter();
+
+        try {
+            let result = {callback}();
+        } catch \Throwable, e {
+            this->exit();
+
+            throw e;
+        }
+
+        this->exit();
+
+        return result;
+    }
+}
@@ -51,9 +51,9 @@ class Eigen
         var result;
 
         if symmetric {
-            let result = tensor_eig_symmetric(a->asArray());
+            let result = tensor_eig_symmetric(a->asBuffer());
         } else {
-            let result = tensor_eig(a->asArray());
+            let result = tensor_eig(a->asBuffer());
         }
 
         if is_null(result) {
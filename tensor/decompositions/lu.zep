@@ -52,7 +52,7 @@ class Lu
                 . " square, " . $a->shapeString() . " given.");
         }
 
-        var result = tensor_lu(a->asArray());
+        var result = tensor_lu(a->asBuffer());
 
         if is_null(result) {
             throw new RuntimeException("Failed to decompose matrix.");
@@ -62,8 +62,8 @@ class Lu
 
         let lup = (array) result;
 
-        var l = Matrix::quick(lup[0]);
-        var u = Matrix::quick(lup[1]);
+        var l = Matrix::fromBuffer(lup[0]);
+        var u = Matrix::fromBuffer(lup[1]);
         var p = Matrix::quick(lup[2]);
 
         return new self(l, u, p);
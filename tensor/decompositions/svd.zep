@@ -42,7 +42,7 @@ class Svd
      */
     public static function decompose(const <Matrix> a) -> <Svd>
     {
-        var result = tensor_svd(a->asArray());
+        var result = tensor_svd(a->asBuffer());
 
         if is_null(result) {
             throw new RuntimeException("Failed to decompose matrix.");
@@ -52,9 +52,9 @@ class Svd
 
         let usvT = (array) result;
 
-        var u = Matrix::quick(usvT[0]);
+        var u = Matrix::fromBuffer(usvT[0]);
         var singularValues = usvT[1];
-        var vT = Matrix::quick(usvT[2]);
+        var vT = Matrix::fromBuffer(usvT[2]);
 
         return new self(u, singularValues, vT);
     }
@@ -0,0 +1,73 @@
+namespace Tensor;
+
+use Tensor\Exceptions\InvalidArgumentException;
+
+/**
+ * Dtype
+ *
+ * The precisions that the elements of a matrix or vector can be stored in. Single precision
+ * tensors take half of the memory of double precision ones and the arithmetic, clipping,
+ * comparison, linear algebra, and convolution kernels run on them natively. Every other operation computes
+ * in double precision and returns a double precision tensor. Tensors of different dtypes are
+ * never mixed implicitly, use asType() to convert one of the operands.
+ *
+ * @category    Scientific Computing
+ * @package     Rubix/Tensor
+ * @author      Andrew DalPino
+ */
+class Dtype
+{
+    /**
+     * Double precision (64-bit) floating point elements.
+     *
+     * @var int
+     */
+    const FLOAT64 = 0;
+
+    /**
+     * Single precision (32-bit) floating point elements.
+     *
+     * @var int
+     */
+    const FLOAT32 = 1;
+
+    /**
+     * Boolean elements stored in a single byte each, used by masks.
+     *
+     * @var int
+     */
+    const BOOL = 2;
+
+    /**
+     * Return the name of a dtype.
+     *
+     * @param int dtype
+     * @return string
+     */
+    public static function name(const int dtype) -> string
+    {
+        switch (dtype) {
+            case self::FLOAT32:
+                return "float32";
+
+            case self::BOOL:
+                return "bool";
+        }
+
+        return "float64";
+    }
+
+    /**
+     * Throw an exception if the dtype is not supported.
+     *
+     * @param int dtype
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     */
+    public static function check(const int dtype) -> void
+    {
+        if unlikely dtype !== self::FLOAT64 && dtype !== self::FLOAT32 {
+            throw new InvalidArgumentException("Dtype must be"
+                . " float64 or float32, " . strval(dtype) . " given.");
+        }
+    }
+}
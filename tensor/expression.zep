@@ -0,0 +1,555 @@
+namespace Tensor;
+
+use Tensor\Exceptions\InvalidArgumentException;
+use Tensor\Exceptions\DimensionalityMismatch;
+
+/**
+ * Expression
+ *
+ * A lazily evaluated chain of element-wise operations over a matrix. Operations are recorded
+ * as they are called and then run together in a single fused pass over the data when the
+ * expression is evaluated so that no intermediate matrices are allocated.
+ *
+ * @category    Scientific Computing
+ * @package     Rubix/Tensor
+ * @author      Andrew DalPino
+ */
+class Expression
+{
+    const MULTIPLY = 0;
+    const DIVIDE = 1;
+    const ADD = 2;
+    const SUBTRACT = 3;
+    const POW = 4;
+    const MOD = 5;
+    const EQUAL = 6;
+    const NOT_EQUAL = 7;
+    const GREATER = 8;
+    const GREATER_EQUAL = 9;
+    const LESS = 10;
+    const LESS_EQUAL = 11;
+    const ABS = 12;
+    const SQUARE = 13;
+    const SQRT = 14;
+    const EXP = 15;
+    const EXPM1 = 16;
+    const LOG = 17;
+    const LOG1P = 18;
+    const SIN = 19;
+    const ASIN = 20;
+    const COS = 21;
+    const ACOS = 22;
+    const TAN = 23;
+    const ATAN = 24;
+    const RAD2DEG = 25;
+    const DEG2RAD = 26;
+    const NEGATE = 27;
+    const RECIPROCAL = 28;
+    const SIGN = 29;
+    const FLOOR = 30;
+    const CEIL = 31;
+    const CLIP_LOWER = 32;
+    const CLIP_UPPER = 33;
+
+    const SCALAR = 0;
+    const MATRIX = 1;
+    const ROW = 2;
+    const COLUMN = 3;
+
+    /**
+     * The matrix that the expression is evaluated over.
+     *
+     * @var \Tensor\Matrix
+     */
+    protected a;
+
+    /**
+     * The recorded program of [operation, operand kind, operand] tuples.
+     *
+     * @var list<array>
+     */
+    protected ops = [];
+
+    /**
+     * @param \Tensor\Matrix a
+     */
+    public function __construct(const <Matrix> a)
+    {
+        let this->a = a;
+    }
+
+    /**
+     * Multiply the expression by another tensor or scalar element-wise.
+     *
+     * @param mixed b
+     * @return self
+     */
+    public function multiply(const var b) -> <Expression>
+    {
+        return this->binary(self::MULTIPLY, b);
+    }
+
+    /**
+     * Divide the expression by another tensor or scalar element-wise.
+     *
+     * @param mixed b
+     * @return self
+     */
+    public function divide(const var b) -> <Expression>
+    {
+        return this->binary(self::DIVIDE, b);
+    }
+
+    /**
+     * Add another tensor or scalar to the expression element-wise.
+     *
+     * @param mixed b
+     * @return self
+     */
+    public function add(const var b) -> <Expression>
+    {
+        return this->binary(self::ADD, b);
+    }
+
+    /**
+     * Subtract another tensor or scalar from the expression element-wise.
+     *
+     * @param mixed b
+     * @return self
+     */
+    public function subtract(const var b) -> <Expression>
+    {
+        return this->binary(self::SUBTRACT, b);
+    }
+
+    /**
+     * Raise the expression to the power of another tensor or scalar element-wise.
+     *
+     * @param mixed b
+     * @return self
+     */
+    public function pow(const var b) -> <Expression>
+    {
+        return this->binary(self::POW, b);
+    }
+
+    /**
+     * Compute the integer modulus of the expression and another tensor or scalar element-wise.
+     *
+     * @param mixed b
+     * @return self
+     */
+    public function mod(const var b) -> <Expression>
+    {
+        return this->binary(self::MOD, b);
+    }
+
+    /**
+     * Compare the expression for equality with another tensor or scalar element-wise.
+     *
+     * @param mixed b
+     * @return self
+     */
+    public function equal(const var b) -> <Expression>
+    {
+        return this->binary(self::EQUAL, b);
+    }
+
+    /**
+     * Compare the expression for inequality with another tensor or scalar element-wise.
+     *
+     * @param mixed b
+     * @return self
+     */
+    public function notEqual(const var b) -> <Expression>
+    {
+        return this->binary(self::NOT_EQUAL, b);
+    }
+
+    /**
+     * Return a greater than comparison of the expression and another tensor or scalar.
+     *
+     * @param mixed b
+     * @return self
+     */
+    public function greater(const var b) -> <Expression>
+    {
+        return this->binary(self::GREATER, b);
+    }
+
+    /**
+     * Return a greater than or equal to comparison of the expression and another tensor or scalar.
+     *
+     * @param mixed b
+     * @return self
+     */
+    public function greaterEqual(const var b) -> <Expression>
+    {
+        return this->binary(self::GREATER_EQUAL, b);
+    }
+
+    /**
+     * Return a less than comparison of the expression and another tensor or scalar.
+     *
+     * @param mixed b
+     * @return self
+     */
+    public function less(const var b) -> <Expression>
+    {
+        return this->binary(self::LESS, b);
+    }
+
+    /**
+     * Return a less than or equal to comparison of the expression and another tensor or scalar.
+     *
+     * @param mixed b
+     * @return self
+     */
+    public function lessEqual(const var b) -> <Expression>
+    {
+        return this->binary(self::LESS_EQUAL, b);
+    }
+
+    /**
+     * Take the absolute value of the expression.
+     *
+     * @return self
+     */
+    public function abs() -> <Expression>
+    {
+        return this->unary(self::ABS);
+    }
+
+    /**
+     * Square the expression.
+     *
+     * @return self
+     */
+    public function square() -> <Expression>
+    {
+        return this->unary(self::SQUARE);
+    }
+
+    /**
+     * Take the square root of the expression.
+     *
+     * @return self
+     */
+    public function sqrt() -> <Expression>
+    {
+        return this->unary(self::SQRT);
+    }
+
+    /**
+     * Exponentiate the expression.
+     *
+     * @return self
+     */
+    public function exp() -> <Expression>
+    {
+        return this->unary(self::EXP);
+    }
+
+    /**
+     * Exponentiate the expression and subtract 1.
+     *
+     * @return self
+     */
+    public function expm1() -> <Expression>
+    {
+        return this->unary(self::EXPM1);
+    }
+
+    /**
+     * Take the log of the expression to a given base.
+     *
+     * @param float base
+     * @return self
+     */
+    public function log(const float base = Matrix::M_E) -> <Expression>
+    {
+        return this->push([self::LOG, self::SCALAR, base]);
+    }
+
+    /**
+     * Take the log of 1 plus the expression.
+     *
+     * @return self
+     */
+    public function log1p() -> <Expression>
+    {
+        return this->unary(self::LOG1P);
+    }
+
+    /**
+     * Return the sine of the expression.
+     *
+     * @return self
+     */
+    public function sin() -> <Expression>
+    {
+        return this->unary(self::SIN);
+    }
+
+    /**
+     * Compute the arc sine of the expression.
+     *
+     * @return self
+     */
+    public function asin() -> <Expression>
+    {
+        return this->unary(self::ASIN);
+    }
+
+    /**
+     * Return the cosine of the expression.
+     *
+     * @return self
+     */
+    public function cos() -> <Expression>
+    {
+        return this->unary(self::COS);
+    }
+
+    /**
+     * Compute the arc cosine of the expression.
+     *
+     * @return self
+     */
+    public function acos() -> <Expression>
+    {
+        return this->unary(self::ACOS);
+    }
+
+    /**
+     * Return the tangent of the expression.
+     *
+     * @return self
+     */
+    public function tan() -> <Expression>
+    {
+        return this->unary(self::TAN);
+    }
+
+    /**
+     * Compute the arc tangent of the expression.
+     *
+     * @return self
+     */
+    public function atan() -> <Expression>
+    {
+        return this->unary(self::ATAN);
+    }
+
+    /**
+     * Convert angles from radians to degrees.
+     *
+     * @return self
+     */
+    public function rad2deg() -> <Expression>
+    {
+        return this->unary(self::RAD2DEG);
+    }
+
+    /**
+     * Convert angles from degrees to radians.
+     *
+     * @return self
+     */
+    public function deg2rad() -> <Expression>
+    {
+        return this->unary(self::DEG2RAD);
+    }
+
+    /**
+     * Negate the expression.
+     *
+     * @return self
+     */
+    public function negate() -> <Expression>
+    {
+        return this->unary(self::NEGATE);
+    }
+
+    /**
+     * Take the reciprocal of the expression.
+     *
+     * @return self
+     */
+    public function reciprocal() -> <Expression>
+    {
+        return this->unary(self::RECIPROCAL);
+    }
+
+    /**
+     * Return the element-wise sign indication of the expression.
+     *
+     * @return self
+     */
+    public function sign() -> <Expression>
+    {
+        return this->unary(self::SIGN);
+    }
+
+    /**
+     * Round the expression down to the nearest integer.
+     *
+     * @return self
+     */
+    public function floor() -> <Expression>
+    {
+        return this->unary(self::FLOOR);
+    }
+
+    /**
+     * Round the expression up to the nearest integer.
+     *
+     * @return self
+     */
+    public function ceil() -> <Expression>
+    {
+        return this->unary(self::CEIL);
+    }
+
+    /**
+     * Clip the expression to a given range.
+     *
+     * @param float min
+     * @param float max
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return self
+     */
+    public function clip(const float min, const float max) -> <Expression>
+    {
+        if unlikely min > max {
+            throw new InvalidArgumentException("Minimum cannot be"
+                . " greater than maximum.");
+        }
+
+        return this->push([self::CLIP_LOWER, self::SCALAR, min])
+            ->push([self::CLIP_UPPER, self::SCALAR, max]);
+    }
+
+    /**
+     * Clip the expression to a given lower bound.
+     *
+     * @param float min
+     * @return self
+     */
+    public function clipLower(const float min) -> <Expression>
+    {
+        return this->push([self::CLIP_LOWER, self::SCALAR, min]);
+    }
+
+    /**
+     * Clip the expression to a given upper bound.
+     *
+     * @param float max
+     * @return self
+     */
+    public function clipUpper(const float max) -> <Expression>
+    {
+        return this->push([self::CLIP_UPPER, self::SCALAR, max]);
+    }
+
+    /**
+     * Run every recorded operation in a single pass and return the result.
+     *
+     * @return \Tensor\Matrix
+     */
+    public function evaluate() -> <Matrix>
+    {
+        return Matrix::fromBuffer(tensor_evaluate(this->a->asBuffer(), this->ops));
+    }
+
+    /**
+     * Run every recorded operation and return the row sums without materializing the result.
+     *
+     * @return \Tensor\ColumnVector
+     */
+    public function sum() -> <ColumnVector>
+    {
+        return ColumnVector::fromBuffer(tensor_evaluate_sum(this->a->asBuffer(), this->ops));
+    }
+
+    /**
+     * Record an element-wise operation with a tensor or scalar operand.
+     *
+     * @param int op
+     * @param mixed b
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    protected function binary(const int op, const var b) -> <Expression>
+    {
+        switch (gettype(b)) {
+            case "object":
+                switch true {
+                    case b instanceof Matrix:
+                        if unlikely b->shape() !== this->a->shape() {
+                            throw new DimensionalityMismatch(this->a->shapeString()
+                                . " matrix expected but " . b->shapeString() . " given.");
+                        }
+
+                        return this->push([op, self::MATRIX, b->asBuffer()]);
+
+                    case b instanceof ColumnVector:
+                        if unlikely b->m() !== this->a->m() {
+                            throw new DimensionalityMismatch("Matrix A expects "
+                                . (string) this->a->m() . " rows but Vector B has "
+                                . (string) b->m() . ".");
+                        }
+
+                        return this->push([op, self::COLUMN, b->asBuffer()]);
+
+                    case b instanceof Vector:
+                        if unlikely b->n() !== this->a->n() {
+                            throw new DimensionalityMismatch("Matrix A expects "
+                                . (string) this->a->n() . " columns but Vector B has "
+                                . (string) b->n() . ".");
+                        }
+
+                        return this->push([op, self::ROW, b->asBuffer()]);
+                }
+
+                break;
+
+            case "double":
+            case "integer":
+                return this->push([op, self::SCALAR, (float) b]);
+        }
+
+        throw new InvalidArgumentException("Cannot apply"
+            . " expression to the given input.");
+    }
+
+    /**
+     * Record an element-wise operation without an operand.
+     *
+     * @param int op
+     * @return self
+     */
+    protected function unary(const int op) -> <Expression>
+    {
+        return this->push([op, self::SCALAR, 0.0]);
+    }
+
+    /**
+     * Return a copy of the expression with an instruction appended to its program so that a
+     * partially built expression can be reused.
+     *
+     * @param array instruction
+     * @return self
+     */
+    protected function push(const array instruction) -> <Expression>
+    {
+        var expression;
+
+        let expression = clone this;
+
+        let expression->ops[] = instruction;
+
+        return expression;
+    }
+}
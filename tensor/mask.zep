@@ -0,0 +1,243 @@
+namespace Tensor;
+
+use Tensor\Exceptions\InvalidArgumentException;
+use Tensor\Exceptions\DimensionalityMismatch;
+
+/**
+ * Mask
+ *
+ * A boolean tensor returned by the compare() method of a matrix or vector. Masks store each
+ * element in a single byte rather than a double and select elements of the tensor they were
+ * compared from with where() and maskedSum() without converting back to numbers.
+ *
+ * @category    Scientific Computing
+ * @package     Rubix/Tensor
+ * @author      Andrew DalPino
+ */
+class Mask
+{
+    /**
+     * The native buffer of booleans that backs the mask.
+     *
+     * @var \Tensor\Buffer
+     */
+    protected buffer;
+
+    /**
+     * The number of rows in the mask.
+     *
+     * @var int
+     */
+    protected m;
+
+    /**
+     * The number of columns in the mask.
+     *
+     * @var int
+     */
+    protected n;
+
+    /**
+     * Does the mask have the shape of a vector?
+     *
+     * @var bool
+     */
+    protected flat;
+
+    /**
+     * Return the code of the native kernel for a comparison operator.
+     *
+     * @internal
+     *
+     * @param string comparison
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return int
+     */
+    public static function comparison(const string comparison) -> int
+    {
+        switch (comparison) {
+            case "==":
+                return 0;
+
+            case "!=":
+                return 1;
+
+            case ">":
+                return 2;
+
+            case ">=":
+                return 3;
+
+            case "<":
+                return 4;
+
+            case "<=":
+                return 5;
+        }
+
+        throw new InvalidArgumentException("Comparison must be ==, !=,"
+            . " >, >=, <, or <=, " . comparison . " given.");
+    }
+
+    /**
+     * @internal
+     *
+     * @param \Tensor\Buffer buffer
+     * @param bool flat
+     */
+    public function __construct(const var buffer, const bool flat = false)
+    {
+        var shape = tensor_buffer_shape(buffer);
+
+        let this->buffer = buffer;
+        let this->m = shape[0];
+        let this->n = shape[1];
+        let this->flat = flat;
+    }
+
+    /**
+     * Return a tuple with the dimensionality of the mask.
+     *
+     * @return int[]
+     */
+    public function shape() -> array
+    {
+        if this->flat {
+            return [this->n];
+        }
+
+        return [this->m, this->n];
+    }
+
+    /**
+     * Return the shape of the mask as a string.
+     *
+     * @return string
+     */
+    public function shapeString() -> string
+    {
+        if this->flat {
+            return (string) this->n;
+        }
+
+        return (string) this->m . " x " . (string) this->n;
+    }
+
+    /**
+     * Return the number of elements in the mask.
+     *
+     * @return int
+     */
+    public function size() -> int
+    {
+        return this->m * this->n;
+    }
+
+    /**
+     * Return the number of elements where the mask holds.
+     *
+     * @return int
+     */
+    public function count() -> int
+    {
+        return tensor_mask_count(this->buffer);
+    }
+
+    /**
+     * Does the mask hold for any element?
+     *
+     * @return bool
+     */
+    public function any() -> bool
+    {
+        return this->count() > 0;
+    }
+
+    /**
+     * Does the mask hold for every element?
+     *
+     * @return bool
+     */
+    public function all() -> bool
+    {
+        return this->count() === this->size();
+    }
+
+    /**
+     * Return a mask that holds where both this mask and mask B hold.
+     *
+     * @param \Tensor\Mask b
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function logicalAnd(const <Mask> b) -> <Mask>
+    {
+        this->checkShape(b);
+
+        return new self(tensor_mask_and(this->buffer, b->asBuffer()), this->flat);
+    }
+
+    /**
+     * Return a mask that holds where either this mask or mask B holds.
+     *
+     * @param \Tensor\Mask b
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function logicalOr(const <Mask> b) -> <Mask>
+    {
+        this->checkShape(b);
+
+        return new self(tensor_mask_or(this->buffer, b->asBuffer()), this->flat);
+    }
+
+    /**
+     * Return a mask that holds where this mask does not.
+     *
+     * @return self
+     */
+    public function logicalNot() -> <Mask>
+    {
+        return new self(tensor_mask_not(this->buffer), this->flat);
+    }
+
+    /**
+     * Return the mask as an array of booleans.
+     *
+     * @return array
+     */
+    public function asArray() -> array
+    {
+        if this->flat {
+            return tensor_buffer_to_vector(this->buffer);
+        }
+
+        return tensor_buffer_to_matrix(this->buffer);
+    }
+
+    /**
+     * Return the native buffer that backs the mask.
+     *
+     * @internal
+     *
+     * @return \Tensor\Buffer
+     */
+    public function asBuffer()
+    {
+        return this->buffer;
+    }
+
+    /**
+     * Throw an exception if mask B does not have the same shape as this mask.
+     *
+     * @param \Tensor\Mask b
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     */
+    protected function checkShape(const <Mask> b) -> void
+    {
+        if unlikely b->shape() !== this->shape() {
+            throw new DimensionalityMismatch(this->shapeString()
+                . " mask expected but " . b->shapeString() . " given.");
+        }
+    }
+}
@@ -24,11 +24,34 @@ class Matrix implements Tensor
 {
     /**
      * A 2-dimensional sequential array that holds the values of the matrix.
+     * Matrices built from a native buffer unpack it lazily on first access.
      *
-     * @var list<list<float>>
+     * @var list<list<float>>|null
      */
     protected a;
 
+    /**
+     * The contiguous row-major native buffer that backs the matrix.
+     *
+     * @var \Tensor\Buffer|null
+     */
+    protected buffer;
+
+    /**
+     * The buffer of the matrix that this matrix is a lazy transpose of. The transposed values are
+     * only materialized once they are needed and matmul() reads this buffer in place instead.
+     *
+     * @var \Tensor\Buffer|null
+     */
+    protected transposed;
+
+    /**
+     * The precision that the elements of the matrix are stored in.
+     *
+     * @var int
+     */
+    protected dtype;
+
     /**
      * The number of rows in the matrix.
      *
@@ -65,6 +88,29 @@ class Matrix implements Tensor
         return new self(a, false);
     }
 
+    /**
+     * Build a new matrix from a contiguous native buffer without unpacking it.
+     *
+     * @internal
+     *
+     * @param \Tensor\Buffer buffer
+     * @return self
+     */
+    public static function fromBuffer(const var buffer) -> <Matrix>
+    {
+        var shape = tensor_buffer_shape(buffer);
+
+        var matrix = new self([], false);
+
+        let matrix->a = null;
+        let matrix->buffer = buffer;
+        let matrix->dtype = tensor_buffer_dtype(buffer);
+        let matrix->m = shape[0];
+        let matrix->n = shape[1];
+
+        return matrix;
+    }
+
     /**
      * Return an identity matrix with dimensionality n x n.
      *
@@ -102,12 +148,13 @@ class Matrix implements Tensor
      *
      * @param int m
      * @param int n
+     * @param int dtype
      * @throws \Tensor\Exceptions\InvalidArgumentException
      * @return self
      */
-    public static function zeros(const int m, const int n) -> <Matrix>
+    public static function zeros(const int m, const int n, const int dtype = Dtype::FLOAT64) -> <Matrix>
     {
-        return self::fill(0.0, m, n);
+        return self::fill(0.0, m, n, dtype);
     }
  
     /**
@@ -115,12 +162,13 @@ class Matrix implements Tensor
      *
      * @param int m
      * @param int n
+     * @param int dtype
      * @throws \Tensor\Exceptions\InvalidArgumentException
      * @return self
      */
-    public static function ones(const int m, const int n) -> <Matrix>
+    public static function ones(const int m, const int n, const int dtype = Dtype::FLOAT64) -> <Matrix>
     {
-        return self::fill(1.0, m, n);
+        return self::fill(1.0, m, n, dtype);
     }
  
     /**
@@ -160,10 +208,11 @@ class Matrix implements Tensor
      * @param float value
      * @param int m
      * @param int n
+     * @param int dtype
      * @throws \Tensor\Exceptions\InvalidArgumentException
      * @return self
      */
-    public static function fill(const float value, const int m, const int n) -> <Matrix>
+    public static function fill(const float value, const int m, const int n, const int dtype = Dtype::FLOAT64) -> <Matrix>
     {
         if unlikely m < 1 {
             throw new InvalidArgumentException("M must be"
@@ -174,6 +223,12 @@ class Matrix implements Tensor
             throw new InvalidArgumentException("N must be"
                 . " greater than 0, " . strval(n) . " given.");
         }
+
+        Dtype::check(dtype);
+
+        if dtype !== Dtype::FLOAT64 {
+            return self::fromBuffer(tensor_buffer_fill(value, m, n, dtype));
+        }
  
         return self::quick(array_fill(0, m, array_fill(0, n, value)));
     }
@@ -183,10 +238,11 @@ class Matrix implements Tensor
       *
       * @param int m
       * @param int n
+      * @param \Tensor\Random|null generator
       * @throws \Tensor\Exceptions\InvalidArgumentException
       * @return self
       */
-    public static function rand(const int m, const int n) -> <Matrix>
+    public static function rand(const int m, const int n, <Random> generator = null) -> <Matrix>
     {
         if unlikely m < 1 {
             throw new InvalidArgumentException("M must be"
@@ -198,22 +254,7 @@ class Matrix implements Tensor
                 . " greater than 0, " . strval(n) . " given.");
         }
 
-        array a = [];
-        array rowA = [];
-
-        int max = (int) getrandmax();
- 
-        while count(a) < m {
-            let rowA = [];
- 
-            while count(rowA) < n {
-                let rowA[] = rand() / max;
-            }
- 
-            let a[] = rowA;
-        }
- 
-        return self::quick(a);
+        return self::fromBuffer(tensor_rand(m, n, generator ? generator->state() : null));
     }
  
     /**
@@ -221,10 +262,11 @@ class Matrix implements Tensor
      *
      * @param int m
      * @param int n
+     * @param \Tensor\Random|null generator
      * @throws \Tensor\Exceptions\InvalidArgumentException
      * @return self
      */
-    public static function gaussian(const int m, const int n) -> <Matrix>
+    public static function gaussian(const int m, const int n, <Random> generator = null) -> <Matrix>
     {
         if unlikely m < 1 {
             throw new InvalidArgumentException("M must be"
@@ -236,38 +278,7 @@ class Matrix implements Tensor
                 . " greater than 0, " . strval(n) . " given.");
         }
 
-        float r, phi;
-        
-        array a = [];
-        array rowA = [];
-        array extras = [];
-
-        int max = (int) getrandmax();
- 
-        while count(a) < m {
-            let rowA = [];
-             
-            if !empty extras {
-                let rowA[] = array_pop(extras);
-            }
- 
-            while count(rowA) < n {
-                let r = sqrt(-2.0 * log(rand() / max));
- 
-                let phi = rand() / max * self::TWO_PI;
- 
-                let rowA[] = r * sin(phi);
-                let rowA[] = r * cos(phi);
-            }
- 
-            if count(rowA) > n {
-                let extras[] = array_pop(rowA);
-            }
- 
-            let a[] = rowA;
-        }
- 
-        return self::quick(a);
+        return self::fromBuffer(tensor_gaussian(m, n, generator ? generator->state() : null));
     }
 
     /**
@@ -276,10 +287,11 @@ class Matrix implements Tensor
      * @param int m
      * @param int n
      * @param float lambda
+     * @param \Tensor\Random|null generator
      * @throws \Tensor\Exceptions\InvalidArgumentException
      * @return self
      */
-    public static function poisson(const int m, const int n, const float lambda = 1.0) -> <Matrix>
+    public static function poisson(const int m, const int n, const float lambda = 1.0, <Random> generator = null) -> <Matrix>
     {
         if unlikely m < 1 {
             throw new InvalidArgumentException("M must be"
@@ -291,47 +303,111 @@ class Matrix implements Tensor
                 . " greater than 0, " . strval(n) . " given.");
         }
 
-        float l, p, k;
+        return self::fromBuffer(tensor_poisson(m, n, lambda, generator ? generator->state() : null));
+    }
 
-        array a = [];
-        array rowA = [];
+    /**
+     * Return a random uniformly distributed matrix with values between -1 and 1.
+     *
+     * @param int m
+     * @param int n
+     * @param \Tensor\Random|null generator
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return self
+     */
+    public static function uniform(const int m, const int n, <Random> generator = null) -> <Matrix>
+    {
+        if unlikely m < 1 {
+            throw new InvalidArgumentException("M must be"
+                . " greater than 0, " . strval(m) . " given.");
+        }
 
-        let l = (float) exp(-lambda);
+        if unlikely n < 1 {
+            throw new InvalidArgumentException("N must be"
+                . " greater than 0, " . strval(n) . " given.");
+        }
 
-        int max = (int) getrandmax();
+        return self::fromBuffer(tensor_uniform(m, n, generator ? generator->state() : null));
+    }
 
-        while count(a) < m {
-            let rowA = [];
+    /**
+     * Return a mask of ones with probability p and zeros otherwise such as for dropout.
+     *
+     * @param int m
+     * @param int n
+     * @param float p
+     * @param \Tensor\Random|null generator
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return self
+     */
+    public static function bernoulli(const int m, const int n, const float p = 0.5, <Random> generator = null) -> <Matrix>
+    {
+        if unlikely m < 1 {
+            throw new InvalidArgumentException("M must be"
+                . " greater than 0, " . strval(m) . " given.");
+        }
 
-            while count(rowA) < n {
-                let k = 0.0;
-                let p = 1.0;
+        if unlikely n < 1 {
+            throw new InvalidArgumentException("N must be"
+                . " greater than 0, " . strval(n) . " given.");
+        }
 
-                while p > l {
-                    let k++;
+        if unlikely p < 0.0 || p > 1.0 {
+            throw new InvalidArgumentException("Probability must be"
+                . " between 0 and 1, " . strval(p) . " given.");
+        }
 
-                    let p *= rand() / max;
-                }
+        return self::fromBuffer(tensor_bernoulli(m, n, p, generator ? generator->state() : null));
+    }
 
-                let rowA[] = k - 1.0;
-            }
+    /**
+     * Return a normally distributed random matrix with values redrawn until they are within two
+     * standard deviations of the mean.
+     *
+     * @param int m
+     * @param int n
+     * @param float mean
+     * @param float std
+     * @param \Tensor\Random|null generator
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return self
+     */
+    public static function truncatedNormal(const int m, const int n, const float mean = 0.0, const float std = 1.0, <Random> generator = null) -> <Matrix>
+    {
+        if unlikely m < 1 {
+            throw new InvalidArgumentException("M must be"
+                . " greater than 0, " . strval(m) . " given.");
+        }
 
-            let a[] = rowA;
+        if unlikely n < 1 {
+            throw new InvalidArgumentException("N must be"
+                . " greater than 0, " . strval(n) . " given.");
         }
 
-        return self::quick(a);
+        if unlikely std < 0.0 {
+            throw new InvalidArgumentException("Standard deviation"
+                . " must be greater than 0, " . strval(std) . " given.");
+        }
+
+        return self::fromBuffer(tensor_truncated_normal(m, n, mean, std, generator ? generator->state() : null));
     }
 
     /**
-     * Return a random uniformly distributed matrix with values between -1 and 1.
+     * Return a m x n weight matrix initialized with the method of Glorot and Bengio which scales
+     * the values by the number of inputs and outputs.
      *
      * @param int m
      * @param int n
+     * @param bool normal
+     * @param \Tensor\Random|null generator
      * @throws \Tensor\Exceptions\InvalidArgumentException
      * @return self
      */
-    public static function uniform(const int m, const int n) -> <Matrix>
+    public static function glorot(const int m, const int n, const bool normal = false, <Random> generator = null) -> <Matrix>
     {
+        var state;
+        float scale;
+
         if unlikely m < 1 {
             throw new InvalidArgumentException("M must be"
                 . " greater than 0, " . strval(m) . " given.");
@@ -342,22 +418,56 @@ class Matrix implements Tensor
                 . " greater than 0, " . strval(n) . " given.");
         }
 
-        array a = [];
-        array rowA = [];
+        let state = generator ? generator->state() : null;
 
-        int max = (int) getrandmax();
-    
-        while count(a) < m {
-            let rowA = [];
-    
-            while count(rowA) < n {
-                let rowA[] = rand(-max, max) / max;
-            }
-    
-            let a[] = rowA;
+        if normal {
+            let scale = sqrt(2.0 / (m + n));
+
+            return self::fromBuffer(tensor_random_normal(m, n, 0.0, scale, state));
         }
-    
-        return self::quick(a);
+
+        let scale = sqrt(6.0 / (m + n));
+
+        return self::fromBuffer(tensor_random_uniform(m, n, -scale, scale, state));
+    }
+
+    /**
+     * Return a m x n weight matrix initialized with the method of He et al. which scales the
+     * values by the number of inputs n.
+     *
+     * @param int m
+     * @param int n
+     * @param bool normal
+     * @param \Tensor\Random|null generator
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return self
+     */
+    public static function he(const int m, const int n, const bool normal = false, <Random> generator = null) -> <Matrix>
+    {
+        var state;
+        float scale;
+
+        if unlikely m < 1 {
+            throw new InvalidArgumentException("M must be"
+                . " greater than 0, " . strval(m) . " given.");
+        }
+
+        if unlikely n < 1 {
+            throw new InvalidArgumentException("N must be"
+                . " greater than 0, " . strval(n) . " given.");
+        }
+
+        let state = generator ? generator->state() : null;
+
+        if normal {
+            let scale = sqrt(2.0 / n);
+
+            return self::fromBuffer(tensor_random_normal(m, n, 0.0, scale, state));
+        }
+
+        let scale = sqrt(6.0 / n);
+
+        return self::fromBuffer(tensor_random_uniform(m, n, -scale, scale, state));
     }
 
     /**
@@ -394,6 +504,7 @@ class Matrix implements Tensor
         }
  
         let this->a = a;
+        let this->dtype = Dtype::FLOAT64;
         let this->m = m;
         let this->n = n;
     }
@@ -477,7 +588,7 @@ class Matrix implements Tensor
      */
     public function columnAsVector(const int index) -> <ColumnVector>
     {
-        return ColumnVector::quick(array_column(this->a, index));
+        return ColumnVector::quick(array_column(this->asArray(), index));
     }
 
     /**
@@ -497,7 +608,7 @@ class Matrix implements Tensor
 
         array b = [];
 
-        for i, rowA in this->a {
+        for i, rowA in this->asArray() {
             let b[] = rowA[i];
         }
 
@@ -511,9 +622,102 @@ class Matrix implements Tensor
      */
     public function asArray() -> array
     {
+        if is_null(this->a) {
+            let this->a = tensor_buffer_to_matrix(this->typedBuffer());
+        }
+
         return this->a;
     }
 
+    /**
+     * Return the contiguous row-major native buffer of doubles that backs the matrix. Single
+     * precision matrices return a double precision copy of their buffer.
+     *
+     * @internal
+     *
+     * @return \Tensor\Buffer
+     */
+    public function asBuffer()
+    {
+        if this->dtype !== Dtype::FLOAT64 {
+            return tensor_buffer_cast(this->typedBuffer(), Dtype::FLOAT64);
+        }
+
+        return this->typedBuffer();
+    }
+
+    /**
+     * Return the contiguous row-major native buffer that backs the matrix in its own dtype.
+     *
+     * @internal
+     *
+     * @return \Tensor\Buffer
+     */
+    public function typedBuffer()
+    {
+        if is_null(this->buffer) {
+            if is_null(this->transposed) {
+                let this->buffer = tensor_buffer_from_array(this->a);
+
+                if this->dtype !== Dtype::FLOAT64 {
+                    let this->buffer = tensor_buffer_cast(this->buffer, this->dtype);
+                }
+            } else {
+                let this->buffer = tensor_transpose(this->transposed);
+                let this->transposed = null;
+            }
+        }
+
+        return this->buffer;
+    }
+
+    /**
+     * Return the precision that the elements of the matrix are stored in.
+     *
+     * @return int
+     */
+    public function dtype() -> int
+    {
+        return this->dtype;
+    }
+
+    /**
+     * Return a copy of the matrix with its elements converted to the given dtype.
+     *
+     * @param int dtype
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return self
+     */
+    public function asType(const int dtype) -> <Matrix>
+    {
+        Dtype::check(dtype);
+
+        return self::fromBuffer(tensor_buffer_cast(this->typedBuffer(), dtype));
+    }
+
+    /**
+     * Unpack the elements into the array before the matrix is serialized. The native buffer is
+     * not serializable and is rebuilt from the array on first use after unserializing.
+     *
+     * @return string[]
+     */
+    public function __sleep() -> array
+    {
+        this->asArray();
+
+        return ["a", "dtype", "m", "n"];
+    }
+
+    /**
+     * Default the dtype of matrixs that were serialized before it existed.
+     */
+    public function __wakeup() -> void
+    {
+        if is_null(this->dtype) {
+            let this->dtype = Dtype::FLOAT64;
+        }
+    }
+
     /**
      * Return each row as a vector in an array.
      *
@@ -521,7 +725,7 @@ class Matrix implements Tensor
      */
     public function asVectors() -> array
     {
-        return array_map(["Tensor\\Vector", "quick"], this->a);
+        return array_map(["Tensor\\Vector", "quick"], this->asArray());
     }
 
     /**
@@ -549,7 +753,17 @@ class Matrix implements Tensor
      */
     public function flatten() -> <Vector>
     {
-        return Vector::quick(call_user_func_array("array_merge", this->a));
+        return Vector::quick(call_user_func_array("array_merge", this->asArray()));
+    }
+
+    /**
+     * Begin a fused expression of element-wise operations over the matrix.
+     *
+     * @return \Tensor\Expression
+     */
+    public function expr() -> <Expression>
+    {
+        return new Expression(this);
     }
 
     /**
@@ -566,7 +780,7 @@ class Matrix implements Tensor
 
         array b = [];
  
-        for rowA in this->a {
+        for rowA in this->asArray() {
             let b[] = array_map(callback, rowA);
         }
  
@@ -588,7 +802,7 @@ class Matrix implements Tensor
 
         var carry = initial;
  
-        for rowA in this->a {
+        for rowA in this->asArray() {
             for valueA in rowA {
                 let carry = {callback}(valueA, carry);
             }
@@ -598,26 +812,35 @@ class Matrix implements Tensor
     }
  
     /**
-     * Transpose the matrix i.e row become columns and columns become rows.
+     * Transpose the matrix i.e row become columns and columns become rows. The transpose shares
+     * the buffer of this matrix and is only copied once its values are accessed.
      *
      * @return self
      */
     public function transpose() -> <Matrix>
     {
-        int i;
-        
-        array b = [];
- 
-        for i in range(0, this->n - 1) {
-            let b[] = array_column(this->a, i);
+        var matrix;
+
+        if !is_null(this->transposed) {
+            return self::fromBuffer(this->transposed);
         }
- 
-        return self::quick(b);
+
+        let matrix = new self([], false);
+
+        let matrix->a = null;
+        let matrix->buffer = null;
+        let matrix->transposed = this->typedBuffer();
+        let matrix->dtype = this->dtype;
+        let matrix->m = this->n;
+        let matrix->n = this->m;
+
+        return matrix;
     }
 
     /**
      * Compute the inverse of the square matrix.
      *
+     * @throws \Tensor\Exceptions\RuntimeException
      * @return self
      */
     public function inverse() -> <Matrix>
@@ -627,17 +850,30 @@ class Matrix implements Tensor
                 . " square, " . this->shapeString() .  " given.");
         }
 
-        return self::quick(tensor_inverse(this->a));
+        var b = tensor_inverse(this->asBuffer());
+
+        if is_null(b) {
+            throw new RuntimeException("Failed to invert matrix.");
+        }
+
+        return self::fromBuffer(b);
     }
 
     /**
      * Compute the Moore-Penrose pseudoinverse of a general matrix.
      *
+     * @throws \Tensor\Exceptions\RuntimeException
      * @return self
      */
      public function pseudoinverse() -> <Matrix>
     {
-        return self::quick(tensor_pseudoinverse(this->a));
+        var b = tensor_pseudoinverse(this->asBuffer());
+
+        if is_null(b) {
+            throw new RuntimeException("Failed to compute pseudoinverse.");
+        }
+
+        return self::fromBuffer(b);
     }
 
     /**
@@ -723,11 +959,13 @@ class Matrix implements Tensor
         
         var rowA;
 
+        var a = this->asArray();
+
         for i in range(0, this->m - 2) {
-            let rowA = this->a[i];
+            let rowA = a[i];
 
             for j in range(i + 1, this->n - 1) {
-                if rowA[j] != this->a[j][i] {
+                if rowA[j] != a[j][i] {
                     return false;
                 }
             }
@@ -745,13 +983,96 @@ class Matrix implements Tensor
      */
     public function matmul(const <Matrix> b) -> <Matrix>
     {
-        if unlikely this->n !== b->m() {
-            throw new DimensionalityMismatch("Matrix A requires "
-                . (string) this->n . " rows but Matrix B has "
-                . (string) b->m() . ".");
+        return this->gemm(b);
+    }
+
+    /**
+     * General matrix-matrix product i.e. alpha * op(A) * op(B) + beta * C where op() optionally
+     * transposes its operand without copying it. If matrix C is given then it is updated in place
+     * and returned, otherwise the product is returned as a new matrix and beta is ignored.
+     *
+     * @param \Tensor\Matrix b
+     * @param bool transA
+     * @param bool transB
+     * @param float alpha
+     * @param float beta
+     * @param \Tensor\Matrix|null c
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function gemm(const <Matrix> b, bool transA = false, bool transB = false, const float alpha = 1.0, const float beta = 0.0, <Matrix> c = null) -> <Matrix>
+    {
+        var ba, bb, buffer = null;
+        int m, n, k, p;
+
+        let m = transA ? this->n : this->m;
+        let k = transA ? this->m : this->n;
+        let p = transB ? b->n() : b->m();
+        let n = transB ? b->m() : b->n();
+
+        if unlikely k !== p {
+            throw new DimensionalityMismatch("Matrix A requires "
+                . (string) k . " rows but Matrix B has "
+                . (string) p . ".");
+        }
+
+        this->checkDtype(b);
+
+        if is_null(this->transposed) {
+            let ba = this->typedBuffer();
+        } else {
+            let ba = this->transposed;
+            let transA = !transA;
+        }
+
+        if is_null(b->transposed) {
+            let bb = b->typedBuffer();
+        } else {
+            let bb = b->transposed;
+            let transB = !transB;
+        }
+
+        if is_null(c) {
+            return self::fromBuffer(tensor_gemm(ba, bb, transA, transB, alpha, beta, buffer));
+        }
+
+        if unlikely c->m() !== m || c->n() !== n {
+            throw new DimensionalityMismatch((string) m . " x " . (string) n
+                . " matrix expected but " . c->shapeString() . " given.");
+        }
+
+        this->checkDtype(c);
+
+        let buffer = c->typedBuffer();
+
+        let c->a = null;
+        let c->buffer = null;
+
+        let c->buffer = tensor_gemm(ba, bb, transA, transB, alpha, beta, buffer);
+
+        return c;
+    }
+
+    /**
+     * Return the Gram matrix alpha * A * A^T, or alpha * A^T * A if trans is true. Since the
+     * product is symmetric only one triangle is computed and then mirrored.
+     *
+     * @param bool trans
+     * @param float alpha
+     * @return self
+     */
+    public function gram(bool trans = false, const float alpha = 1.0) -> <Matrix>
+    {
+        var ba;
+
+        if is_null(this->transposed) {
+            let ba = this->typedBuffer();
+        } else {
+            let ba = this->transposed;
+            let trans = !trans;
         }
-         
-        return self::quick(tensor_matmul(this->a, b->asArray()));
+
+        return self::fromBuffer(tensor_syrk(ba, trans, alpha));
     }
 
     /**
@@ -769,7 +1090,57 @@ class Matrix implements Tensor
                 . (string) b->size() . ".");
         }
 
-        return this->matmul(b->asColumnMatrix())->columnAsVector(0);
+        this->checkDtype(b);
+
+        if is_null(this->transposed) {
+            return ColumnVector::fromBuffer(tensor_gemv(this->typedBuffer(), b->typedBuffer(), false));
+        }
+
+        return ColumnVector::fromBuffer(tensor_gemv(this->transposed, b->typedBuffer(), true));
+    }
+
+    /**
+     * Return the matrix of distances between every row of this matrix and every row of matrix B
+     * under the given metric i.e. euclidean, cosine, or manhattan.
+     *
+     * @param \Tensor\Matrix b
+     * @param string metric
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function pairwiseDistances(const <Matrix> b, const string metric = "euclidean") -> <Matrix>
+    {
+        int mode;
+
+        switch (metric) {
+            case "euclidean":
+                let mode = 0;
+
+                break;
+
+            case "cosine":
+                let mode = 1;
+
+                break;
+
+            case "manhattan":
+                let mode = 2;
+
+                break;
+
+            default:
+                throw new InvalidArgumentException("Metric must be euclidean,"
+                    . " cosine, or manhattan, " . metric . " given.");
+        }
+
+        if unlikely this->n !== b->n() {
+            throw new DimensionalityMismatch("Matrix A expects "
+                . (string) this->n . " columns but Matrix B has "
+                . (string) b->n() . ".");
+        }
+
+        return self::fromBuffer(tensor_pairwise_distances(this->asBuffer(), b->asBuffer(), mode));
     }
 
     /**
@@ -792,7 +1163,9 @@ class Matrix implements Tensor
                 . " less than 1, " . strval(stride) . " given.");
         }
 
-        return self::quick(tensor_convolve_2d(this->a, b->asArray(), stride));
+        this->checkDtype(b);
+
+        return self::fromBuffer(tensor_convolve_2d(this->typedBuffer(), b->typedBuffer(), stride));
     }
 
     /**
@@ -865,7 +1238,7 @@ class Matrix implements Tensor
      */
     public function l1Norm() -> float
     {
-        return this->transpose()->abs()->sum()->max();
+        return this->abs()->sum(0)->max();
     }
  
     /**
@@ -1304,6 +1677,120 @@ class Matrix implements Tensor
             . " matrix to the given input.");
     }
 
+    /**
+     * Compare this matrix to another tensor or a scalar element-wise and return a mask that holds
+     * where the comparison does. The comparison is one of ==, !=, >, >=, <, or <=.
+     *
+     * @param mixed b
+     * @param string comparison
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return \Tensor\Mask
+     */
+    public function compare(const var b, const string comparison) -> <Mask>
+    {
+        int op = Mask::comparison(comparison);
+
+        switch (gettype(b)) {
+            case "object":
+                switch true {
+                    case b instanceof Matrix:
+                        if unlikely b->shape() !== this->shape() {
+                            throw new DimensionalityMismatch(this->shapeString()
+                                . " matrix expected but " . b->shapeString() . " given.");
+                        }
+
+                        this->checkDtype(b);
+
+                        return new Mask(tensor_compare(this->typedBuffer(), b->typedBuffer(), op, false));
+
+                    case b instanceof ColumnVector:
+                        if unlikely b->m() !== this->m {
+                            throw new DimensionalityMismatch("Matrix A expects "
+                                . (string) this->m . " rows but Vector B has "
+                                . (string) b->m() . ".");
+                        }
+
+                        this->checkDtype(b);
+
+                        return new Mask(tensor_compare(this->typedBuffer(), b->typedBuffer(), op, true));
+
+                    case b instanceof Vector:
+                        if unlikely b->n() !== this->n {
+                            throw new DimensionalityMismatch("Matrix A expects "
+                                . (string) this->n . " columns but Vector B has "
+                                . (string) b->n() . ".");
+                        }
+
+                        this->checkDtype(b);
+
+                        return new Mask(tensor_compare(this->typedBuffer(), b->typedBuffer(), op, false));
+                }
+
+                break;
+
+            case "double":
+            case "integer":
+                return new Mask(tensor_compare(this->typedBuffer(), b, op, false));
+        }
+
+        throw new InvalidArgumentException("Cannot compare"
+            . " matrix to the given input.");
+    }
+
+    /**
+     * Return the elements of this matrix where the mask holds and the elements of matrix or
+     * scalar B everywhere else.
+     *
+     * @param \Tensor\Mask mask
+     * @param mixed b
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function where(const <Mask> mask, const var b) -> <Matrix>
+    {
+        if unlikely mask->shape() !== this->shape() {
+            throw new DimensionalityMismatch(this->shapeString()
+                . " mask expected but " . mask->shapeString() . " given.");
+        }
+
+        if b instanceof Matrix {
+            if unlikely b->shape() !== this->shape() {
+                throw new DimensionalityMismatch(this->shapeString()
+                    . " matrix expected but " . b->shapeString() . " given.");
+            }
+
+            this->checkDtype(b);
+
+            return self::fromBuffer(tensor_where(mask->asBuffer(), this->typedBuffer(), b->typedBuffer()));
+        }
+
+        if unlikely !is_int(b) && !is_float(b) {
+            throw new InvalidArgumentException("Cannot select from"
+                . " matrix and the given input.");
+        }
+
+        return self::fromBuffer(tensor_where(mask->asBuffer(), this->typedBuffer(), b));
+    }
+
+    /**
+     * Return the sum of each row of the matrix over the elements where the mask holds.
+     *
+     * @param \Tensor\Mask mask
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return \Tensor\ColumnVector
+     */
+    public function maskedSum(const <Mask> mask) -> <ColumnVector>
+    {
+        if unlikely mask->shape() !== this->shape() {
+            throw new DimensionalityMismatch(this->shapeString()
+                . " mask expected but " . mask->shapeString() . " given.");
+        }
+
+        return ColumnVector::fromBuffer(tensor_masked_sum(this->typedBuffer(), mask->asBuffer()));
+    }
+
     /**
      * Return the element-wise reciprocal of the matrix.
      *
@@ -1342,7 +1829,7 @@ class Matrix implements Tensor
      */
     public function sqrt() -> <Matrix>
     {
-        return this->map("sqrt");
+        return self::fromBuffer(tensor_sqrt(this->asBuffer()));
     }
  
     /**
@@ -1352,7 +1839,7 @@ class Matrix implements Tensor
      */
     public function exp() -> <Matrix>
     {
-        return this->map("exp");
+        return self::fromBuffer(tensor_exp(this->asBuffer()));
     }
 
     /**
@@ -1373,26 +1860,7 @@ class Matrix implements Tensor
      */
     public function log(const float base = self::M_E) -> <Matrix>
     {
-        if base === self::M_E {
-            return this->map("log");
-        }
-
-        var rowA, valueA;
-
-        array rowB = [];
-        array b = [];
- 
-        for rowA in this->a {
-            let rowB = [];
- 
-            for valueA in rowA {
-                let rowB[] = log(valueA, base);
-            }
- 
-            let b[] = rowB;
-        }
- 
-        return self::quick(b);
+        return self::fromBuffer(tensor_log(this->asBuffer(), base));
     }
 
     /**
@@ -1412,7 +1880,7 @@ class Matrix implements Tensor
      */
     public function sin() -> <Matrix>
     {
-        return this->map("sin");
+        return self::fromBuffer(tensor_sin(this->asBuffer()));
     }
 
     /**
@@ -1432,7 +1900,7 @@ class Matrix implements Tensor
      */
     public function cos() -> <Matrix>
     {
-        return this->map("cos");
+        return self::fromBuffer(tensor_cos(this->asBuffer()));
     }
 
     /**
@@ -1452,7 +1920,7 @@ class Matrix implements Tensor
      */
     public function tan() -> <Matrix>
     {
-        return this->map("tan");
+        return self::fromBuffer(tensor_tan(this->asBuffer()));
     }
 
     /**
@@ -1486,82 +1954,134 @@ class Matrix implements Tensor
     }
 
     /**
-     * Sum the rows of the matrix and return a vector.
+     * Sum the matrix along an axis and return a vector. Axis 1 sums each row into a column vector
+     * and axis 0 sums each column into a vector.
      *
-     * @return \Tensor\ColumnVector
+     * @param int axis
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return \Tensor\Vector
      */
-    public function sum() -> <ColumnVector>
+    public function sum(const int axis = 1) -> <Vector>
     {
-        return ColumnVector::quick(array_map("array_sum", this->a));
+        this->checkAxis(axis);
+
+        return this->axisVector(tensor_sum(this->asBuffer(), axis), axis);
     }
 
     /**
-     * Calculate the row product of the matrix.
+     * Calculate the product of the matrix along an axis.
      *
-     * @return \Tensor\ColumnVector
+     * @param int axis
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return \Tensor\Vector
      */
-    public function product() -> <ColumnVector>
+    public function product(const int axis = 1) -> <Vector>
     {
-        return ColumnVector::quick(array_map("array_product", this->a));
+        this->checkAxis(axis);
+
+        return this->axisVector(tensor_product(this->asBuffer(), axis), axis);
     }
 
     /**
-     * Return the minimum of each row in the matrix.
+     * Return the minimum of the matrix along an axis.
      *
-     * @return \Tensor\ColumnVector
+     * @param int axis
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return \Tensor\Vector
      */
-    public function min() -> <ColumnVector>
+    public function min(const int axis = 1) -> <Vector>
     {
-        return ColumnVector::quick(array_map("min", this->a));
+        this->checkAxis(axis);
+
+        return this->axisVector(tensor_min(this->asBuffer(), axis), axis);
     }
 
     /**
-     * Return the maximum of each row in the matrix.
+     * Return the maximum of the matrix along an axis.
      *
-     * @return \Tensor\ColumnVector
+     * @param int axis
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return \Tensor\Vector
      */
-    public function max() -> <ColumnVector>
+    public function max(const int axis = 1) -> <Vector>
     {
-        return ColumnVector::quick(array_map("max", this->a));
+        this->checkAxis(axis);
+
+        return this->axisVector(tensor_max(this->asBuffer(), axis), axis);
     }
 
     /**
-     * Compute the means of each row and return them in a vector.
+     * Return the offset of the minimum of the matrix along an axis.
      *
-     * @return \Tensor\ColumnVector
+     * @param int axis
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return int[]
      */
-    public function mean() -> <ColumnVector>
+    public function argmin(const int axis = 1) -> array
     {
-        return this->sum()->divideScalar(this->n);
+        this->checkAxis(axis);
+
+        return tensor_argmin(this->asBuffer(), axis);
     }
 
     /**
-     * Return the median vector of this matrix.
+     * Return the offset of the maximum of the matrix along an axis.
      *
-     * @return \Tensor\ColumnVector
+     * @param int axis
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return int[]
      */
-    public function median() -> <ColumnVector>
+    public function argmax(const int axis = 1) -> array
     {
-        var rowA, median;
-        array b = [];
+        this->checkAxis(axis);
+
+        return tensor_argmax(this->asBuffer(), axis);
+    }
 
-        int mid = (int) intdiv(this->n, 2);
+    /**
+     * Return the k largest or smallest values of each row in rank order along with their column offsets.
+     *
+     * @param int k
+     * @param bool largest
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return array{\Tensor\Matrix,list<list<int>>}
+     */
+    public function topK(const int k, const bool largest = true) -> array
+    {
+        var result;
 
-        bool odd = this->n % 2 === 1;
+        if unlikely k < 1 || k > this->n {
+            throw new InvalidArgumentException("K must be between 1 and "
+                . (string) this->n . ", " . (string) k . " given.");
+        }
 
-        for rowA in this->a {
-            sort(rowA);
+        let result = tensor_top_k(this->asBuffer(), k, largest);
 
-            if odd {
-                let median = rowA[mid];
-            } else {
-                let median = (rowA[mid - 1] + rowA[mid]) / 2.0;
-            }
+        return [self::fromBuffer(result[0]), result[1]];
+    }
 
-            let b[] = median;
-        }
+    /**
+     * Compute the means of the matrix along an axis and return them in a vector.
+     *
+     * @param int axis
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return \Tensor\Vector
+     */
+    public function mean(const int axis = 1) -> <Vector>
+    {
+        this->checkAxis(axis);
+
+        return this->axisVector(tensor_mean(this->asBuffer(), axis), axis);
+    }
 
-        return ColumnVector::quick(b);
+    /**
+     * Return the median vector of this matrix.
+     *
+     * @return \Tensor\ColumnVector
+     */
+    public function median() -> <ColumnVector>
+    {
+        return ColumnVector::fromBuffer(tensor_quantiles(this->asBuffer(), [0.5]));
     }
 
     /**
@@ -1578,26 +2098,34 @@ class Matrix implements Tensor
                 . " 0 and 1, " . strval(q) . " given.");
         }
 
-        float t;
-        var rowA;
-        
-        array b = [];
+        return ColumnVector::fromBuffer(tensor_quantiles(this->asBuffer(), [q]));
+    }
 
-        float x = q * (this->n - 1) + 1;
+    /**
+     * Return several quantiles of each row at once. Column j of the result holds the q[j]'th
+     * quantile of every row and each row is only partitioned once for all of them.
+     *
+     * @param float[] q
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return self
+     */
+    public function quantiles(const array q) -> <Matrix>
+    {
+        var value;
 
-        int xHat = (int) x;
-    
-        float remainder = x - xHat;
+        if unlikely empty q {
+            throw new InvalidArgumentException("At least one"
+                . " quantile must be given.");
+        }
 
-        for rowA in this->a {
-            sort(rowA);
-    
-            let t = (float) rowA[xHat - 1];
-    
-            let b[] = t + remainder * (rowA[xHat] - t);
+        for value in q {
+            if unlikely !is_numeric(value) || value < 0.0 || value > 1.0 {
+                throw new InvalidArgumentException("Q must be between"
+                    . " 0 and 1, " . strval(value) . " given.");
+            }
         }
 
-        return ColumnVector::quick(b);
+        return self::fromBuffer(tensor_quantiles(this->asBuffer(), array_values(q)))->transpose();
     }
 
     /**
@@ -1625,7 +2153,8 @@ class Matrix implements Tensor
             let mean = this->mean();
         }
 
-        return this->subtractColumnVector(mean)
+        return this->expr()
+            ->subtract(mean)
             ->square()
             ->sum()
             ->divideScalar(this->m);
@@ -1652,8 +2181,7 @@ class Matrix implements Tensor
 
         var b = this->subtractColumnVector(mean);
 
-        return b->matmul(b->transpose())
-            ->divideScalar(this->m);
+        return b->gram(false, 1.0 / this->m);
     }
 
     /**
@@ -1678,7 +2206,7 @@ class Matrix implements Tensor
         array b = [];
         array rowB = [];
 
-        for rowA in this->a {
+        for rowA in this->asArray() {
             let rowB = [];
 
             for valueA in rowA {
@@ -1727,34 +2255,7 @@ class Matrix implements Tensor
                 . " greater than maximum.");
         }
 
-        var rowA, valueA;
-
-        array b = [];
-        array rowB = [];
-
-        for rowA in this->a {
-            let rowB = [];
-
-            for valueA in rowA {
-                if valueA > max {
-                    let rowB[] = max;
-
-                    continue;
-                }
-
-                if valueA < min {
-                    let rowB[] = min;
-
-                    continue;
-                }
-
-                let rowB[] = valueA;
-            }
-
-            let b[] = rowB;
-        }
-
-        return self::quick(b);
+        return self::fromBuffer(tensor_clip(this->typedBuffer(), min, max));
     }
 
     /**
@@ -1765,28 +2266,7 @@ class Matrix implements Tensor
      */
     public function clipLower(const float min) -> <Matrix>
     {
-        var rowA, valueA;
-
-        array b = [];
-        array rowB = [];
-
-        for rowA in this->a {
-            let rowB = [];
-
-            for valueA in rowA {
-                if valueA < min {
-                    let rowB[] = min;
-
-                    continue;
-                }
-
-                let rowB[] = valueA;
-            }
-
-            let b[] = rowB;
-        }
-
-        return self::quick(b);
+        return self::fromBuffer(tensor_clip_lower(this->typedBuffer(), min));
     }
 
     /**
@@ -1797,28 +2277,7 @@ class Matrix implements Tensor
      */
     public function clipUpper(const float max) -> <Matrix>
     {
-        var rowA, valueA;
-
-        array b = [];
-        array rowB = [];
-
-        for rowA in this->a {
-            let rowB = [];
-
-            for valueA in rowA {
-                if valueA > max {
-                    let rowB[] = max;
-
-                    continue;
-                }
-
-                let rowB[] = valueA;
-            }
-
-            let b[] = rowB;
-        }
-
-        return self::quick(b);
+        return self::fromBuffer(tensor_clip_upper(this->typedBuffer(), max));
     }
 
     /**
@@ -1833,7 +2292,7 @@ class Matrix implements Tensor
         array b = [];
         array rowB = [];
 
-        for rowA in this->a {
+        for rowA in this->asArray() {
             let rowB = [];
 
             for valueA in rowA {
@@ -1864,7 +2323,7 @@ class Matrix implements Tensor
         array b = [];
         array rowB = [];
 
-        for rowA in this->a {
+        for rowA in this->asArray() {
             let rowB = [];
 
             for valueA in rowA {
@@ -1892,7 +2351,7 @@ class Matrix implements Tensor
                 . (string) b->n() . ".");
         }
 
-        return self::quick(array_merge(b->asArray(), this->a));
+        return self::quick(array_merge(b->asArray(), this->asArray()));
     }
 
     /**
@@ -1910,7 +2369,7 @@ class Matrix implements Tensor
                 . (string) b->n() . ".");
         }
 
-        return self::quick(array_merge(this->a, b->asArray()));
+        return self::quick(array_merge(this->asArray(), b->asArray()));
     }
 
     /**
@@ -1928,7 +2387,7 @@ class Matrix implements Tensor
                 . (string) b->m() . ".");
         }
 
-        return self::quick(array_map("array_merge", b->asArray(), this->a));
+        return self::quick(array_map("array_merge", b->asArray(), this->asArray()));
     }
 
     /**
@@ -1946,7 +2405,7 @@ class Matrix implements Tensor
                 . (string) b->m() . ".");
         }
         
-        return self::quick(array_map("array_merge", this->a, b->asArray()));
+        return self::quick(array_map("array_merge", this->asArray(), b->asArray()));
     }
 
     /**
@@ -1964,7 +2423,7 @@ class Matrix implements Tensor
         array temp = [];
 
         if n > 0 {
-            for rowA in this->a {
+            for rowA in this->asArray() {
                 let temp = [];
 
                 while count(temp) <= n {
@@ -1998,15 +2457,9 @@ class Matrix implements Tensor
                 . " matrix expected but " . b->shapeString() . " given.");
         }
 
-        var i, rowB;
+        this->checkDtype(b);
 
-        array c = [];
-
-        for i, rowB in b->asArray() {
-            let c[] = tensor_multiply(this->a[i], rowB);
-        }
-
-        return self::quick(c);
+        return self::fromBuffer(tensor_multiply(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2023,15 +2476,9 @@ class Matrix implements Tensor
                 . " matrix expected but " . b->shapeString() . " given.");
         }
 
-        var i, rowB;
-        
-        array c = [];
-
-        for i, rowB in b->asArray() {
-            let c[] = tensor_divide(this->a[i], rowB);
-        }
+        this->checkDtype(b);
 
-        return self::quick(c);
+        return self::fromBuffer(tensor_divide(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2048,15 +2495,9 @@ class Matrix implements Tensor
                 . " matrix expected but " . b->shapeString() . " given.");
         }
 
-        var i, rowB;
-        
-        array c = [];
-
-        for i, rowB in b->asArray() {
-            let c[] = tensor_add(this->a[i], rowB);
-        }
+        this->checkDtype(b);
 
-        return self::quick(c);
+        return self::fromBuffer(tensor_add(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2073,15 +2514,9 @@ class Matrix implements Tensor
                 . " matrix expected but " . b->shapeString() . " given.");
         }
 
-        var i, rowB;
-        
-        array c = [];
-
-        for i, rowB in b->asArray() {
-            let c[] = tensor_subtract(this->a[i], rowB);
-        }
+        this->checkDtype(b);
 
-        return self::quick(c);
+        return self::fromBuffer(tensor_subtract(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2099,15 +2534,9 @@ class Matrix implements Tensor
                 . " matrix expected but " . b->shapeString() . " given.");
         }
 
-        var i, rowB;
-        
-        array c = [];
-
-        for i, rowB in b->asArray() {
-            let c[] = tensor_pow(this->a[i], rowB);
-        }
+        this->checkDtype(b);
 
-        return self::quick(c);
+        return self::fromBuffer(tensor_pow(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2125,15 +2554,9 @@ class Matrix implements Tensor
                 . " matrix expected but " . b->shapeString() . " given.");
         }
 
-        var i, rowB;
-        
-        array c = [];
-
-        for i, rowB in b->asArray() {
-            let c[] = tensor_mod(this->a[i], rowB);
-        }
+        this->checkDtype(b);
 
-        return self::quick(c);
+        return self::fromBuffer(tensor_mod(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2151,15 +2574,9 @@ class Matrix implements Tensor
                 . " matrix expected but " . b->shapeString() . " given.");
         }
 
-        var i, rowB;
-        
-        array c = [];
-
-        for i, rowB in b->asArray() {
-            let c[] = tensor_equal(this->a[i], rowB);
-        }
+        this->checkDtype(b);
 
-        return self::quick(c);
+        return self::fromBuffer(tensor_equal(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2176,15 +2593,9 @@ class Matrix implements Tensor
                 . " matrix expected but " . b->shapeString() . " given.");
         }
 
-        var i, rowB;
-        
-        array c = [];
-
-        for i, rowB in b->asArray() {
-            let c[] = tensor_not_equal(this->a[i], rowB);
-        }
+        this->checkDtype(b);
 
-        return self::quick(c);
+        return self::fromBuffer(tensor_not_equal(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2202,15 +2613,9 @@ class Matrix implements Tensor
                 . " matrix expected but " . b->shapeString() . " given.");
         }
 
-        var i, rowB;
-        
-        array c = [];
-
-        for i, rowB in b->asArray() {
-            let c[] = tensor_greater(this->a[i], rowB);
-        }
+        this->checkDtype(b);
 
-        return self::quick(c);
+        return self::fromBuffer(tensor_greater(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2228,15 +2633,9 @@ class Matrix implements Tensor
                 . " matrix expected but " . b->shapeString() . " given.");
         }
 
-        var i, rowB;
-        
-        array c = [];
-
-        for i, rowB in b->asArray() {
-            let c[] = tensor_greater_equal(this->a[i], rowB);
-        }
+        this->checkDtype(b);
 
-        return self::quick(c);
+        return self::fromBuffer(tensor_greater_equal(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2253,15 +2652,9 @@ class Matrix implements Tensor
                 . " matrix expected but " . b->shapeString() . " given.");
         }
 
-        var i, rowB;
-        
-        array c = [];
-
-        for i, rowB in b->asArray() {
-            let c[] = tensor_less(this->a[i], rowB);
-        }
+        this->checkDtype(b);
 
-        return self::quick(c);
+        return self::fromBuffer(tensor_less(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2278,15 +2671,9 @@ class Matrix implements Tensor
                 . " matrix expected but " . b->shapeString() . " given.");
         }
 
-        var i, rowB;
-        
-        array c = [];
-
-        for i, rowB in b->asArray() {
-            let c[] = tensor_less_equal(this->a[i], rowB);
-        }
+        this->checkDtype(b);
 
-        return self::quick(c);
+        return self::fromBuffer(tensor_less_equal(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2304,17 +2691,9 @@ class Matrix implements Tensor
                 . (string) b->n() . ".");
         }
 
-        var rowA;
-
-        array c = [];
+        this->checkDtype(b);
 
-        var bHat = b->asArray();
-    
-        for rowA in this->a {
-            let c[] = tensor_multiply(rowA, bHat);
-        }
-    
-        return self::quick(c);
+        return self::fromBuffer(tensor_multiply(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2332,17 +2711,9 @@ class Matrix implements Tensor
                 . (string) b->n() . ".");
         }
 
-        var rowA;
-
-        array c = [];
+        this->checkDtype(b);
 
-        var bHat = b->asArray();
-    
-        for rowA in this->a {
-            let c[] = tensor_divide(rowA, bHat);
-        }
-    
-        return self::quick(c);
+        return self::fromBuffer(tensor_divide(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2360,17 +2731,9 @@ class Matrix implements Tensor
                 . (string) b->n() . ".");
         }
     
-        var rowA;
-
-        array c = [];
+        this->checkDtype(b);
 
-        var bHat = b->asArray();
-    
-        for rowA in this->a {
-            let c[] = tensor_add(rowA, bHat);
-        }
-    
-        return self::quick(c);
+        return self::fromBuffer(tensor_add(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2388,17 +2751,9 @@ class Matrix implements Tensor
                 . (string) b->n() . ".");
         }
     
-        var rowA;
+        this->checkDtype(b);
 
-        array c = [];
-
-        var bHat = b->asArray();
-    
-        for rowA in this->a {
-            let c[] = tensor_subtract(rowA, bHat);
-        }
-    
-        return self::quick(c);
+        return self::fromBuffer(tensor_subtract(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2416,17 +2771,9 @@ class Matrix implements Tensor
                 . (string) b->n() . ".");
         }
     
-        var rowA;
-
-        array c = [];
+        this->checkDtype(b);
 
-        var bHat = b->asArray();
-    
-        for rowA in this->a {
-            let c[] = tensor_pow(rowA, bHat);
-        }
-    
-        return self::quick(c);
+        return self::fromBuffer(tensor_pow(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2444,17 +2791,9 @@ class Matrix implements Tensor
                 . (string) b->n() . ".");
         }
     
-        var rowA;
+        this->checkDtype(b);
 
-        array c = [];
-
-        var bHat = b->asArray();
-    
-        for rowA in this->a {
-            let c[] = tensor_mod(rowA, bHat);
-        }
-    
-        return self::quick(c);
+        return self::fromBuffer(tensor_mod(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2473,17 +2812,9 @@ class Matrix implements Tensor
                 . (string) b->n() . ".");
         }
 
-        var rowA;
-
-        array c = [];
+        this->checkDtype(b);
 
-        var bHat = b->asArray();
-    
-        for rowA in this->a {
-            let c[] = tensor_equal(rowA, bHat);
-        }
-    
-        return self::quick(c);
+        return self::fromBuffer(tensor_equal(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2501,17 +2832,9 @@ class Matrix implements Tensor
                 . (string) b->n() . ".");
         }
 
-        var rowA;
-
-        array c = [];
+        this->checkDtype(b);
 
-        var bHat = b->asArray();
-    
-        for rowA in this->a {
-            let c[] = tensor_not_equal(rowA, bHat);
-        }
-    
-        return self::quick(c);
+        return self::fromBuffer(tensor_not_equal(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2529,17 +2852,9 @@ class Matrix implements Tensor
                 . (string) b->n() . ".");
         }
 
-        var rowA;
-
-        array c = [];
+        this->checkDtype(b);
 
-        var bHat = b->asArray();
-    
-        for rowA in this->a {
-            let c[] = tensor_greater(rowA, bHat);
-        }
-    
-        return self::quick(c);
+        return self::fromBuffer(tensor_greater(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2557,17 +2872,9 @@ class Matrix implements Tensor
                 . (string) b->n() . ".");
         }
 
-        var rowA;
-
-        array c = [];
+        this->checkDtype(b);
 
-        var bHat = b->asArray();
-    
-        for rowA in this->a {
-            let c[] = tensor_greater_equal(rowA, bHat);
-        }
-    
-        return self::quick(c);
+        return self::fromBuffer(tensor_greater_equal(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2585,17 +2892,9 @@ class Matrix implements Tensor
                 . (string) b->n() . ".");
         }
 
-        var rowA;
-
-        array c = [];
+        this->checkDtype(b);
 
-        var bHat = b->asArray();
-    
-        for rowA in this->a {
-            let c[] = tensor_less(rowA, bHat);
-        }
-    
-        return self::quick(c);
+        return self::fromBuffer(tensor_less(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2614,17 +2913,9 @@ class Matrix implements Tensor
                 . (string) b->n() . ".");
         }
 
-        var rowA;
-
-        array c = [];
+        this->checkDtype(b);
 
-        var bHat = b->asArray();
-    
-        for rowA in this->a {
-            let c[] = tensor_less_equal(rowA, bHat);
-        }
-    
-        return self::quick(c);
+        return self::fromBuffer(tensor_less_equal(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2642,15 +2933,9 @@ class Matrix implements Tensor
                 . (string) b->m() . ".");
         }
 
-        var i, valueB;
+        this->checkDtype(b);
 
-        array c = [];
-
-        for i, valueB in b->asArray() {
-            let c[] = tensor_multiply_scalar(this->a[i], valueB);
-        }
-
-        return self::quick(c);
+        return self::fromBuffer(tensor_multiply_column(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2668,15 +2953,9 @@ class Matrix implements Tensor
                 . (string) b->m() . ".");
         }
 
-        var i, valueB;
-
-        array c = [];
+        this->checkDtype(b);
 
-        for i, valueB in b->asArray() {
-            let c[] = tensor_divide_scalar(this->a[i], valueB);
-        }
-
-        return self::quick(c);
+        return self::fromBuffer(tensor_divide_column(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2694,15 +2973,9 @@ class Matrix implements Tensor
                 . (string) b->m() . ".");
         }
 
-        var i, valueB;
-
-        array c = [];
-
-        for i, valueB in b->asArray() {
-            let c[] = tensor_add_scalar(this->a[i], valueB);
-        }
+        this->checkDtype(b);
 
-        return self::quick(c);
+        return self::fromBuffer(tensor_add_column(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2720,15 +2993,9 @@ class Matrix implements Tensor
                 . (string) b->m() . ".");
         }
 
-        var i, valueB;
-
-        array c = [];
-
-        for i, valueB in b->asArray() {
-            let c[] = tensor_subtract_scalar(this->a[i], valueB);
-        }
+        this->checkDtype(b);
 
-        return self::quick(c);
+        return self::fromBuffer(tensor_subtract_column(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2746,15 +3013,9 @@ class Matrix implements Tensor
                 . (string) b->m() . ".");
         }
 
-        var i, valueB;
+        this->checkDtype(b);
 
-        array c = [];
-
-        for i, valueB in b->asArray() {
-            let c[] = tensor_pow_scalar(this->a[i], valueB);
-        }
-
-        return self::quick(c);
+        return self::fromBuffer(tensor_pow_column(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2772,15 +3033,9 @@ class Matrix implements Tensor
                 . (string) b->m() . ".");
         }
 
-        var i, valueB;
-
-        array c = [];
+        this->checkDtype(b);
 
-        for i, valueB in b->asArray() {
-            let c[] = tensor_mod_scalar(this->a[i], valueB);
-        }
-
-        return self::quick(c);
+        return self::fromBuffer(tensor_mod_column(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2798,15 +3053,9 @@ class Matrix implements Tensor
                 . (string) b->m() . ".");
         }
 
-        var i, valueB;
-
-        array c = [];
-
-        for i, valueB in b->asArray() {
-            let c[] = tensor_equal_scalar(this->a[i], valueB);
-        }
+        this->checkDtype(b);
 
-        return self::quick(c);
+        return self::fromBuffer(tensor_equal_column(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2824,15 +3073,9 @@ class Matrix implements Tensor
                 . (string) b->m() . ".");
         }
 
-        var i, valueB;
-
-        array c = [];
-
-        for i, valueB in b->asArray() {
-            let c[] = tensor_not_equal_scalar(this->a[i], valueB);
-        }
+        this->checkDtype(b);
 
-        return self::quick(c);
+        return self::fromBuffer(tensor_not_equal_column(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2850,15 +3093,9 @@ class Matrix implements Tensor
                 . (string) b->m() . ".");
         }
 
-        var i, valueB;
+        this->checkDtype(b);
 
-        array c = [];
-
-        for i, valueB in b->asArray() {
-            let c[] = tensor_greater_scalar(this->a[i], valueB);
-        }
-
-        return self::quick(c);
+        return self::fromBuffer(tensor_greater_column(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2876,15 +3113,9 @@ class Matrix implements Tensor
                 . (string) b->m() . ".");
         }
 
-        var i, valueB;
-
-        array c = [];
+        this->checkDtype(b);
 
-        for i, valueB in b->asArray() {
-            let c[] = tensor_greater_equal_scalar(this->a[i], valueB);
-        }
-
-        return self::quick(c);
+        return self::fromBuffer(tensor_greater_equal_column(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2902,15 +3133,9 @@ class Matrix implements Tensor
                 . (string) b->m() . ".");
         }
 
-        var i, valueB;
-
-        array c = [];
-
-        for i, valueB in b->asArray() {
-            let c[] = tensor_less_scalar(this->a[i], valueB);
-        }
+        this->checkDtype(b);
 
-        return self::quick(c);
+        return self::fromBuffer(tensor_less_column(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2928,15 +3153,9 @@ class Matrix implements Tensor
                 . (string) b->m() . ".");
         }
 
-        var i, valueB;
-
-        array c = [];
-
-        for i, valueB in b->asArray() {
-            let c[] = tensor_less_equal_scalar(this->a[i], valueB);
-        }
+        this->checkDtype(b);
 
-        return self::quick(c);
+        return self::fromBuffer(tensor_less_equal_column(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -2947,15 +3166,7 @@ class Matrix implements Tensor
      */
     public function multiplyScalar(const float b) -> <Matrix>
     {
-        var rowA;
-
-        array c = [];
-
-        for rowA in this->a {
-            let c[] = tensor_multiply_scalar(rowA, b);
-        }
-
-        return self::quick(c);
+        return self::fromBuffer(tensor_multiply_scalar(this->typedBuffer(), b));
     }
 
     /**
@@ -2966,15 +3177,7 @@ class Matrix implements Tensor
      */
     public function divideScalar(const float b) -> <Matrix>
     {
-        var rowA;
-
-        array c = [];
-
-        for rowA in this->a {
-            let c[] = tensor_divide_scalar(rowA, b);
-        }
-
-        return self::quick(c);
+        return self::fromBuffer(tensor_divide_scalar(this->typedBuffer(), b));
     }
 
     /**
@@ -2985,15 +3188,7 @@ class Matrix implements Tensor
      */
     public function addScalar(const float b) -> <Matrix>
     {
-        var rowA;
-
-        array c = [];
-
-        for rowA in this->a {
-            let c[] = tensor_add_scalar(rowA, b);
-        }
-
-        return self::quick(c);
+        return self::fromBuffer(tensor_add_scalar(this->typedBuffer(), b));
     }
 
     /**
@@ -3004,15 +3199,7 @@ class Matrix implements Tensor
      */
     public function subtractScalar(const float b) -> <Matrix>
     {
-        var rowA;
-
-        array c = [];
-
-        for rowA in this->a {
-            let c[] = tensor_subtract_scalar(rowA, b);
-        }
-
-        return self::quick(c);
+        return self::fromBuffer(tensor_subtract_scalar(this->typedBuffer(), b));
     }
 
     /**
@@ -3023,15 +3210,7 @@ class Matrix implements Tensor
      */
     public function powScalar(const float b) -> <Matrix>
     {
-        var rowA;
-
-        array c = [];
-
-        for rowA in this->a {
-            let c[] = tensor_pow_scalar(rowA, b);
-        }
-
-        return self::quick(c);
+        return self::fromBuffer(tensor_pow_scalar(this->typedBuffer(), b));
     }
 
     /**
@@ -3042,34 +3221,114 @@ class Matrix implements Tensor
      */
     public function modScalar(const float b) -> <Matrix>
     {
-        var rowA;
+        return self::fromBuffer(tensor_mod_scalar(this->typedBuffer(), b));
+    }
+
+    /**
+     * Add a matrix to this matrix in place. The existing buffer is updated rather than allocating
+     * a new matrix so every reference to this matrix observes the change.
+     *
+     * @param \Tensor\Matrix b
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function addMatrixInPlace(const <Matrix> b) -> <Matrix>
+    {
+        return this->axpy(1.0, b);
+    }
 
-        array c = [];
+    /**
+     * Subtract a matrix from this matrix in place.
+     *
+     * @param \Tensor\Matrix b
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function subtractMatrixInPlace(const <Matrix> b) -> <Matrix>
+    {
+        return this->axpy(-1.0, b);
+    }
 
-        for rowA in this->a {
-            let c[] = tensor_mod_scalar(rowA, b);
+    /**
+     * Add alpha times matrix X to this matrix in place i.e. A = alpha * X + A.
+     *
+     * @param float alpha
+     * @param \Tensor\Matrix x
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function axpy(const float alpha, const <Matrix> x) -> <Matrix>
+    {
+        if unlikely x->shape() !== this->shape() {
+            throw new DimensionalityMismatch(this->shapeString()
+                . " matrix expected but " . x->shapeString() . " given.");
         }
 
-        return self::quick(c);
+        this->checkDtype(x);
+
+        var bx = x->typedBuffer();
+        var buffer = this->typedBuffer();
+
+        let this->a = null;
+        let this->buffer = null;
+
+        let this->buffer = tensor_axpy_in_place(buffer, bx, alpha);
+
+        return this;
     }
 
     /**
-     * Return the element-wise equality comparison of this matrix and a scalar.
+     * Multiply this matrix by a scalar in place.
      *
      * @param float b
      * @return self
      */
-    public function equalScalar(const float b) -> <Matrix>
+    public function multiplyScalarInPlace(const float b) -> <Matrix>
     {
-        var rowA;
+        var buffer = this->typedBuffer();
+
+        let this->a = null;
+        let this->buffer = null;
+
+        let this->buffer = tensor_scale_in_place(buffer, b);
 
-        array c = [];
+        return this;
+    }
 
-        for rowA in this->a {
-            let c[] = tensor_equal_scalar(rowA, b);
+    /**
+     * Clip the elements of this matrix to a given range in place.
+     *
+     * @param float min
+     * @param float max
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return self
+     */
+    public function clipInPlace(const float min, const float max) -> <Matrix>
+    {
+        if unlikely min > max {
+            throw new InvalidArgumentException("Minimum cannot be"
+                . " greater than maximum.");
         }
 
-        return self::quick(c);
+        var buffer = this->typedBuffer();
+
+        let this->a = null;
+        let this->buffer = null;
+
+        let this->buffer = tensor_clip_in_place(buffer, min, max);
+
+        return this;
+    }
+
+    /**
+     * Return the element-wise equality comparison of this matrix and a scalar.
+     *
+     * @param float b
+     * @return self
+     */
+    public function equalScalar(const float b) -> <Matrix>
+    {
+        return self::fromBuffer(tensor_equal_scalar(this->typedBuffer(), b));
     }
 
     /**
@@ -3080,15 +3339,7 @@ class Matrix implements Tensor
      */
     public function notEqualScalar(const float b) -> <Matrix>
     {
-        var rowA;
-
-        array c = [];
-
-        for rowA in this->a {
-            let c[] = tensor_not_equal_scalar(rowA, b);
-        }
-
-        return self::quick(c);
+        return self::fromBuffer(tensor_not_equal_scalar(this->typedBuffer(), b));
     }
 
     /**
@@ -3099,15 +3350,7 @@ class Matrix implements Tensor
      */
     public function greaterScalar(const float b) -> <Matrix>
     {
-        var rowA;
-
-        array c = [];
-
-        for rowA in this->a {
-            let c[] = tensor_greater_scalar(rowA, b);
-        }
-
-        return self::quick(c);
+        return self::fromBuffer(tensor_greater_scalar(this->typedBuffer(), b));
     }
 
     /**
@@ -3119,15 +3362,7 @@ class Matrix implements Tensor
      */
     public function greaterEqualScalar(const float b) -> <Matrix>
     {
-        var rowA;
-
-        array c = [];
-
-        for rowA in this->a {
-            let c[] = tensor_greater_equal_scalar(rowA, b);
-        }
-
-        return self::quick(c);
+        return self::fromBuffer(tensor_greater_equal_scalar(this->typedBuffer(), b));
     }
 
     /**
@@ -3138,15 +3373,7 @@ class Matrix implements Tensor
      */
     public function lessScalar(const float b) -> <Matrix>
     {
-        var rowA;
-
-        array c = [];
-
-        for rowA in this->a {
-            let c[] = tensor_less_scalar(rowA, b);
-        }
-
-        return self::quick(c);
+        return self::fromBuffer(tensor_less_scalar(this->typedBuffer(), b));
     }
 
     /**
@@ -3158,15 +3385,7 @@ class Matrix implements Tensor
      */
     public function lessEqualScalar(const float b) -> <Matrix>
     {
-        var rowA;
-
-        array c = [];
-
-        for rowA in this->a {
-            let c[] = tensor_less_equal_scalar(rowA, b);
-        }
-
-        return self::quick(c);
+        return self::fromBuffer(tensor_less_equal_scalar(this->typedBuffer(), b));
     }
 
     /**
@@ -3195,7 +3414,9 @@ class Matrix implements Tensor
      */
     public function offsetExists(const var index) -> bool
     {
-        return isset this->a[index];
+        var a = this->asArray();
+
+        return isset a[index];
     }
 
     /**
@@ -3218,7 +3439,9 @@ class Matrix implements Tensor
     {
         var row;
 
-        if likely fetch row, this->a[index] {
+        var a = this->asArray();
+
+        if likely fetch row, a[index] {
             return Vector::quick(row);
         }
 
@@ -3235,4 +3458,49 @@ class Matrix implements Tensor
     {
         return new ArrayIterator(this->asVectors());
     }
+    /**
+     * Throw an exception if the axis is not 0 for columns or 1 for rows.
+     *
+     * @param int axis
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     */
+    protected function checkAxis(const int axis) -> void
+    {
+        if unlikely axis !== 0 && axis !== 1 {
+            throw new InvalidArgumentException("Axis must be"
+                . " 0 or 1, " . strval(axis) . " given.");
+        }
+    }
+
+    /**
+     * Throw an exception if the dtype of a tensor operand does not match this matrix.
+     *
+     * @param \Tensor\Matrix|\Tensor\Vector b
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     */
+    protected function checkDtype(const var b) -> void
+    {
+        if unlikely b->dtype() !== this->dtype {
+            throw new InvalidArgumentException("Dtype " . Dtype::name(b->dtype())
+                . " does not match " . Dtype::name(this->dtype) . ","
+                . " convert one of the operands with asType().");
+        }
+    }
+
+    /**
+     * Wrap the buffer of a reduction along the given axis in a vector. Reducing each row yields
+     * a column vector and reducing each column yields a row vector.
+     *
+     * @param \Tensor\Buffer buffer
+     * @param int axis
+     * @return \Tensor\Vector
+     */
+    protected function axisVector(const var buffer, const int axis) -> <Vector>
+    {
+        if axis === 1 {
+            return ColumnVector::fromBuffer(buffer);
+        }
+
+        return Vector::fromBuffer(buffer);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,103 @@
+namespace Tensor;
+
+/**
+ * Random
+ *
+ * A seedable random number generator for the random factories of Matrix and Vector. Generators
+ * with the same seed produce the same sequence of tensors regardless of the number of threads
+ * that they are filled with. Independent streams for parallel work are handed out with split(),
+ * which never overlap with each other or with the parent.
+ *
+ * @category    Scientific Computing
+ * @package     Rubix/Tensor
+ * @author      Andrew DalPino
+ */
+class Random
+{
+    /**
+     * The seed that the generator was started with.
+     *
+     * @var int
+     */
+    protected seed;
+
+    /**
+     * The native state of the generator.
+     *
+     * @var \Tensor\RandomState
+     */
+    protected state;
+
+    /**
+     * @param int|null seed
+     */
+    public function __construct(var seed = null)
+    {
+        if seed === null {
+            let seed = random_int(PHP_INT_MIN, PHP_INT_MAX);
+        }
+
+        let this->seed = (int) seed;
+        let this->state = tensor_random_seed(this->seed);
+    }
+
+    /**
+     * Return the seed that the generator was started with.
+     *
+     * @return int
+     */
+    public function seed() -> int
+    {
+        return this->seed;
+    }
+
+    /**
+     * Advance the generator by 2^128 draws.
+     *
+     * @return self
+     */
+    public function jump() -> <Random>
+    {
+        var status = tensor_random_jump(this->state);
+
+        return this;
+    }
+
+    /**
+     * Return a generator that continues the current stream and jump this generator ahead so
+     * that the two never draw the same numbers. Calling split() repeatedly hands out one stream
+     * per worker.
+     *
+     * @return self
+     */
+    public function split() -> <Random>
+    {
+        var child;
+
+        let child = clone this;
+
+        this->jump();
+
+        return child;
+    }
+
+    /**
+     * Return the native state of the generator.
+     *
+     * @internal
+     *
+     * @return \Tensor\RandomState
+     */
+    public function state()
+    {
+        return this->state;
+    }
+
+    /**
+     * Copy the state so that a clone draws independently of the original.
+     */
+    public function __clone()
+    {
+        let this->state = clone this->state;
+    }
+}
@@ -38,7 +38,7 @@ class Ref
      */
     public static function reduce(const <Matrix> a) -> <Ref>
     {
-        var result = tensor_ref(a->asArray());
+        var result = tensor_ref(a->asBuffer());
 
         if is_null(result) {
             throw new RuntimeException("Failed to decompose matrix.");
@@ -48,7 +48,7 @@ class Ref
 
         let ref = (array) result;
 
-        var b = Matrix::quick(ref[0]);
+        var b = Matrix::fromBuffer(ref[0]);
         var swaps = ref[1];
 
         return new self(b, swaps);
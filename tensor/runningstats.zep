@@ -0,0 +1,172 @@
+namespace Tensor;
+
+use Tensor\Exceptions\InvalidArgumentException;
+use Tensor\Exceptions\DimensionalityMismatch;
+
+/**
+ * Running Stats
+ *
+ * Streaming column means and variances that are updated one chunk of samples at a time in a
+ * single pass using Welford's method. Partial states computed over separate chunks can be merged
+ * with Chan's parallel formula and give the same result as reducing all of the samples at once.
+ *
+ * @category    Scientific Computing
+ * @package     Rubix/Tensor
+ * @author      Andrew DalPino
+ */
+class RunningStats
+{
+    /**
+     * The number of columns i.e. the dimensionality of each sample.
+     *
+     * @var int
+     */
+    protected n;
+
+    /**
+     * The number of samples that have been observed so far.
+     *
+     * @var int
+     */
+    protected count = 0;
+
+    /**
+     * A 2 x n buffer whose rows hold the running means and the sums of squared deviations from the mean.
+     *
+     * @var \Tensor\Buffer
+     */
+    protected state;
+
+    /**
+     * @param int n
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     */
+    public function __construct(const int n)
+    {
+        if unlikely n < 1 {
+            throw new InvalidArgumentException("The number of columns"
+                . " must be greater than 0, " . strval(n) . " given.");
+        }
+
+        let this->n = n;
+        let this->state = Matrix::zeros(2, n)->asBuffer();
+    }
+
+    /**
+     * Return the number of columns.
+     *
+     * @return int
+     */
+    public function n() -> int
+    {
+        return this->n;
+    }
+
+    /**
+     * Return the number of samples that have been observed so far.
+     *
+     * @return int
+     */
+    public function count() -> int
+    {
+        return this->count;
+    }
+
+    /**
+     * Update the statistics with a chunk of samples given as the rows of a matrix or a single sample given as a vector.
+     *
+     * @param mixed a
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function update(const var a) -> <RunningStats>
+    {
+        var state;
+        int m, n;
+
+        switch true {
+            case a instanceof Matrix:
+                let m = a->m();
+                let n = a->n();
+
+                break;
+
+            case a instanceof Vector:
+                let m = 1;
+                let n = a->size();
+
+                break;
+
+            default:
+                throw new InvalidArgumentException("Cannot update running"
+                    . " stats with the given input.");
+        }
+
+        if unlikely n !== this->n {
+            throw new DimensionalityMismatch("Running stats require "
+                . (string) this->n . " columns but "
+                . (string) n . " given.");
+        }
+
+        let state = this->state;
+
+        let this->state = null;
+
+        let this->state = tensor_running_stats_update(state, this->count, a->asBuffer());
+        let this->count = this->count + m;
+
+        return this;
+    }
+
+    /**
+     * Merge the partial statistics of another running stats object into this one.
+     *
+     * @param \Tensor\RunningStats b
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function merge(const <RunningStats> b) -> <RunningStats>
+    {
+        var state;
+
+        if unlikely b->n() !== this->n {
+            throw new DimensionalityMismatch("Running stats require "
+                . (string) this->n . " columns but "
+                . (string) b->n() . " given.");
+        }
+
+        let state = this->state;
+
+        let this->state = null;
+
+        let this->state = tensor_running_stats_merge(state, this->count, b->state, b->count());
+        let this->count = this->count + b->count();
+
+        return this;
+    }
+
+    /**
+     * Return the mean of each column.
+     *
+     * @return \Tensor\Vector
+     */
+    public function mean() -> <Vector>
+    {
+        return Matrix::fromBuffer(this->state)->rowAsVector(0);
+    }
+
+    /**
+     * Return the population variance of each column.
+     *
+     * @return \Tensor\Vector
+     */
+    public function variance() -> <Vector>
+    {
+        if this->count < 1 {
+            return Vector::zeros(this->n);
+        }
+
+        return Matrix::fromBuffer(this->state)->rowAsVector(1)->divideScalar(this->count);
+    }
+}
@@ -38,4 +38,78 @@ class Settings
     {
         return tensor_get_num_threads();
     }
+
+    /**
+     * Use fast vectorized approximations of exp, log, sin, cos, and tan instead of the strict
+     * libm implementations. The approximations are accurate to within a few units in the last place.
+     *
+     * @param bool enabled
+     * @return void
+     */
+    public static function setFastMath(const bool enabled) -> void
+    {
+        var status = tensor_set_fast_math(enabled);
+    }
+
+    /**
+     * Return whether the fast approximations of transcendental functions are in use.
+     *
+     * @return bool
+     */
+    public static function fastMath() -> bool
+    {
+        return tensor_get_fast_math();
+    }
+
+    /**
+     * Set the minimum number of elements handed to each thread when element-wise and reduction
+     * kernels are split across threads. Smaller inputs run on a single thread.
+     *
+     * @param int size
+     * @return void
+     */
+    public static function setGrainSize(const int size) -> void
+    {
+        if unlikely size < 1 {
+            throw new InvalidArgumentException("Grain size"
+                . " must be greater than 0, " . strval(size) . " given.");
+        }
+
+        var status = tensor_set_grain_size(size);
+    }
+
+    /**
+     * Return the minimum number of elements handed to each thread.
+     *
+     * @return int
+     */
+    public static function grainSize() -> int
+    {
+        return tensor_get_grain_size();
+    }
+
+    /**
+     * Return the work done by each thread of the row scheduler since the counters were last
+     * reset. Each entry holds the seconds spent running rows, the fraction of the scheduler's
+     * wall time that represents, and the number of rows, tasks, and steals. The first entry is
+     * the submitting thread and there is one entry for every thread in the pool, which may be
+     * more than the current thread budget. The counters are shared by the whole process, so under
+     * ZTS they add up the work of every request thread.
+     *
+     * @return list<array{busy: float, utilization: float, rows: int, tasks: int, steals: int}>
+     */
+    public static function utilization() -> array
+    {
+        return tensor_get_utilization();
+    }
+
+    /**
+     * Reset the utilization counters of the row scheduler for the whole process.
+     *
+     * @return void
+     */
+    public static function resetUtilization() -> void
+    {
+        var status = tensor_reset_utilization();
+    }
 }
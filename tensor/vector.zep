@@ -17,12 +17,27 @@ use ArrayIterator;
 class Vector implements Tensor
 {
     /**
-     * A 1-d sequential array holding the elements of the vector.
+     * A 1-d sequential array holding the elements of the vector. Vectors built
+     * from a native buffer unpack it lazily on first access.
      *
-     * @var list<float>
+     * @var list<float>|null
      */
     protected a;
 
+    /**
+     * The contiguous native buffer that backs the vector.
+     *
+     * @var \Tensor\Buffer|null
+     */
+    protected buffer;
+
+    /**
+     * The precision that the elements of the vector are stored in.
+     *
+     * @var int
+     */
+    protected dtype;
+
     /**
      * The number of elements in the vector.
      *
@@ -52,28 +67,52 @@ class Vector implements Tensor
         return new self(a, false);
     }
 
+    /**
+     * Build a vector from a contiguous native buffer without unpacking it.
+     *
+     * @internal
+     *
+     * @param \Tensor\Buffer buffer
+     * @return self
+     */
+    public static function fromBuffer(const var buffer)
+    {
+        var shape = tensor_buffer_shape(buffer);
+
+        var vector = new static([], false);
+
+        let vector->a = null;
+        let vector->buffer = buffer;
+        let vector->dtype = tensor_buffer_dtype(buffer);
+        let vector->n = shape[0] * shape[1];
+
+        return vector;
+    }
+
     /**
      * Build a vector of zeros with n elements.
      *
      * @param int n
+     * @param int dtype
      * @throws \Tensor\Exceptions\InvalidArgumentException
      * @return self
      */
-    public static function zeros(const int n) -> <Vector>
+    public static function zeros(const int n, const int dtype = Dtype::FLOAT64) -> <Vector>
     {
-        return static::fill(0.0, n);
+        return static::fill(0.0, n, dtype);
     }
 
     /**
      * Build a vector of ones with n elements.
      *
      * @param int n
+     * @param int dtype
      * @throws \Tensor\Exceptions\InvalidArgumentException
      * @return self
      */
-    public static function ones(const int n) -> <Vector>
+    public static function ones(const int n, const int dtype = Dtype::FLOAT64) -> <Vector>
     {
-        return static::fill(1.0, n);
+        return static::fill(1.0, n, dtype);
     }
 
     /**
@@ -81,10 +120,11 @@ class Vector implements Tensor
      *
      * @param float value
      * @param int n
+     * @param int dtype
      * @throws \Tensor\Exceptions\InvalidArgumentException
      * @return self
      */
-    public static function fill(const float value, const int n) -> <Vector>
+    public static function fill(const float value, const int n, const int dtype = Dtype::FLOAT64) -> <Vector>
     {
         if unlikely !is_int(value) && !is_float(value) {
             throw new InvalidArgumentException("Value must be an"
@@ -97,6 +137,12 @@ class Vector implements Tensor
                 . " greater than 0, " . strval(n) . " given.");
         }
 
+        Dtype::check(dtype);
+
+        if dtype !== Dtype::FLOAT64 {
+            return static::fromBuffer(tensor_buffer_fill(value, 1, n, dtype));
+        }
+
         return static::quick(array_fill(0, n, value));
     }
 
@@ -104,25 +150,18 @@ class Vector implements Tensor
      * Return a random uniform vector with values between 0 and 1.
      *
      * @param int n
+     * @param \Tensor\Random|null generator
      * @throws \Tensor\Exceptions\InvalidArgumentException
      * @return self
      */
-    public static function rand(const int n) -> <Vector>
+    public static function rand(const int n, <Random> generator = null) -> <Vector>
     {
         if unlikely n < 1 {
             throw new InvalidArgumentException("N must be"
                 . " greater than 0, " . strval(n) . " given.");
         }
 
-        array a = [];
-
-        int max = (int) getrandmax();
-
-        while count(a) < n {
-            let a[] = rand() / max;
-        }
-
-        return static::quick(a);
+        return static::fromBuffer(tensor_rand(1, n, generator ? generator->state() : null));
     }
 
     /**
@@ -130,100 +169,140 @@ class Vector implements Tensor
      * and unit variance.
      *
      * @param int n
+     * @param \Tensor\Random|null generator
      * @throws \Tensor\Exceptions\InvalidArgumentException
      * @return self
      */
-    public static function gaussian(const int n) -> <Vector>
+    public static function gaussian(const int n, <Random> generator = null) -> <Vector>
     {
         if unlikely n < 1 {
             throw new InvalidArgumentException("N must be"
                 . " greater than 0, " . strval(n) . " given.");
         }
 
-        float r, phi;
+        return static::fromBuffer(tensor_gaussian(1, n, generator ? generator->state() : null));
+    }
 
-        array a = [];
+    /**
+     * Generate a vector with n elements from a Poisson distribution.
+     *
+     * @param int n
+     * @param float lambda
+     * @param \Tensor\Random|null generator
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return self
+     */
+    public static function poisson(const int n, const float lambda = 1.0, <Random> generator = null) -> <Vector>
+    {
+        if unlikely n < 1 {
+            throw new InvalidArgumentException("N must be"
+                . " greater than 0, " . strval(n) . " given.");
+        }
 
-        int max = (int) getrandmax();
+        return static::fromBuffer(tensor_poisson(1, n, lambda, generator ? generator->state() : null));
+    }
 
-        while count(a) < n {
-            let r = sqrt(-2.0 * log(rand() / max));
+    /**
+     * Return a random uniformly distributed vector with values between -1 and 1.
+     *
+     * @param int n
+     * @param \Tensor\Random|null generator
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return self
+     */
+    public static function uniform(const int n, <Random> generator = null) -> <Vector>
+    {
+        if unlikely n < 1 {
+            throw new InvalidArgumentException("N must be"
+                . " greater than 0, " . strval(n) . " given.");
+        }
 
-            let phi = rand() / max * self::TWO_PI;
+        return static::fromBuffer(tensor_uniform(1, n, generator ? generator->state() : null));
+    }
 
-            let a[] = r * sin(phi);
-            let a[] = r * cos(phi);
+    /**
+     * Return a mask of ones with probability p and zeros otherwise such as for dropout.
+     *
+     * @param int n
+     * @param float p
+     * @param \Tensor\Random|null generator
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return self
+     */
+    public static function bernoulli(const int n, const float p = 0.5, <Random> generator = null) -> <Vector>
+    {
+        if unlikely n < 1 {
+            throw new InvalidArgumentException("N must be"
+                . " greater than 0, " . strval(n) . " given.");
         }
 
-        if count(a) > n {
-            array_pop(a);
+        if unlikely p < 0.0 || p > 1.0 {
+            throw new InvalidArgumentException("Probability must be"
+                . " between 0 and 1, " . strval(p) . " given.");
         }
 
-        return static::quick(a);
+        return static::fromBuffer(tensor_bernoulli(1, n, p, generator ? generator->state() : null));
     }
 
     /**
-     * Generate a vector with n elements from a Poisson distribution.
+     * Return a normally distributed random vector with values redrawn until they are within two
+     * standard deviations of the mean.
      *
      * @param int n
-     * @param float lambda
+     * @param float mean
+     * @param float std
+     * @param \Tensor\Random|null generator
      * @throws \Tensor\Exceptions\InvalidArgumentException
      * @return self
      */
-    public static function poisson(const int n, const float lambda = 1.0) -> <Vector>
+    public static function truncatedNormal(const int n, const float mean = 0.0, const float std = 1.0, <Random> generator = null) -> <Vector>
     {
         if unlikely n < 1 {
             throw new InvalidArgumentException("N must be"
                 . " greater than 0, " . strval(n) . " given.");
         }
 
-        float p, k;
-
-        array a = [];
-
-        float l = (float) exp(-lambda);
-
-        int max = (int) getrandmax();
-
-        while count(a) < n {
-            let k = 0.0;
-            let p = 1.0;
-
-            while p > l {
-                let k++;
-                
-                let p *= rand() / max;
-            }
-
-            let a[] = k - 1.0;
+        if unlikely std < 0.0 {
+            throw new InvalidArgumentException("Standard deviation"
+                . " must be greater than 0, " . strval(std) . " given.");
         }
 
-        return static::quick(a);
+        return static::fromBuffer(tensor_truncated_normal(1, n, mean, std, generator ? generator->state() : null));
     }
 
     /**
-     * Return a random uniformly distributed vector with values between -1 and 1.
+     * Draw n category offsets with the probabilities given by a vector of non-negative weights
+     * that do not need to sum to 1.
      *
      * @param int n
+     * @param \Tensor\Vector probabilities
+     * @param \Tensor\Random|null generator
      * @throws \Tensor\Exceptions\InvalidArgumentException
      * @return self
      */
-    public static function uniform(const int n) -> <Vector>
+    public static function categorical(const int n, const <Vector> probabilities, <Random> generator = null) -> <Vector>
     {
         if unlikely n < 1 {
             throw new InvalidArgumentException("N must be"
                 . " greater than 0, " . strval(n) . " given.");
         }
-        
-        array a = [];
 
-        int max = (int) getrandmax();
+        if unlikely probabilities->n() < 1 {
+            throw new InvalidArgumentException("Probabilities"
+                . " must contain at least 1 element.");
+        }
+
+        if unlikely probabilities->min() < 0.0 {
+            throw new InvalidArgumentException("Probabilities"
+                . " must not be negative.");
+        }
 
-        while count(a) < n {
-            let a[] = rand(-max, max) / max;
+        if unlikely probabilities->sum() <= 0.0 {
+            throw new InvalidArgumentException("Probabilities"
+                . " must sum to greater than 0.");
         }
 
-        return static::quick(a);
+        return static::fromBuffer(tensor_categorical(n, probabilities->asBuffer(), generator ? generator->state() : null));
     }
 
     /**
@@ -293,6 +372,7 @@ class Vector implements Tensor
         }
 
         let this->a = a;
+        let this->dtype = Dtype::FLOAT64;
         let this->n = count(a);
     }
 
@@ -353,9 +433,97 @@ class Vector implements Tensor
      */
     public function asArray() -> array
     {
+        if is_null(this->a) {
+            let this->a = tensor_buffer_to_vector(this->buffer);
+        }
+
         return this->a;
     }
 
+    /**
+     * Return the contiguous native buffer of doubles that backs the vector. Single precision
+     * vectors return a double precision copy of their buffer.
+     *
+     * @internal
+     *
+     * @return \Tensor\Buffer
+     */
+    public function asBuffer()
+    {
+        if this->dtype !== Dtype::FLOAT64 {
+            return tensor_buffer_cast(this->typedBuffer(), Dtype::FLOAT64);
+        }
+
+        return this->typedBuffer();
+    }
+
+    /**
+     * Return the contiguous native buffer that backs the vector in its own dtype.
+     *
+     * @internal
+     *
+     * @return \Tensor\Buffer
+     */
+    public function typedBuffer()
+    {
+        if is_null(this->buffer) {
+            let this->buffer = tensor_buffer_from_array(this->a);
+
+            if this->dtype !== Dtype::FLOAT64 {
+                let this->buffer = tensor_buffer_cast(this->buffer, this->dtype);
+            }
+        }
+
+        return this->buffer;
+    }
+
+    /**
+     * Return the precision that the elements of the vector are stored in.
+     *
+     * @return int
+     */
+    public function dtype() -> int
+    {
+        return this->dtype;
+    }
+
+    /**
+     * Return a copy of the vector with its elements converted to the given dtype.
+     *
+     * @param int dtype
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return self
+     */
+    public function asType(const int dtype) -> <Vector>
+    {
+        Dtype::check(dtype);
+
+        return static::fromBuffer(tensor_buffer_cast(this->typedBuffer(), dtype));
+    }
+
+    /**
+     * Unpack the elements into the array before the vector is serialized. The native buffer is
+     * not serializable and is rebuilt from the array on first use after unserializing.
+     *
+     * @return string[]
+     */
+    public function __sleep() -> array
+    {
+        this->asArray();
+
+        return ["a", "dtype", "n"];
+    }
+
+    /**
+     * Default the dtype of vectors that were serialized before it existed.
+     */
+    public function __wakeup() -> void
+    {
+        if is_null(this->dtype) {
+            let this->dtype = Dtype::FLOAT64;
+        }
+    }
+
     /**
      * Return this vector as a row matrix.
      *
@@ -363,7 +531,7 @@ class Vector implements Tensor
      */
     public function asRowMatrix() -> <Matrix>
     {
-        return Matrix::quick([this->a]);
+        return Matrix::quick([this->asArray()]);
     }
 
     /**
@@ -377,7 +545,7 @@ class Vector implements Tensor
 
         array b = [];
 
-        for valueA in this->a {
+        for valueA in this->asArray() {
             let b[] = [valueA];
         }
 
@@ -411,11 +579,13 @@ class Vector implements Tensor
         array b = [];
         array rowB = [];
 
+        var a = this->asArray();
+
         while count(b) < m {
             let rowB = [];
 
             while count(rowB) < n {
-                let rowB[] = this->a[i];
+                let rowB[] = a[i];
 
                 let i++;
             }
@@ -433,7 +603,7 @@ class Vector implements Tensor
      */
     public function transpose()
     {
-        return ColumnVector::quick(this->a);
+        return ColumnVector::quick(this->asArray());
     }
 
     /**
@@ -446,7 +616,7 @@ class Vector implements Tensor
      */
     public function map(const var callback) -> <Vector>
     {
-        return static::quick(array_map(callback, this->a));
+        return static::quick(array_map(callback, this->asArray()));
     }
 
     /**
@@ -460,7 +630,7 @@ class Vector implements Tensor
      */
     public function reduce(const var callback, float initial = 0.0) -> float
     {
-        return array_reduce(this->a, callback, initial);
+        return array_reduce(this->asArray(), callback, initial);
     }
 
     /**
@@ -478,7 +648,9 @@ class Vector implements Tensor
                 . (string) b->size() . ".");
         }
 
-        return tensor_dot(this->a, b->asArray());
+        this->checkDtype(b);
+
+        return tensor_dot(this->typedBuffer(), b->typedBuffer());
     }
 
     /**
@@ -501,18 +673,27 @@ class Vector implements Tensor
                 . " less than 1, " . strval(stride). " given.");
         }
 
-        return static::quick(tensor_convolve_1d(this->a, b->asArray(), stride));
+        this->checkDtype(b);
+
+        return static::fromBuffer(tensor_convolve_1d(this->typedBuffer(), b->typedBuffer(), stride));
     }
 
     /**
      * Compute the vector-matrix product of this vector and matrix b.
      *
      * @param \Tensor\Matrix b
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
      * @return \Tensor\Matrix
      */
     public function matmul(const <Matrix> b) -> <Matrix>
     {
-        return this->asRowMatrix()->matmul(b);
+        if unlikely this->n !== b->m() {
+            throw new DimensionalityMismatch("Matrix A requires "
+                . (string) this->n . " rows but Matrix B has "
+                . (string) b->m() . ".");
+        }
+
+        return Matrix::fromBuffer(b->transpose()->dot(this)->typedBuffer());
     }
 
     /**
@@ -534,25 +715,9 @@ class Vector implements Tensor
      */
     public function outer(const <Vector> b) -> <Matrix>
     {
-        var j, valueA, valueB;
-        
-        array bHat = [];
-        array c = [];
-        array rowC = [];
-
-        let bHat = (array) b->asArray();
+        this->checkDtype(b);
 
-        for valueA in this->a {
-            let rowC = [];
-
-            for j, valueB in bHat {
-                let rowC[] = valueA * valueB;
-            }
-
-            let c[] = rowC;
-        }
-
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_ger(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -562,7 +727,7 @@ class Vector implements Tensor
      */
     public function l1Norm() -> float
     {
-        return this->abs()->sum();
+        return tensor_l1_norm(this->asBuffer());
     }
 
     /**
@@ -572,7 +737,7 @@ class Vector implements Tensor
      */
     public function l2Norm() -> float
     {
-        return sqrt(this->square()->sum());
+        return tensor_l2_norm(this->asBuffer());
     }
 
     /**
@@ -589,7 +754,7 @@ class Vector implements Tensor
                 . " than 0, " . strval(p) . " given.");
         }
 
-        return pow(this->abs()->powScalar(p)->sum(), 1.0 / p);
+        return tensor_p_norm(this->asBuffer(), p);
     }
 
     /**
@@ -599,7 +764,7 @@ class Vector implements Tensor
      */
     public function maxNorm() -> float
     {
-        return (float) this->abs()->max();
+        return tensor_max_norm(this->asBuffer());
     }
 
     /**
@@ -972,6 +1137,111 @@ class Vector implements Tensor
             . " vector to the given input.");
     }
 
+    /**
+     * Compare this vector to another tensor or a scalar element-wise and return a mask that holds
+     * where the comparison does. The comparison is one of ==, !=, >, >=, <, or <=.
+     *
+     * @param mixed b
+     * @param string comparison
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return \Tensor\Mask
+     */
+    public function compare(const var b, const string comparison) -> <Mask>
+    {
+        int op = Mask::comparison(comparison);
+
+        switch (gettype(b)) {
+            case "object":
+                switch true {
+                    case b instanceof Matrix:
+                        if unlikely this->n !== b->n() {
+                            throw new DimensionalityMismatch("Vector A expects "
+                                . (string) this->n . " columns but Matrix B has "
+                                . (string) b->n() . ".");
+                        }
+
+                        this->checkDtype(b);
+
+                        return new Mask(tensor_compare(this->typedBuffer(), b->typedBuffer(), op, false));
+
+                    case b instanceof Vector:
+                        if unlikely this->n !== b->size() {
+                            throw new DimensionalityMismatch("Vector A requires "
+                                . (string) this->n . " elements but Vector B has "
+                                . (string) b->size() . ".");
+                        }
+
+                        this->checkDtype(b);
+
+                        return new Mask(tensor_compare(this->typedBuffer(), b->typedBuffer(), op, false), true);
+                }
+
+                break;
+
+            case "double":
+            case "integer":
+                return new Mask(tensor_compare(this->typedBuffer(), b, op, false), true);
+        }
+
+        throw new InvalidArgumentException("Cannot compare"
+            . " vector to the given input.");
+    }
+
+    /**
+     * Return the elements of this vector where the mask holds and the elements of vector or
+     * scalar B everywhere else.
+     *
+     * @param \Tensor\Mask mask
+     * @param mixed b
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function where(const <Mask> mask, const var b) -> <Vector>
+    {
+        if unlikely mask->shape() !== this->shape() {
+            throw new DimensionalityMismatch(this->shapeString()
+                . " mask expected but " . mask->shapeString() . " given.");
+        }
+
+        if b instanceof Vector {
+            if unlikely this->n !== b->size() {
+                throw new DimensionalityMismatch("Vector A requires "
+                    . (string) this->n . " elements but Vector B has "
+                    . (string) b->size() . ".");
+            }
+
+            this->checkDtype(b);
+
+            return static::fromBuffer(tensor_where(mask->asBuffer(), this->typedBuffer(), b->typedBuffer()));
+        }
+
+        if unlikely !is_int(b) && !is_float(b) {
+            throw new InvalidArgumentException("Cannot select from"
+                . " vector and the given input.");
+        }
+
+        return static::fromBuffer(tensor_where(mask->asBuffer(), this->typedBuffer(), b));
+    }
+
+    /**
+     * Return the sum of the elements of the vector where the mask holds.
+     *
+     * @param \Tensor\Mask mask
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return float
+     */
+    public function maskedSum(const <Mask> mask) -> float
+    {
+        if unlikely mask->shape() !== this->shape() {
+            throw new DimensionalityMismatch(this->shapeString()
+                . " mask expected but " . mask->shapeString() . " given.");
+        }
+
+        return tensor_vector_masked_sum(this->typedBuffer(), mask->asBuffer());
+    }
+
     /**
      * Return the reciprocal of the vector element-wise.
      *
@@ -1010,7 +1280,7 @@ class Vector implements Tensor
      */
     public function sqrt() -> <Vector>
     {
-        return this->map("sqrt");
+        return static::fromBuffer(tensor_sqrt(this->asBuffer()));
     }
 
     /**
@@ -1020,7 +1290,7 @@ class Vector implements Tensor
      */
     public function exp() -> <Vector>
     {
-        return this->map("exp");
+        return static::fromBuffer(tensor_exp(this->asBuffer()));
     }
 
     /**
@@ -1041,19 +1311,7 @@ class Vector implements Tensor
      */
     public function log(const float base = self::M_E) -> <Vector>
     {
-        if base === self::M_E {
-            return this->map("log");
-        }
-
-        var valueA;
-
-        array b = [];
-
-        for valueA in this->a {
-            let b[] = log(valueA, base);
-        }
-
-        return static::quick(b);
+        return static::fromBuffer(tensor_log(this->asBuffer(), base));
     }
 
     /**
@@ -1073,7 +1331,7 @@ class Vector implements Tensor
      */
     public function sin() -> <Vector>
     {
-        return this->map("sin");
+        return static::fromBuffer(tensor_sin(this->asBuffer()));
     }
 
     /**
@@ -1093,7 +1351,7 @@ class Vector implements Tensor
      */
     public function cos() -> <Vector>
     {
-        return this->map("cos");
+        return static::fromBuffer(tensor_cos(this->asBuffer()));
     }
 
     /**
@@ -1113,7 +1371,7 @@ class Vector implements Tensor
      */
     public function tan() -> <Vector>
     {
-        return this->map("tan");
+        return static::fromBuffer(tensor_tan(this->asBuffer()));
     }
 
     /**
@@ -1153,7 +1411,7 @@ class Vector implements Tensor
      */
     public function sum() -> float
     {
-        return (float) array_sum(this->a);
+        return tensor_vector_sum(this->asBuffer());
     }
 
     /**
@@ -1163,7 +1421,7 @@ class Vector implements Tensor
      */
     public function product() -> float
     {
-        return (float) array_product(this->a);
+        return tensor_vector_product(this->asBuffer());
     }
 
     /**
@@ -1173,7 +1431,7 @@ class Vector implements Tensor
      */
     public function min() -> float
     {
-        return (float) min(this->a);
+        return tensor_vector_min(this->asBuffer());
     }
 
     /**
@@ -1183,7 +1441,49 @@ class Vector implements Tensor
      */
     public function max() -> float
     {
-        return (float) max(this->a);
+        return tensor_vector_max(this->asBuffer());
+    }
+
+    /**
+     * Return the offset of the minimum element in the vector.
+     *
+     * @return int
+     */
+    public function argmin() -> int
+    {
+        return tensor_vector_argmin(this->asBuffer());
+    }
+
+    /**
+     * Return the offset of the maximum element in the vector.
+     *
+     * @return int
+     */
+    public function argmax() -> int
+    {
+        return tensor_vector_argmax(this->asBuffer());
+    }
+
+    /**
+     * Return the k largest or smallest values of the vector in rank order along with their offsets.
+     *
+     * @param int k
+     * @param bool largest
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return array{\Tensor\Vector,list<int>}
+     */
+    public function topK(const int k, const bool largest = true) -> array
+    {
+        var result;
+
+        if unlikely k < 1 || k > this->n {
+            throw new InvalidArgumentException("K must be between 1 and "
+                . (string) this->n . ", " . (string) k . " given.");
+        }
+
+        let result = tensor_top_k(this->asBuffer(), k, largest);
+
+        return [static::fromBuffer(result[0]), result[1][0]];
     }
 
     /**
@@ -1203,21 +1503,9 @@ class Vector implements Tensor
      */
     public function median() -> float
     {
-        var median;
-
-        int mid = (int) intdiv(this->n, 2);
-
-        var a = this->a;
+        var b = tensor_vector_quantiles(this->asBuffer(), [0.5]);
 
-        sort(a);
-
-        if this->n % 2 === 1 {
-            let median = a[mid];
-        } else {
-            let median = (a[mid - 1] + a[mid]) / 2.0;
-        }
-
-        return median;
+        return b[0];
     }
 
     /**
@@ -1234,19 +1522,35 @@ class Vector implements Tensor
                 . " between 0 and 1, " . strval(q) . " given.");
         }
 
-        var a = this->a;
-
-        sort(a);
+        var b = tensor_vector_quantiles(this->asBuffer(), [q]);
 
-        float x = q * (this->n - 1) + 1;
+        return b[0];
+    }
 
-        int xHat = (int) x;
+    /**
+     * Return several quantiles of the vector at once. The vector is only partitioned once for all of them.
+     *
+     * @param float[] q
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return float[]
+     */
+    public function quantiles(const array q) -> array
+    {
+        var value;
 
-        float remainder = x - xHat;
+        if unlikely empty q {
+            throw new InvalidArgumentException("At least one"
+                . " quantile must be given.");
+        }
 
-        float t = (float) a[xHat - 1];
+        for value in q {
+            if unlikely !is_numeric(value) || value < 0.0 || value > 1.0 {
+                throw new InvalidArgumentException("Q must be"
+                    . " between 0 and 1, " . strval(value) . " given.");
+            }
+        }
 
-        return t + remainder * (a[xHat] - t);
+        return tensor_vector_quantiles(this->asBuffer(), array_values(q));
     }
 
     /**
@@ -1296,7 +1600,7 @@ class Vector implements Tensor
 
         array b = [];
 
-        for valueA in this->a {
+        for valueA in this->asArray() {
             let b[] = round(valueA, precision);
         }
 
@@ -1343,7 +1647,7 @@ class Vector implements Tensor
 
         array b = [];
 
-        for valueA in this->a {
+        for valueA in this->asArray() {
             if valueA > max {
                 let b[] = max;
 
@@ -1374,7 +1678,7 @@ class Vector implements Tensor
 
         array b = [];
         
-        for valueA in this->a {
+        for valueA in this->asArray() {
             if valueA < min {
                 let b[] = min;
 
@@ -1399,7 +1703,7 @@ class Vector implements Tensor
 
         array b = [];
 
-        for valueA in this->a {
+        for valueA in this->asArray() {
             if valueA > max {
                 let b[] = max;
 
@@ -1423,7 +1727,7 @@ class Vector implements Tensor
 
         array b = [];
 
-        for valueA in this->a {
+        for valueA in this->asArray() {
             if valueA > 0 {
                 let b[] = 1.0;
             } elseif valueA < 0 {
@@ -1447,7 +1751,7 @@ class Vector implements Tensor
         
         array b = [];
 
-        for valueA in this->a {
+        for valueA in this->asArray() {
             let b[] = -valueA;
         }
 
@@ -1469,15 +1773,9 @@ class Vector implements Tensor
                 . (string) b->n() . ".");
         }
  
-        var rowB;
+        this->checkDtype(b);
 
-        array c = [];
- 
-        for rowB in b->asArray() {
-            let c[] = tensor_multiply(this->a, rowB);
-        }
- 
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_multiply(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1495,15 +1793,9 @@ class Vector implements Tensor
                 . (string) b->n() . ".");
         }
 
-        var rowB;
+        this->checkDtype(b);
 
-        array c = [];
- 
-        for rowB in b->asArray() {
-            let c[] = tensor_divide(this->a, rowB);
-        }
- 
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_divide(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1521,15 +1813,9 @@ class Vector implements Tensor
                 . (string) b->n() . ".");
         }
 
-        var rowB;
+        this->checkDtype(b);
 
-        array c = [];
- 
-        for rowB in b->asArray() {
-            let c[] = tensor_add(this->a, rowB);
-        }
- 
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_add(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1547,15 +1833,9 @@ class Vector implements Tensor
                 . (string) b->n() . ".");
         }
 
-        var rowB;
+        this->checkDtype(b);
 
-        array c = [];
- 
-        for rowB in b->asArray() {
-            let c[] = tensor_subtract(this->a, rowB);
-        }
- 
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_subtract(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1573,15 +1853,9 @@ class Vector implements Tensor
                 . (string) b->n() . ".");
         }
 
-        var rowB;
+        this->checkDtype(b);
 
-        array c = [];
- 
-        for rowB in b->asArray() {
-            let c[] = tensor_pow(this->a, rowB);
-        }
- 
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_pow(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1599,15 +1873,9 @@ class Vector implements Tensor
                 . (string) b->n() . ".");
         }
 
-        var rowB;
+        this->checkDtype(b);
 
-        array c = [];
- 
-        for rowB in b->asArray() {
-            let c[] = tensor_mod(this->a, rowB);
-        }
- 
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_mod(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1625,15 +1893,9 @@ class Vector implements Tensor
                 . (string) b->n() . ".");
         }
 
-        var rowB;
+        this->checkDtype(b);
 
-        array c = [];
- 
-        for rowB in b->asArray() {
-            let c[] = tensor_equal(this->a, rowB);
-        }
- 
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_equal(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1651,15 +1913,9 @@ class Vector implements Tensor
                 . (string) b->n() . ".");
         }
 
-        var rowB;
+        this->checkDtype(b);
 
-        array c = [];
- 
-        for rowB in b->asArray() {
-            let c[] = tensor_not_equal(this->a, rowB);
-        }
- 
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_not_equal(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1677,15 +1933,9 @@ class Vector implements Tensor
                 . (string) b->n() . ".");
         }
 
-        var rowB;
+        this->checkDtype(b);
 
-        array c = [];
- 
-        for rowB in b->asArray() {
-            let c[] = tensor_greater(this->a, rowB);
-        }
- 
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_greater(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1703,15 +1953,9 @@ class Vector implements Tensor
                 . (string) b->n() . ".");
         }
 
-        var rowB;
+        this->checkDtype(b);
 
-        array c = [];
- 
-        for rowB in b->asArray() {
-            let c[] = tensor_greater_equal(this->a, rowB);
-        }
- 
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_greater_equal(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1729,15 +1973,9 @@ class Vector implements Tensor
                 . (string) b->n() . ".");
         }
 
-        var rowB;
+        this->checkDtype(b);
 
-        array c = [];
- 
-        for rowB in b->asArray() {
-            let c[] = tensor_less(this->a, rowB);
-        }
- 
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_less(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1755,15 +1993,9 @@ class Vector implements Tensor
                 . (string) b->n() . ".");
         }
 
-        var rowB;
+        this->checkDtype(b);
 
-        array c = [];
- 
-        for rowB in b->asArray() {
-            let c[] = tensor_less_equal(this->a, rowB);
-        }
- 
-        return Matrix::quick(c);
+        return Matrix::fromBuffer(tensor_less_equal(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1781,7 +2013,9 @@ class Vector implements Tensor
                 . (string) b->size() . ".");
         }
 
-        return static::quick(tensor_multiply(this->a, b->asArray()));
+        this->checkDtype(b);
+
+        return static::fromBuffer(tensor_multiply(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1799,7 +2033,9 @@ class Vector implements Tensor
                 . (string) b->size() . ".");
         }
 
-        return static::quick(tensor_divide(this->a, b->asArray()));
+        this->checkDtype(b);
+
+        return static::fromBuffer(tensor_divide(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1817,7 +2053,9 @@ class Vector implements Tensor
                 . (string) b->size() . ".");
         }
 
-        return static::quick(tensor_add(this->a, b->asArray()));
+        this->checkDtype(b);
+
+        return static::fromBuffer(tensor_add(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1835,7 +2073,9 @@ class Vector implements Tensor
                 . (string) b->size() . ".");
         }
 
-        return static::quick(tensor_subtract(this->a, b->asArray()));
+        this->checkDtype(b);
+
+        return static::fromBuffer(tensor_subtract(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1853,7 +2093,9 @@ class Vector implements Tensor
                 . (string) b->size() . ".");
         }
 
-        return static::quick(tensor_pow(this->a, b->asArray()));
+        this->checkDtype(b);
+
+        return static::fromBuffer(tensor_pow(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1871,7 +2113,9 @@ class Vector implements Tensor
                 . (string) b->size() . ".");
         }
 
-        return static::quick(tensor_mod(this->a, b->asArray()));
+        this->checkDtype(b);
+
+        return static::fromBuffer(tensor_mod(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1890,7 +2134,9 @@ class Vector implements Tensor
                 . (string) b->size() . ".");
         }
 
-        return static::quick(tensor_equal(this->a, b->asArray()));
+        this->checkDtype(b);
+
+        return static::fromBuffer(tensor_equal(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1908,7 +2154,9 @@ class Vector implements Tensor
                 . (string) b->size() . ".");
         }
 
-        return static::quick(tensor_not_equal(this->a, b->asArray()));
+        this->checkDtype(b);
+
+        return static::fromBuffer(tensor_not_equal(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1926,7 +2174,9 @@ class Vector implements Tensor
                 . (string) b->size() . ".");
         }
 
-        return static::quick(tensor_greater(this->a, b->asArray()));
+        this->checkDtype(b);
+
+        return static::fromBuffer(tensor_greater(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1944,7 +2194,9 @@ class Vector implements Tensor
                 . (string) b->size() . ".");
         }
 
-        return static::quick(tensor_greater_equal(this->a, b->asArray()));
+        this->checkDtype(b);
+
+        return static::fromBuffer(tensor_greater_equal(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1962,7 +2214,9 @@ class Vector implements Tensor
                 . (string) b->size() . ".");
         }
 
-        return static::quick(tensor_less(this->a, b->asArray()));
+        this->checkDtype(b);
+
+        return static::fromBuffer(tensor_less(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1980,7 +2234,9 @@ class Vector implements Tensor
                 . (string) b->size() . ".");
         }
 
-        return static::quick(tensor_less_equal(this->a, b->asArray()));
+        this->checkDtype(b);
+
+        return static::fromBuffer(tensor_less_equal(this->typedBuffer(), b->typedBuffer()));
     }
 
     /**
@@ -1991,7 +2247,7 @@ class Vector implements Tensor
      */
      public function multiplyScalar(const float b) -> <Vector>
      {
-        return static::quick(tensor_multiply_scalar(this->a, b));
+        return static::fromBuffer(tensor_multiply_scalar(this->typedBuffer(), b));
     }
 
     /**
@@ -2002,7 +2258,7 @@ class Vector implements Tensor
      */
     public function divideScalar(const float b) -> <Vector>
     {
-        return static::quick(tensor_divide_scalar(this->a, b));
+        return static::fromBuffer(tensor_divide_scalar(this->typedBuffer(), b));
     }
 
     /**
@@ -2013,7 +2269,7 @@ class Vector implements Tensor
      */
     public function addScalar(const float b) -> <Vector>
     {
-        return static::quick(tensor_add_scalar(this->a, b));
+        return static::fromBuffer(tensor_add_scalar(this->typedBuffer(), b));
     }
 
     /**
@@ -2024,7 +2280,7 @@ class Vector implements Tensor
      */
     public function subtractScalar(const float b) -> <Vector>
     {
-        return static::quick(tensor_subtract_scalar(this->a, b));
+        return static::fromBuffer(tensor_subtract_scalar(this->typedBuffer(), b));
     }
 
     /**
@@ -2035,7 +2291,7 @@ class Vector implements Tensor
      */
      public function powScalar(const float b) -> <Vector>
      {
-        return static::quick(tensor_pow_scalar(this->a, b));
+        return static::fromBuffer(tensor_pow_scalar(this->typedBuffer(), b));
      }
 
     /**
@@ -2046,7 +2302,104 @@ class Vector implements Tensor
      */
     public function modScalar(const float b) -> <Vector>
     {
-        return static::quick(tensor_mod_scalar(this->a, b));
+        return static::fromBuffer(tensor_mod_scalar(this->typedBuffer(), b));
+    }
+
+    /**
+     * Add a vector to this vector in place. The existing buffer is updated rather than allocating
+     * a new vector so every reference to this vector observes the change.
+     *
+     * @param \Tensor\Vector b
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function addVectorInPlace(const <Vector> b) -> <Vector>
+    {
+        return this->axpy(1.0, b);
+    }
+
+    /**
+     * Subtract a vector from this vector in place.
+     *
+     * @param \Tensor\Vector b
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function subtractVectorInPlace(const <Vector> b) -> <Vector>
+    {
+        return this->axpy(-1.0, b);
+    }
+
+    /**
+     * Add alpha times vector X to this vector in place i.e. A = alpha * X + A.
+     *
+     * @param float alpha
+     * @param \Tensor\Vector x
+     * @throws \Tensor\Exceptions\DimensionalityMismatch
+     * @return self
+     */
+    public function axpy(const float alpha, const <Vector> x) -> <Vector>
+    {
+        if unlikely this->n !== x->size() {
+            throw new DimensionalityMismatch("Vector A requires "
+                . (string) this->n . " elements but Vector B has "
+                . (string) x->size() . ".");
+        }
+
+        this->checkDtype(x);
+
+        var bx = x->typedBuffer();
+        var buffer = this->typedBuffer();
+
+        let this->a = null;
+        let this->buffer = null;
+
+        let this->buffer = tensor_axpy_in_place(buffer, bx, alpha);
+
+        return this;
+    }
+
+    /**
+     * Multiply this vector by a scalar in place.
+     *
+     * @param float b
+     * @return self
+     */
+    public function multiplyScalarInPlace(const float b) -> <Vector>
+    {
+        var buffer = this->typedBuffer();
+
+        let this->a = null;
+        let this->buffer = null;
+
+        let this->buffer = tensor_scale_in_place(buffer, b);
+
+        return this;
+    }
+
+    /**
+     * Clip the elements of this vector to a given range in place.
+     *
+     * @param float min
+     * @param float max
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     * @return self
+     */
+    public function clipInPlace(const float min, const float max) -> <Vector>
+    {
+        if unlikely min > max {
+            throw new InvalidArgumentException("Minimum cannot be"
+                . " greater than maximum.");
+        }
+
+        var buffer = this->typedBuffer();
+
+        let this->a = null;
+        let this->buffer = null;
+
+        let this->buffer = tensor_clip_in_place(buffer, min, max);
+
+        return this;
     }
 
     /**
@@ -2057,7 +2410,7 @@ class Vector implements Tensor
      */
     public function equalScalar(const float b) -> <Vector>
     {
-        return static::quick(tensor_equal_scalar(this->a, b));
+        return static::fromBuffer(tensor_equal_scalar(this->typedBuffer(), b));
     }
 
     /**
@@ -2068,7 +2421,7 @@ class Vector implements Tensor
      */
     public function notEqualScalar(const float b) -> <Vector>
     {
-        return static::quick(tensor_not_equal_scalar(this->a, b));
+        return static::fromBuffer(tensor_not_equal_scalar(this->typedBuffer(), b));
     }
 
     /**
@@ -2079,7 +2432,7 @@ class Vector implements Tensor
      */
     public function greaterScalar(const float b) -> <Vector>
     {
-        return static::quick(tensor_greater_scalar(this->a, b));
+        return static::fromBuffer(tensor_greater_scalar(this->typedBuffer(), b));
     }
 
     /**
@@ -2091,7 +2444,7 @@ class Vector implements Tensor
      */
     public function greaterEqualScalar(const float b) -> <Vector>
     {
-        return static::quick(tensor_greater_equal_scalar(this->a, b));
+        return static::fromBuffer(tensor_greater_equal_scalar(this->typedBuffer(), b));
     }
 
     /**
@@ -2102,7 +2455,7 @@ class Vector implements Tensor
      */
     public function lessScalar(const float b) -> <Vector>
     {
-        return static::quick(tensor_less_scalar(this->a, b));
+        return static::fromBuffer(tensor_less_scalar(this->typedBuffer(), b));
     }
 
     /**
@@ -2114,7 +2467,7 @@ class Vector implements Tensor
      */
     public function lessEqualScalar(const float b) -> <Vector>
     {
-        return static::quick(tensor_less_equal_scalar(this->a, b));
+        return static::fromBuffer(tensor_less_equal_scalar(this->typedBuffer(), b));
     }
 
     /**
@@ -2145,7 +2498,9 @@ class Vector implements Tensor
      */
     public function offsetExists(const var index) -> bool
     {
-        return isset(this->a[index]);
+        var a = this->asArray();
+
+        return isset(a[index]);
     }
 
     /**
@@ -2168,7 +2523,9 @@ class Vector implements Tensor
     {
         var value;
 
-        if likely fetch value, this->a[index] {
+        var a = this->asArray();
+
+        if likely fetch value, a[index] {
             return value;
         }
 
@@ -2183,6 +2540,20 @@ class Vector implements Tensor
      */
     public function getIterator() -> <\Traversable>
     {
-        return new ArrayIterator(this->a);
+        return new ArrayIterator(this->asArray());
+    }
+    /**
+     * Throw an exception if the dtype of a tensor operand does not match this vector.
+     *
+     * @param \Tensor\Matrix|\Tensor\Vector b
+     * @throws \Tensor\Exceptions\InvalidArgumentException
+     */
+    protected function checkDtype(const var b) -> void
+    {
+        if unlikely b->dtype() !== this->dtype {
+            throw new InvalidArgumentException("Dtype " . Dtype::name(b->dtype())
+                . " does not match " . Dtype::name(this->dtype) . ","
+                . " convert one of the operands with asType().");
+        }
     }
 }
\ No newline at end of file
@@ -44,6 +44,35 @@ class ColumnVectorTest extends TestCase
         $this->assertInstanceOf(Special::class, $vector);
     }
 
+    /**
+     * @test
+     */
+    public function equalsAfterOperation() : void
+    {
+        $vector = ColumnVector::quick([1, 2, 3]);
+
+        $result = $vector->multiply(2)->add(1);
+
+        $expected = ColumnVector::quick([3, 5, 7]);
+
+        $this->assertInstanceOf(ColumnVector::class, $result);
+        $this->assertEquals($expected, $result);
+        $this->assertTrue($result == $expected);
+    }
+
+    /**
+     * @test
+     */
+    public function serialize() : void
+    {
+        $vector = ColumnVector::quick([1, 2, 3])->multiply(2);
+
+        $copy = unserialize(serialize($vector));
+
+        $this->assertInstanceOf(ColumnVector::class, $copy);
+        $this->assertEquals(ColumnVector::quick([2, 4, 6]), $copy);
+    }
+
     /**
      * @test
      */
@@ -0,0 +1,167 @@
+<?php
+
+namespace Tensor\Tests;
+
+use Tensor\Matrix;
+use Tensor\Context;
+use Tensor\Settings;
+use Tensor\Exceptions\RuntimeException;
+use Tensor\Exceptions\InvalidArgumentException;
+use PHPUnit\Framework\TestCase;
+
+/**
+ * @covers \Tensor\Context
+ */
+class ContextTest extends TestCase
+{
+    /**
+     * @var int
+     */
+    protected $threads;
+
+    /**
+     * @var bool
+     */
+    protected $fastMath;
+
+    protected function setUp() : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $this->threads = Settings::numThreads();
+        $this->fastMath = Settings::fastMath();
+
+        Settings::setNumThreads(2);
+        Settings::setFastMath(false);
+    }
+
+    protected function tearDown() : void
+    {
+        if (!extension_loaded('tensor')) {
+            return;
+        }
+
+        Settings::setNumThreads($this->threads);
+        Settings::setFastMath($this->fastMath);
+    }
+
+    /**
+     * @test
+     */
+    public function build() : void
+    {
+        $context = new Context(4, true, Context::SYSTEM_ALLOCATOR);
+
+        $this->assertInstanceOf(Context::class, $context);
+        $this->assertSame(4, $context->threads());
+        $this->assertTrue($context->fastMath());
+        $this->assertSame(Context::SYSTEM_ALLOCATOR, $context->allocator());
+    }
+
+    /**
+     * @test
+     */
+    public function badThreads() : void
+    {
+        $this->expectException(InvalidArgumentException::class);
+
+        new Context(0);
+    }
+
+    /**
+     * @test
+     */
+    public function badAllocator() : void
+    {
+        $this->expectException(InvalidArgumentException::class);
+
+        new Context(1, false, 2);
+    }
+
+    /**
+     * @test
+     */
+    public function run() : void
+    {
+        $context = new Context(4, true, Context::SYSTEM_ALLOCATOR);
+
+        $result = $context->run(function () {
+            $this->assertSame(4, Settings::numThreads());
+            $this->assertTrue(Settings::fastMath());
+
+            return Matrix::ones(2, 2)->sum()->asArray();
+        });
+
+        $this->assertEquals([2.0, 2.0], $result);
+
+        $this->assertSame(2, Settings::numThreads());
+        $this->assertFalse(Settings::fastMath());
+    }
+
+    /**
+     * @test
+     */
+    public function runRestoresAfterException() : void
+    {
+        $context = new Context(4, true, Context::SYSTEM_ALLOCATOR);
+
+        try {
+            $context->run(function () {
+                throw new \LogicException('Failed inside of the context.');
+            });
+
+            $this->fail('The exception was not rethrown.');
+        } catch (\LogicException $e) {
+            $this->assertEquals('Failed inside of the context.', $e->getMessage());
+        }
+
+        $this->assertSame(2, Settings::numThreads());
+        $this->assertFalse(Settings::fastMath());
+
+        $sum = Matrix::ones(2, 2)->sum();
+
+        $this->assertEquals([2.0, 2.0], $sum->asArray());
+
+        $context->enter();
+        $context->exit();
+
+        $this->assertSame(2, Settings::numThreads());
+    }
+
+    /**
+     * @test
+     */
+    public function nested() : void
+    {
+        $outer = new Context(4);
+        $inner = new Context(1, true);
+
+        $outer->enter();
+
+        $this->assertSame(4, Settings::numThreads());
+
+        $inner->run(function () {
+            $this->assertSame(1, Settings::numThreads());
+            $this->assertTrue(Settings::fastMath());
+        });
+
+        $this->assertSame(4, Settings::numThreads());
+        $this->assertFalse(Settings::fastMath());
+
+        $outer->exit();
+
+        $this->assertSame(2, Settings::numThreads());
+    }
+
+    /**
+     * @test
+     */
+    public function exitWithoutEnter() : void
+    {
+        $this->expectException(RuntimeException::class);
+
+        (new Context())->exit();
+    }
+}
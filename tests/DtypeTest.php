@@ -0,0 +1,321 @@
+<?php
+
+namespace Tensor\Tests;
+
+use Tensor\Dtype;
+use Tensor\Vector;
+use Tensor\Matrix;
+use Tensor\Exceptions\InvalidArgumentException;
+use PHPUnit\Framework\TestCase;
+
+/**
+ * @covers \Tensor\Dtype
+ */
+class DtypeTest extends TestCase
+{
+    /**
+     * The maximum relative error tolerated for single precision results.
+     *
+     * @var float
+     */
+    protected const MAX_DELTA = 1e-5;
+
+    /**
+     * @test
+     */
+    public function name() : void
+    {
+        $this->assertEquals('float64', Dtype::name(Dtype::FLOAT64));
+        $this->assertEquals('float32', Dtype::name(Dtype::FLOAT32));
+        $this->assertEquals('bool', Dtype::name(Dtype::BOOL));
+    }
+
+    /**
+     * @test
+     */
+    public function check() : void
+    {
+        $this->expectException(InvalidArgumentException::class);
+
+        Dtype::check(Dtype::BOOL);
+    }
+
+    /**
+     * @test
+     */
+    public function factories() : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $zeros = Matrix::zeros(2, 3, Dtype::FLOAT32);
+        $ones = Matrix::ones(2, 3, Dtype::FLOAT32);
+        $fill = Matrix::fill(0.5, 2, 3, Dtype::FLOAT32);
+
+        $this->assertSame(Dtype::FLOAT32, $zeros->dtype());
+        $this->assertSame(Dtype::FLOAT32, $ones->dtype());
+        $this->assertSame(Dtype::FLOAT32, $fill->dtype());
+
+        $this->assertEquals([[0.0, 0.0, 0.0], [0.0, 0.0, 0.0]], $zeros->asArray());
+        $this->assertEquals([[1.0, 1.0, 1.0], [1.0, 1.0, 1.0]], $ones->asArray());
+        $this->assertEquals([[0.5, 0.5, 0.5], [0.5, 0.5, 0.5]], $fill->asArray());
+
+        $this->assertSame(Dtype::FLOAT32, Vector::zeros(3, Dtype::FLOAT32)->dtype());
+        $this->assertSame(Dtype::FLOAT32, Vector::ones(3, Dtype::FLOAT32)->dtype());
+        $this->assertEquals([0.5, 0.5, 0.5], Vector::fill(0.5, 3, Dtype::FLOAT32)->asArray());
+
+        $this->assertSame(Dtype::FLOAT64, Matrix::zeros(2, 3)->dtype());
+    }
+
+    /**
+     * @test
+     */
+    public function badDtype() : void
+    {
+        $this->expectException(InvalidArgumentException::class);
+
+        Matrix::zeros(2, 3, Dtype::BOOL);
+    }
+
+    /**
+     * @test
+     */
+    public function float64() : void
+    {
+        $a = Matrix::quick([
+            [0.5, -1.25, 3.0],
+            [1024.0, 0.125, -7.5],
+        ]);
+
+        $this->assertSame(Dtype::FLOAT64, $a->dtype());
+        $this->assertSame(Dtype::FLOAT64, $a->asType(Dtype::FLOAT64)->dtype());
+        $this->assertEquals($a->asArray(), $a->asType(Dtype::FLOAT64)->asArray());
+        $this->assertEquals($a->asArray(), $a->asType(Dtype::FLOAT32)->asArray());
+
+        $this->assertSame(Dtype::FLOAT64, Vector::zeros(3)->dtype());
+        $this->assertEquals([1.0, 1.0, 1.0], Vector::ones(3, Dtype::FLOAT32)->asArray());
+        $this->assertEquals([[0.5, 0.5], [0.5, 0.5]], Matrix::fill(0.5, 2, 2, Dtype::FLOAT32)->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function badAsType() : void
+    {
+        $this->expectException(InvalidArgumentException::class);
+
+        Vector::ones(3)->asType(Dtype::BOOL);
+    }
+
+    /**
+     * @test
+     */
+    public function asType() : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $a = Matrix::quick([
+            [0.5, -1.25, 3.0],
+            [1024.0, 0.125, -7.5],
+        ]);
+
+        $b = $a->asType(Dtype::FLOAT32);
+
+        $this->assertSame(Dtype::FLOAT32, $b->dtype());
+        $this->assertEquals($a->asArray(), $b->asArray());
+
+        $c = $b->asType(Dtype::FLOAT64);
+
+        $this->assertSame(Dtype::FLOAT64, $c->dtype());
+        $this->assertEquals($a->asArray(), $c->asArray());
+
+        $this->assertEquals($a->asArray(), $a->asType(Dtype::FLOAT64)->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function asTypeRounds() : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $a = Vector::quick([0.1, 1.0 / 3.0, M_PI]);
+
+        $b = $a->asType(Dtype::FLOAT32)->asType(Dtype::FLOAT64);
+
+        $this->assertNotEquals($a->asArray(), $b->asArray());
+        $this->assertEqualsWithDelta($a->asArray(), $b->asArray(), self::MAX_DELTA);
+    }
+
+    /**
+     * @test
+     */
+    public function mixedDtypeMatrix() : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $this->expectException(InvalidArgumentException::class);
+
+        Matrix::ones(2, 2)->add(Matrix::ones(2, 2, Dtype::FLOAT32));
+    }
+
+    /**
+     * @test
+     */
+    public function mixedDtypeMatmul() : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $this->expectException(InvalidArgumentException::class);
+
+        Matrix::ones(2, 2, Dtype::FLOAT32)->matmul(Matrix::ones(2, 2));
+    }
+
+    /**
+     * @test
+     */
+    public function mixedDtypeVector() : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $this->expectException(InvalidArgumentException::class);
+
+        Vector::ones(3)->multiply(Vector::ones(3, Dtype::FLOAT32));
+    }
+
+    /**
+     * @test
+     */
+    public function arithmetic() : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $b = Matrix::quick([
+            [0.1, 0.2, 0.3],
+            [1.5, -2.5, 3.5],
+            [0.7, 0.9, -1.1],
+        ]);
+
+        $a32 = $a->asType(Dtype::FLOAT32);
+        $b32 = $b->asType(Dtype::FLOAT32);
+
+        $operations = [
+            'add' => [$a->add($b), $a32->add($b32)],
+            'subtract' => [$a->subtract($b), $a32->subtract($b32)],
+            'multiply' => [$a->multiply($b), $a32->multiply($b32)],
+            'divide' => [$a->divide($b), $a32->divide($b32)],
+            'scalar' => [$a->multiply(0.3), $a32->multiply(0.3)],
+            'row' => [$a->add(Vector::quick([0.1, 0.2, 0.3])), $a32->add(Vector::quick([0.1, 0.2, 0.3])->asType(Dtype::FLOAT32))],
+        ];
+
+        foreach ($operations as $name => [$expected, $actual]) {
+            $this->assertSame(Dtype::FLOAT32, $actual->dtype(), $name);
+            $this->assertEqualsWithDelta($expected->asArray(), $actual->asArray(), self::MAX_DELTA * 100.0, $name);
+        }
+    }
+
+    /**
+     * @test
+     */
+    public function matmul() : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $a = Matrix::rand(40, 30);
+        $b = Matrix::rand(30, 20);
+
+        $expected = $a->matmul($b);
+
+        $c = $a->asType(Dtype::FLOAT32)->matmul($b->asType(Dtype::FLOAT32));
+
+        $this->assertSame(Dtype::FLOAT32, $c->dtype());
+        $this->assertEqualsWithDelta($expected->asArray(), $c->asArray(), 30 * self::MAX_DELTA);
+    }
+
+    /**
+     * @test
+     */
+    public function dot() : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $a = Vector::quick([0.1, -2.5, 3.75, 4.0]);
+        $b = Vector::quick([1.5, 0.2, -0.3, 2.0]);
+
+        $expected = $a->dot($b);
+
+        $actual = $a->asType(Dtype::FLOAT32)->dot($b->asType(Dtype::FLOAT32));
+
+        $this->assertEqualsWithDelta($expected, $actual, self::MAX_DELTA);
+    }
+
+    /**
+     * @test
+     */
+    public function clipInPlace() : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $a = Matrix::quick([
+            [0.25, -1.5, 3.0],
+            [1.0, 0.75, -0.5],
+        ])->asType(Dtype::FLOAT32);
+
+        $a->clipInPlace(-1.0, 1.0);
+
+        $this->assertSame(Dtype::FLOAT32, $a->dtype());
+        $this->assertEquals([[0.25, -1.0, 1.0], [1.0, 0.75, -0.5]], $a->asArray());
+
+        $b = Vector::quick([0.25, -1.5, 3.0])->asType(Dtype::FLOAT32);
+
+        $b->clipInPlace(0.0, 2.0);
+
+        $this->assertSame(Dtype::FLOAT32, $b->dtype());
+        $this->assertEquals([0.25, 0.0, 2.0], $b->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function clip() : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $a = Matrix::quick([
+            [0.25, -1.5, 3.0],
+            [1.0, 0.75, -0.5],
+        ])->asType(Dtype::FLOAT32);
+
+        $this->assertSame(Dtype::FLOAT32, $a->clip(-1.0, 1.0)->dtype());
+        $this->assertEquals([[0.25, -1.0, 1.0], [1.0, 0.75, -0.5]], $a->clip(-1.0, 1.0)->asArray());
+        $this->assertEquals([[0.25, 0.0, 3.0], [1.0, 0.75, 0.0]], $a->clipLower(0.0)->asArray());
+        $this->assertEquals([[0.25, -1.5, 0.5], [0.5, 0.5, -0.5]], $a->clipUpper(0.5)->asArray());
+    }
+}
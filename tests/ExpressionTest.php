@@ -0,0 +1,231 @@
+<?php
+
+namespace Tensor\Tests;
+
+use Tensor\Vector;
+use Tensor\Matrix;
+use Tensor\Expression;
+use Tensor\ColumnVector;
+use Tensor\Exceptions\DimensionalityMismatch;
+use Tensor\Exceptions\InvalidArgumentException;
+use PHPUnit\Framework\TestCase;
+
+/**
+ * @covers \Tensor\Expression
+ */
+class ExpressionTest extends TestCase
+{
+    /**
+     * The maximum error tolerated due to varying numerical precision.
+     *
+     * @var float
+     */
+    protected const MAX_DELTA = 1e-8;
+
+    /**
+     * @test
+     */
+    public function build() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $this->assertInstanceOf(Expression::class, $a->expr());
+    }
+
+    /**
+     * @test
+     */
+    public function evaluateEmpty() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $b = $a->expr()->evaluate();
+
+        $this->assertEquals($a->asArray(), $b->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function evaluateColumnVector() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $c = ColumnVector::quick([2.0, -1.0, 0.5]);
+
+        $b = $a->expr()->subtract($c)->square()->evaluate();
+
+        $expected = [
+            [400.0, 361.0, 100.0],
+            [25.0, 144.0, 1.0],
+            [380.25, 42.25, 90.25],
+        ];
+
+        $this->assertEqualsWithDelta($expected, $b->asArray(), self::MAX_DELTA);
+    }
+
+    /**
+     * @test
+     */
+    public function evaluateVector() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $v = Vector::quick([1.0, 2.0, 3.0]);
+
+        $b = $a->expr()->multiply($v)->add(1)->divide(2.0)->clip(-5.0, 5.0)->evaluate();
+
+        $expected = [
+            [5.0, -5.0, 5.0],
+            [2.5, 5.0, -2.5],
+            [5.0, -5.0, -5.0],
+        ];
+
+        $this->assertEqualsWithDelta($expected, $b->asArray(), self::MAX_DELTA);
+    }
+
+    /**
+     * @test
+     */
+    public function evaluateMatrix() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $c = Matrix::quick([
+            [1.0, 2.0, 3.0],
+            [4.0, 5.0, 6.0],
+            [7.0, 8.0, 9.0],
+        ]);
+
+        $b = $a->expr()->multiply($c)->abs()->sqrt()->log()->negate()->evaluate();
+
+        $expected = $a->multiplyMatrix($c)->abs()->sqrt()->log()->negate();
+
+        $this->assertEqualsWithDelta($expected->asArray(), $b->asArray(), self::MAX_DELTA);
+    }
+
+    /**
+     * @test
+     */
+    public function evaluateComparison() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $b = $a->expr()->greater(0.0)->evaluate();
+
+        $expected = $a->greaterScalar(0.0);
+
+        $this->assertEquals($expected->asArray(), $b->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function sum() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $c = ColumnVector::quick([2.0, -1.0, 0.5]);
+
+        $b = $a->expr()->subtract($c)->square()->sum();
+
+        $expected = ColumnVector::quick([861.0, 170.0, 512.75]);
+
+        $this->assertEqualsWithDelta($expected->asArray(), $b->asArray(), self::MAX_DELTA);
+    }
+
+    /**
+     * @test
+     */
+    public function sumLongRows() : void
+    {
+        $a = Matrix::fill(0.1, 2, 100000);
+
+        $b = $a->expr()->multiply(1.0)->sum();
+
+        $expected = $a->sum();
+
+        $this->assertEqualsWithDelta($expected->asArray(), $b->asArray(), 1e-9);
+    }
+
+    /**
+     * @test
+     */
+    public function reuse() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $expr = $a->expr()->multiply(2.0);
+
+        $b = $expr->add(1.0)->evaluate();
+        $c = $expr->subtract(1.0)->evaluate();
+
+        $this->assertEquals($a->multiply(2.0)->add(1.0)->asArray(), $b->asArray());
+        $this->assertEquals($a->multiply(2.0)->subtract(1.0)->asArray(), $c->asArray());
+        $this->assertEquals($a->multiply(2.0)->asArray(), $expr->evaluate()->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function dimensionalityMismatch() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $this->expectException(DimensionalityMismatch::class);
+
+        $a->expr()->add(Vector::quick([1.0, 2.0]));
+    }
+
+    /**
+     * @test
+     */
+    public function invalidOperand() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $this->expectException(InvalidArgumentException::class);
+
+        $a->expr()->add('foo');
+    }
+}
@@ -0,0 +1,425 @@
+<?php
+
+namespace Tensor\Tests;
+
+use Tensor\Mask;
+use Tensor\Dtype;
+use Tensor\Vector;
+use Tensor\Matrix;
+use Tensor\ColumnVector;
+use Tensor\Exceptions\InvalidArgumentException;
+use Tensor\Exceptions\DimensionalityMismatch;
+use PHPUnit\Framework\TestCase;
+
+/**
+ * @covers \Tensor\Mask
+ */
+class MaskTest extends TestCase
+{
+    /**
+     * The maximum error tolerated due to varying numerical precision.
+     *
+     * @var float
+     */
+    protected const MAX_DELTA = 1e-8;
+
+    /**
+     * @var \Tensor\Matrix
+     */
+    protected $a;
+
+    /**
+     * @var \Tensor\Matrix
+     */
+    protected $b;
+
+    protected function setUp() : void
+    {
+        $this->a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $this->b = Matrix::quick([
+            [13.0, -17.0, 1.0],
+            [4.0, 20.0, -5.0],
+            [25.0, -6.0, -9.0],
+        ]);
+    }
+
+    /**
+     * @test
+     */
+    public function compareMatrix() : void
+    {
+        $mask = $this->a->compare($this->b, '>');
+
+        $this->assertInstanceOf(Mask::class, $mask);
+        $this->assertEquals([3, 3], $mask->shape());
+        $this->assertEquals('3 x 3', $mask->shapeString());
+        $this->assertEquals(9, $mask->size());
+
+        $expected = [
+            [true, false, true],
+            [false, false, true],
+            [false, false, false],
+        ];
+
+        $this->assertSame($expected, $mask->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function compareOperators() : void
+    {
+        $expected = [
+            '==' => [[false, true, false], [true, false, false], [false, true, true]],
+            '!=' => [[true, false, true], [false, true, true], [true, false, false]],
+            '>' => [[true, false, true], [false, false, true], [false, false, false]],
+            '>=' => [[true, true, true], [true, false, true], [false, true, true]],
+            '<' => [[false, false, false], [false, true, false], [true, false, false]],
+            '<=' => [[false, true, false], [true, true, false], [true, true, true]],
+        ];
+
+        foreach ($expected as $comparison => $values) {
+            $this->assertSame($values, $this->a->compare($this->b, $comparison)->asArray(), $comparison);
+        }
+    }
+
+    /**
+     * @test
+     */
+    public function compareScalar() : void
+    {
+        $mask = $this->a->compare(0, '>=');
+
+        $expected = [
+            [true, false, true],
+            [true, true, false],
+            [true, false, false],
+        ];
+
+        $this->assertSame($expected, $mask->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function compareRowVector() : void
+    {
+        $mask = $this->a->compare(Vector::quick([4.0, -6.0, 12.0]), '<=');
+
+        $expected = [
+            [false, true, true],
+            [true, false, true],
+            [false, true, true],
+        ];
+
+        $this->assertSame($expected, $mask->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function compareColumnVector() : void
+    {
+        $mask = $this->a->compare(ColumnVector::quick([12.0, 4.0, -6.0]), '==');
+
+        $expected = [
+            [false, false, true],
+            [true, false, false],
+            [false, true, false],
+        ];
+
+        $this->assertSame($expected, $mask->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function vectorCompareMatrix() : void
+    {
+        $mask = Vector::quick([4.0, -6.0, 12.0])->compare($this->a, '>=');
+
+        $expected = [
+            [false, true, true],
+            [true, false, true],
+            [false, true, true],
+        ];
+
+        $this->assertEquals([3, 3], $mask->shape());
+        $this->assertSame($expected, $mask->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function columnVectorCompareMatrix() : void
+    {
+        $mask = ColumnVector::quick([12.0, 4.0, -6.0])->compare($this->a, '==');
+
+        $expected = [
+            [false, false, true],
+            [true, false, false],
+            [false, true, false],
+        ];
+
+        $this->assertEquals([3, 3], $mask->shape());
+        $this->assertSame($expected, $mask->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function compareVector() : void
+    {
+        $mask = Vector::quick([1.0, 5.0, -3.0])->compare(Vector::quick([2.0, 5.0, -4.0]), '<');
+
+        $this->assertEquals([3], $mask->shape());
+        $this->assertEquals('3', $mask->shapeString());
+        $this->assertSame([true, false, false], $mask->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function compareFloat32() : void
+    {
+        $a = $this->a->asType(Dtype::FLOAT32);
+        $b = $this->b->asType(Dtype::FLOAT32);
+
+        $this->assertSame($this->a->compare($this->b, '>')->asArray(), $a->compare($b, '>')->asArray());
+        $this->assertSame($this->a->compare(0.5, '<')->asArray(), $a->compare(0.5, '<')->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function compareMixedDtype() : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $this->expectException(InvalidArgumentException::class);
+
+        $this->a->compare($this->b->asType(Dtype::FLOAT32), '>');
+    }
+
+    /**
+     * @test
+     */
+    public function compareBadComparison() : void
+    {
+        $this->expectException(InvalidArgumentException::class);
+
+        $this->a->compare($this->b, '<>');
+    }
+
+    /**
+     * @test
+     */
+    public function compareMismatch() : void
+    {
+        $this->expectException(DimensionalityMismatch::class);
+
+        $this->a->compare(Matrix::quick([[1.0, 2.0]]), '>');
+    }
+
+    /**
+     * @test
+     */
+    public function logicalAnd() : void
+    {
+        $mask = $this->a->compare(0, '>')->logicalAnd($this->a->compare(15, '<'));
+
+        $expected = [
+            [false, false, true],
+            [true, true, false],
+            [false, false, false],
+        ];
+
+        $this->assertSame($expected, $mask->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function logicalOr() : void
+    {
+        $mask = $this->a->compare(20, '>=')->logicalOr($this->a->compare(-9, '<='));
+
+        $expected = [
+            [true, true, false],
+            [false, false, false],
+            [true, false, true],
+        ];
+
+        $this->assertSame($expected, $mask->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function logicalNot() : void
+    {
+        $mask = $this->a->compare(0, '>')->logicalNot();
+
+        $expected = [
+            [false, true, false],
+            [false, false, true],
+            [false, true, true],
+        ];
+
+        $this->assertSame($expected, $mask->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function logicalMismatch() : void
+    {
+        $this->expectException(DimensionalityMismatch::class);
+
+        $this->a->compare(0, '>')->logicalAnd(Vector::quick([1.0])->compare(0, '>'));
+    }
+
+    /**
+     * @test
+     */
+    public function countAnyAll() : void
+    {
+        $mask = $this->a->compare(0, '>');
+
+        $this->assertSame(5, $mask->count());
+        $this->assertTrue($mask->any());
+        $this->assertFalse($mask->all());
+
+        $none = $this->a->compare(100, '>');
+
+        $this->assertSame(0, $none->count());
+        $this->assertFalse($none->any());
+        $this->assertFalse($none->all());
+
+        $every = $this->a->compare(-100, '>');
+
+        $this->assertSame(9, $every->count());
+        $this->assertTrue($every->any());
+        $this->assertTrue($every->all());
+    }
+
+    /**
+     * @test
+     */
+    public function whereMatrix() : void
+    {
+        $c = $this->a->where($this->a->compare($this->b, '>'), $this->b);
+
+        $expected = [
+            [22.0, -17.0, 12.0],
+            [4.0, 20.0, -2.0],
+            [25.0, -6.0, -9.0],
+        ];
+
+        $this->assertInstanceOf(Matrix::class, $c);
+        $this->assertEquals($expected, $c->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function whereScalar() : void
+    {
+        $c = $this->a->where($this->a->compare(0, '>'), 0);
+
+        $expected = [
+            [22.0, 0.0, 12.0],
+            [4.0, 11.0, 0.0],
+            [20.0, 0.0, 0.0],
+        ];
+
+        $this->assertEquals($expected, $c->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function whereVector() : void
+    {
+        $a = Vector::quick([1.0, -2.0, 3.0, -4.0]);
+
+        $c = $a->where($a->compare(0, '<'), Vector::quick([10.0, 20.0, 30.0, 40.0]));
+
+        $this->assertInstanceOf(Vector::class, $c);
+        $this->assertEquals([10.0, -2.0, 30.0, -4.0], $c->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function whereFloat32() : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $a = $this->a->asType(Dtype::FLOAT32);
+
+        $c = $a->where($a->compare(0, '>'), -1.5);
+
+        $expected = [
+            [22.0, -1.5, 12.0],
+            [4.0, 11.0, -1.5],
+            [20.0, -1.5, -1.5],
+        ];
+
+        $this->assertSame(Dtype::FLOAT32, $c->dtype());
+        $this->assertEqualsWithDelta($expected, $c->asArray(), self::MAX_DELTA);
+    }
+
+    /**
+     * @test
+     */
+    public function whereMismatch() : void
+    {
+        $this->expectException(DimensionalityMismatch::class);
+
+        $this->a->where(Vector::quick([1.0])->compare(0, '>'), 0);
+    }
+
+    /**
+     * @test
+     */
+    public function maskedSum() : void
+    {
+        $sum = $this->a->maskedSum($this->a->compare(0, '>'));
+
+        $this->assertInstanceOf(ColumnVector::class, $sum);
+        $this->assertEqualsWithDelta([34.0, 15.0, 20.0], $sum->asArray(), self::MAX_DELTA);
+    }
+
+    /**
+     * @test
+     */
+    public function maskedSumFloat32() : void
+    {
+        $a = $this->a->asType(Dtype::FLOAT32);
+
+        $sum = $a->maskedSum($a->compare(0, '<'));
+
+        $this->assertEqualsWithDelta([-17.0, -2.0, -15.0], $sum->asArray(), self::MAX_DELTA);
+    }
+
+    /**
+     * @test
+     */
+    public function vectorMaskedSum() : void
+    {
+        $a = Vector::quick([1.5, -2.0, 3.0, -4.0]);
+
+        $this->assertEqualsWithDelta(4.5, $a->maskedSum($a->compare(0, '>')), self::MAX_DELTA);
+        $this->assertEqualsWithDelta(-6.0, $a->asType(Dtype::FLOAT32)->maskedSum($a->compare(0, '<')), self::MAX_DELTA);
+    }
+}
@@ -5,7 +5,9 @@ namespace Tensor\Tests;
 use Tensor\Tensor;
 use Tensor\Vector;
 use Tensor\Matrix;
+use Tensor\Random;
 use Tensor\Special;
+use Tensor\Settings;
 use Tensor\ArrayLike;
 use Tensor\Algebraic;
 use Tensor\Arithmetic;
@@ -19,6 +21,7 @@ use Tensor\Decompositions\LU;
 use Tensor\Decompositions\SVD;
 use Tensor\Decompositions\Eigen;
 use Tensor\Decompositions\Cholesky;
+use Tensor\Exceptions\InvalidArgumentException;
 use PHPUnit\Framework\TestCase;
 use Generator;
 
@@ -56,6 +59,93 @@ class MatrixTest extends TestCase
         $this->assertInstanceOf(Special::class, $matrix);
     }
 
+    /**
+     * @test
+     */
+    public function equalsAfterOperation() : void
+    {
+        $matrix = Matrix::quick([
+            [1, 2, 3],
+            [4, 5, 6],
+        ]);
+
+        $result = $matrix->multiply(2)->add(1);
+
+        $expected = Matrix::quick([
+            [3, 5, 7],
+            [9, 11, 13],
+        ]);
+
+        $this->assertEquals($expected, $result);
+        $this->assertTrue($result == $expected);
+        $this->assertFalse($result == $matrix->add(1));
+    }
+
+    /**
+     * @test
+     */
+    public function equalsTransposed() : void
+    {
+        $matrix = Matrix::quick([
+            [1, 2, 3],
+            [4, 5, 6],
+        ]);
+
+        $expected = Matrix::quick([
+            [1, 4],
+            [2, 5],
+            [3, 6],
+        ]);
+
+        $this->assertEquals($expected, $matrix->transpose());
+        $this->assertEquals($matrix, $matrix->transpose()->transpose());
+    }
+
+    /**
+     * @test
+     */
+    public function serialize() : void
+    {
+        $matrix = Matrix::quick([
+            [1, 2, 3],
+            [4, 5, 6],
+        ])->multiply(2)->transpose();
+
+        $copy = unserialize(serialize($matrix));
+
+        $expected = Matrix::quick([
+            [2, 8],
+            [4, 10],
+            [6, 12],
+        ]);
+
+        $this->assertEquals($expected, $copy);
+        $this->assertEquals($matrix, $copy);
+        $this->assertEquals($expected, $copy->add(0));
+    }
+
+    /**
+     * @test
+     */
+    public function quickUnindexedRaggedRows() : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $matrix = Matrix::quick([
+            1 => [1, 2, 3],
+            2 => [4, 5],
+        ]);
+
+        $expected = [
+            [1, 2, 3],
+            [4, 5, 0],
+        ];
+
+        $this->assertEquals($expected, $matrix->add(0)->asArray());
+    }
+
     /**
      * @test
      */
@@ -179,6 +269,143 @@ class MatrixTest extends TestCase
         $this->assertCount(9, $matrix);
     }
 
+    /**
+     * @return \Generator<mixed[]>
+     */
+    public function momentsProvider() : Generator
+    {
+        yield 'rand' => [function (Random $generator) {
+            return Matrix::rand(201, 199, $generator);
+        }, 0.5, 1.0 / 12.0, 0.01, 0.005];
+
+        yield 'uniform' => [function (Random $generator) {
+            return Matrix::uniform(201, 199, $generator);
+        }, 0.0, 1.0 / 3.0, 0.02, 0.01];
+
+        yield 'gaussian' => [function (Random $generator) {
+            return Matrix::gaussian(201, 199, $generator);
+        }, 0.0, 1.0, 0.03, 0.04];
+
+        yield 'gaussian fast math' => [function (Random $generator) {
+            $enabled = Settings::fastMath();
+
+            try {
+                Settings::setFastMath(true);
+
+                return Matrix::gaussian(201, 199, $generator);
+            } finally {
+                Settings::setFastMath($enabled);
+            }
+        }, 0.0, 1.0, 0.03, 0.04];
+
+        yield 'poisson 2' => [function (Random $generator) {
+            return Matrix::poisson(201, 199, 2.0, $generator);
+        }, 2.0, 2.0, 0.05, 0.1];
+
+        yield 'poisson 10' => [function (Random $generator) {
+            return Matrix::poisson(201, 199, 10.0, $generator);
+        }, 10.0, 10.0, 0.15, 0.5];
+
+        yield 'poisson 40' => [function (Random $generator) {
+            return Matrix::poisson(201, 199, 40.0, $generator);
+        }, 40.0, 40.0, 0.2, 2.0];
+    }
+
+    /**
+     * @test
+     * @dataProvider momentsProvider
+     *
+     * @param callable $factory
+     * @param float $mean
+     * @param float $variance
+     * @param float $meanDelta
+     * @param float $varianceDelta
+     */
+    public function moments(callable $factory, float $mean, float $variance, float $meanDelta, float $varianceDelta) : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $samples = array_merge(...$factory(new Random(7))->asArray());
+
+        $this->assertCount(201 * 199, $samples);
+
+        $actualMean = array_sum($samples) / count($samples);
+
+        $actualVariance = 0.0;
+
+        foreach ($samples as $sample) {
+            $this->assertTrue(is_finite($sample));
+
+            $actualVariance += ($sample - $actualMean) ** 2;
+        }
+
+        $actualVariance /= count($samples) - 1;
+
+        $this->assertEqualsWithDelta($mean, $actualMean, $meanDelta);
+        $this->assertEqualsWithDelta($variance, $actualVariance, $varianceDelta);
+    }
+
+    /**
+     * @test
+     */
+    public function poissonCounts() : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        foreach ([2.0, 40.0] as $lambda) {
+            foreach (array_merge(...Matrix::poisson(31, 17, $lambda, new Random(7))->asArray()) as $count) {
+                $this->assertGreaterThanOrEqual(0.0, $count);
+                $this->assertEquals(floor($count), $count);
+            }
+        }
+    }
+
+    /**
+     * @test
+     */
+    public function bernoulli() : void
+    {
+        $matrix = Matrix::bernoulli(4, 4, 0.3);
+
+        $this->assertCount(16, $matrix);
+    }
+
+    /**
+     * @test
+     */
+    public function truncatedNormal() : void
+    {
+        $matrix = Matrix::truncatedNormal(3, 3, 0.0, 1.0);
+
+        $this->assertCount(9, $matrix);
+        $this->assertLessThanOrEqual(2.0, $matrix->abs()->max()->max());
+    }
+
+    /**
+     * @test
+     */
+    public function glorot() : void
+    {
+        $matrix = Matrix::glorot(3, 3);
+
+        $this->assertCount(9, $matrix);
+        $this->assertLessThanOrEqual(1.0, $matrix->abs()->max()->max());
+    }
+
+    /**
+     * @test
+     */
+    public function he() : void
+    {
+        $matrix = Matrix::he(3, 6, true);
+
+        $this->assertCount(18, $matrix);
+    }
+
     /**
      * @test
      */
@@ -441,6 +668,39 @@ class MatrixTest extends TestCase
         $this->assertEquals($expected, $b);
     }
 
+    /**
+     * @test
+     */
+    public function matmulTransposed() : void
+    {
+        $a = Matrix::quick([
+            [1.0, 2.0],
+            [3.0, 4.0],
+            [5.0, 6.0],
+        ]);
+
+        $b = $a->transpose()->matmul($a);
+
+        $expected = Matrix::quick([
+            [35.0, 44.0],
+            [44.0, 56.0],
+        ]);
+
+        $this->assertEqualsWithDelta($expected, $b, self::MAX_DELTA);
+
+        $c = $a->matmul($a->transpose());
+
+        $expected = Matrix::quick([
+            [5.0, 11.0, 17.0],
+            [11.0, 25.0, 39.0],
+            [17.0, 39.0, 61.0],
+        ]);
+
+        $this->assertEqualsWithDelta($expected, $c, self::MAX_DELTA);
+
+        $this->assertEquals($a->asArray(), $a->transpose()->transpose()->asArray());
+    }
+
     /**
      * @test
      */
@@ -860,6 +1120,138 @@ class MatrixTest extends TestCase
         $this->assertEqualsWithDelta($expected, $c, self::MAX_DELTA);
     }
 
+    /**
+     * @test
+     */
+    public function gemm() : void
+    {
+        $a = Matrix::quick([
+            [1.0, 2.0],
+            [3.0, 4.0],
+            [5.0, 6.0],
+        ]);
+
+        $b = Matrix::quick([
+            [1.0, 0.0, -1.0],
+            [2.0, 1.0, 0.5],
+        ]);
+
+        $c = $a->gemm($b, true, true, 0.5);
+
+        $expected = Matrix::quick([
+            [-2.0, 3.75],
+            [-2.0, 5.5],
+        ]);
+
+        $this->assertEqualsWithDelta($expected, $c, self::MAX_DELTA);
+
+        $d = Matrix::ones(2, 2);
+
+        $e = $a->gemm($a, true, false, 1.0, 2.0, $d);
+
+        $expected = [
+            [37.0, 46.0],
+            [46.0, 58.0],
+        ];
+
+        $this->assertSame($d, $e);
+        $this->assertEqualsWithDelta($expected, $d->asArray(), self::MAX_DELTA);
+    }
+
+    /**
+     * @test
+     */
+    public function gemmEmptyInnerDimension() : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $a = Matrix::quick([[], []]);
+        $b = Matrix::quick([[], [], []]);
+
+        $c = $a->gemm($b, false, true);
+
+        $this->assertEquals([[0.0, 0.0, 0.0], [0.0, 0.0, 0.0]], $c->asArray());
+
+        $d = Matrix::fill(1.5, 2, 3);
+
+        $a->gemm($b, false, true, 1.0, 2.0, $d);
+
+        $this->assertEquals([[3.0, 3.0, 3.0], [3.0, 3.0, 3.0]], $d->asArray());
+
+        $this->assertEquals([[0.0, 0.0], [0.0, 0.0]], $a->gram()->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function gram() : void
+    {
+        $a = Matrix::quick([
+            [1.0, 2.0],
+            [3.0, 4.0],
+            [5.0, 6.0],
+        ]);
+
+        $b = $a->gram(true, 0.5);
+
+        $expected = Matrix::quick([
+            [17.5, 22.0],
+            [22.0, 28.0],
+        ]);
+
+        $this->assertEqualsWithDelta($expected, $b, self::MAX_DELTA);
+
+        $c = $a->gram();
+
+        $expected = Matrix::quick([
+            [5.0, 11.0, 17.0],
+            [11.0, 25.0, 39.0],
+            [17.0, 39.0, 61.0],
+        ]);
+
+        $this->assertEqualsWithDelta($expected, $c, self::MAX_DELTA);
+    }
+
+    /**
+     * @test
+     */
+    public function pairwiseDistances() : void
+    {
+        $a = Matrix::quick([
+            [0.0, 0.0],
+            [3.0, 4.0],
+        ]);
+
+        $b = Matrix::quick([
+            [0.0, 0.0],
+            [1.0, 0.0],
+            [3.0, 4.0],
+        ]);
+
+        $expected = Matrix::quick([
+            [0.0, 1.0, 5.0],
+            [5.0, 4.47213595499958, 0.0],
+        ]);
+
+        $this->assertEqualsWithDelta($expected, $a->pairwiseDistances($b), self::MAX_DELTA);
+
+        $expected = Matrix::quick([
+            [1.0, 1.0, 1.0],
+            [1.0, 0.4, 0.0],
+        ]);
+
+        $this->assertEqualsWithDelta($expected, $a->pairwiseDistances($b, 'cosine'), self::MAX_DELTA);
+
+        $expected = Matrix::quick([
+            [0.0, 1.0, 7.0],
+            [7.0, 6.0, 0.0],
+        ]);
+
+        $this->assertEqualsWithDelta($expected, $a->pairwiseDistances($b, 'manhattan'), self::MAX_DELTA);
+    }
+
     /**
      * @test
      */
@@ -880,6 +1272,35 @@ class MatrixTest extends TestCase
         $this->assertEqualsWithDelta($expected, $c, self::MAX_DELTA);
     }
 
+    /**
+     * @test
+     */
+    public function dotVectorTransposed() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $c = $a->transpose()->dot(Vector::quick([2, 10, -1]));
+
+        $expected = ColumnVector::quick([64, 82, 13]);
+
+        $this->assertEqualsWithDelta($expected, $c, self::MAX_DELTA);
+
+        $d = Matrix::quick([
+            [1.0, 2.0, 3.0],
+            [4.0, 5.0, 6.0],
+        ]);
+
+        $e = $d->transpose()->dot(Vector::quick([2.0, 0.5]));
+
+        $expected = ColumnVector::quick([4.0, 6.5, 9.0]);
+
+        $this->assertEqualsWithDelta($expected, $e, self::MAX_DELTA);
+    }
+
     /**
      * @test
      */
@@ -2238,6 +2659,134 @@ class MatrixTest extends TestCase
         $this->assertEqualsWithDelta($expected, $b, self::MAX_DELTA);
     }
 
+    /**
+     * @test
+     */
+    public function sumColumns() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $b = $a->sum(0);
+
+        $expected = Vector::quick([46.0, -12.0, 1.0]);
+
+        $this->assertInstanceOf(Vector::class, $b);
+        $this->assertNotInstanceOf(ColumnVector::class, $b);
+        $this->assertEqualsWithDelta($expected->asArray(), $b->asArray(), self::MAX_DELTA);
+    }
+
+    /**
+     * @test
+     */
+    public function maxColumns() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $b = $a->max(0);
+
+        $expected = Vector::quick([22.0, 11.0, 12.0]);
+
+        $this->assertEquals($expected->asArray(), $b->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function meanColumns() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $b = $a->mean(0);
+
+        $expected = Vector::quick([15.333333333333334, -4.0, 0.3333333333333333]);
+
+        $this->assertEqualsWithDelta($expected->asArray(), $b->asArray(), self::MAX_DELTA);
+    }
+
+    /**
+     * @test
+     */
+    public function argmin() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $this->assertEquals([1, 2, 2], $a->argmin());
+        $this->assertEquals([1, 0, 2], $a->argmin(0));
+    }
+
+    /**
+     * @test
+     */
+    public function argmax() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $this->assertEquals([0, 1, 0], $a->argmax());
+        $this->assertEquals([0, 1, 0], $a->argmax(0));
+    }
+
+    /**
+     * @test
+     */
+    public function topK() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        [$values, $indices] = $a->topK(2);
+
+        $expected = Matrix::quick([
+            [22.0, 12.0],
+            [11.0, 4.0],
+            [20.0, -6.0],
+        ]);
+
+        $this->assertEquals($expected->asArray(), $values->asArray());
+        $this->assertEquals([[0, 2], [1, 0], [0, 1]], $indices);
+
+        [$values, $indices] = $a->topK(1, false);
+
+        $this->assertEquals([[-17.0], [-2.0], [-9.0]], $values->asArray());
+        $this->assertEquals([[1], [2], [2]], $indices);
+    }
+
+    /**
+     * @test
+     */
+    public function invalidAxis() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+        ]);
+
+        $this->expectException(InvalidArgumentException::class);
+
+        $a->sum(2);
+    }
+
     /**
      * @test
      */
@@ -2328,6 +2877,28 @@ class MatrixTest extends TestCase
         $this->assertEqualsWithDelta($expected, $b, self::MAX_DELTA);
     }
 
+    /**
+     * @test
+     */
+    public function quantiles() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $b = $a->quantiles([0.0, 0.5, 1.0]);
+
+        $expected = [
+            [-17.0, 12.0, 22.0],
+            [-2.0, 4.0, 11.0],
+            [-9.0, -6.0, 20.0],
+        ];
+
+        $this->assertEqualsWithDelta($expected, $b->asArray(), self::MAX_DELTA);
+    }
+
     /**
      * @test
      */
@@ -2562,6 +3133,108 @@ class MatrixTest extends TestCase
         $this->assertEquals($expected, $b);
     }
 
+    /**
+     * @test
+     */
+    public function axpy() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $b = Matrix::quick([
+            [1.0, 2.0, 3.0],
+            [4.0, 5.0, 6.0],
+            [7.0, 8.0, 9.0],
+        ]);
+
+        $c = $a->axpy(-2.0, $b);
+
+        $expected = Matrix::quick([
+            [20.0, -21.0, 6.0],
+            [-4.0, 1.0, -14.0],
+            [6.0, -22.0, -27.0],
+        ]);
+
+        $this->assertSame($a, $c);
+        $this->assertEquals($expected->asArray(), $a->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function addMatrixInPlace() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $b = Matrix::quick([
+            [1.0, 2.0, 3.0],
+            [4.0, 5.0, 6.0],
+            [7.0, 8.0, 9.0],
+        ]);
+
+        $a->addMatrixInPlace($b)->subtractMatrixInPlace($b)->addMatrixInPlace($b);
+
+        $expected = Matrix::quick([
+            [23.0, -15.0, 15.0],
+            [8.0, 16.0, 4.0],
+            [27.0, 2.0, 0.0],
+        ]);
+
+        $this->assertEquals($expected->asArray(), $a->asArray());
+        $this->assertEquals([7.0, 8.0, 9.0], $b->asArray()[2]);
+    }
+
+    /**
+     * @test
+     */
+    public function multiplyScalarInPlace() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $a->multiplyScalarInPlace(0.5);
+
+        $expected = Matrix::quick([
+            [11.0, -8.5, 6.0],
+            [2.0, 5.5, -1.0],
+            [10.0, -3.0, -4.5],
+        ]);
+
+        $this->assertEquals($expected->asArray(), $a->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function clipInPlace() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [20.0, -6.0, -9.0],
+        ]);
+
+        $a->clipInPlace(-5.0, 16.0);
+
+        $expected = Matrix::quick([
+            [16.0, -5.0, 12.0],
+            [4.0, 11.0, -2.0],
+            [16.0, -5.0, -5.0],
+        ]);
+
+        $this->assertEquals($expected->asArray(), $a->asArray());
+    }
+
     /**
      * @test
      */
@@ -0,0 +1,163 @@
+<?php
+
+namespace Tensor\Tests;
+
+use Tensor\Random;
+use Tensor\Vector;
+use Tensor\Matrix;
+use Tensor\Settings;
+use PHPUnit\Framework\TestCase;
+
+/**
+ * @covers \Tensor\Random
+ */
+class RandomTest extends TestCase
+{
+    /**
+     * @test
+     */
+    public function seed() : void
+    {
+        $generator = new Random(42);
+
+        $this->assertSame(42, $generator->seed());
+    }
+
+    /**
+     * @test
+     */
+    public function sameSeed() : void
+    {
+        $a = Matrix::gaussian(20, 30, new Random(42));
+        $b = Matrix::gaussian(20, 30, new Random(42));
+
+        $this->assertSame($a->asArray(), $b->asArray());
+
+        $a = Vector::uniform(50, new Random(-7));
+        $b = Vector::uniform(50, new Random(-7));
+
+        $this->assertSame($a->asArray(), $b->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function differentSeed() : void
+    {
+        $a = Matrix::rand(10, 10, new Random(1));
+        $b = Matrix::rand(10, 10, new Random(2));
+
+        $this->assertNotEquals($a->asArray(), $b->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function sequence() : void
+    {
+        $generator = new Random(42);
+
+        $a = Vector::rand(20, $generator);
+        $b = Vector::rand(20, $generator);
+
+        $this->assertNotEquals($a->asArray(), $b->asArray());
+
+        $generator = new Random(42);
+
+        $this->assertSame($a->asArray(), Vector::rand(20, $generator)->asArray());
+        $this->assertSame($b->asArray(), Vector::rand(20, $generator)->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function split() : void
+    {
+        $parent = new Random(42);
+
+        $first = $parent->split();
+        $second = $parent->split();
+
+        $a = Matrix::rand(10, 10, $first)->asArray();
+        $b = Matrix::rand(10, 10, $second)->asArray();
+        $c = Matrix::rand(10, 10, $parent)->asArray();
+
+        $this->assertNotEquals($a, $b);
+        $this->assertNotEquals($a, $c);
+        $this->assertNotEquals($b, $c);
+
+        $this->assertSame($a, Matrix::rand(10, 10, new Random(42))->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function jump() : void
+    {
+        $a = Matrix::rand(10, 10, new Random(42))->asArray();
+        $b = Matrix::rand(10, 10, (new Random(42))->jump())->asArray();
+
+        $this->assertNotEquals($a, $b);
+    }
+
+    /**
+     * @test
+     */
+    public function copy() : void
+    {
+        $generator = new Random(42);
+
+        $copy = clone $generator;
+
+        $this->assertSame(Vector::rand(20, $generator)->asArray(), Vector::rand(20, $copy)->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function numThreads() : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $threads = Settings::numThreads();
+
+        $factories = [
+            'rand' => function (Random $generator) {
+                return Matrix::rand(300, 300, $generator);
+            },
+            'gaussian' => function (Random $generator) {
+                return Matrix::gaussian(300, 300, $generator);
+            },
+            'poisson' => function (Random $generator) {
+                return Matrix::poisson(300, 300, 40.0, $generator);
+            },
+            'uniform' => function (Random $generator) {
+                return Matrix::uniform(300, 300, $generator);
+            },
+            'bernoulli' => function (Random $generator) {
+                return Matrix::bernoulli(300, 300, 0.3, $generator);
+            },
+            'truncatedNormal' => function (Random $generator) {
+                return Matrix::truncatedNormal(300, 300, 0.0, 1.0, $generator);
+            },
+        ];
+
+        try {
+            foreach ($factories as $name => $factory) {
+                Settings::setNumThreads(1);
+
+                $serial = $factory(new Random(42))->asArray();
+
+                Settings::setNumThreads(8);
+
+                $parallel = $factory(new Random(42))->asArray();
+
+                $this->assertSame($serial, $parallel, $name);
+            }
+        } finally {
+            Settings::setNumThreads($threads);
+        }
+    }
+}
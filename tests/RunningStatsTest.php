@@ -0,0 +1,99 @@
+<?php
+
+namespace Tensor\Tests;
+
+use Tensor\Vector;
+use Tensor\Matrix;
+use Tensor\RunningStats;
+use Tensor\Exceptions\DimensionalityMismatch;
+use PHPUnit\Framework\TestCase;
+
+/**
+ * @covers \Tensor\RunningStats
+ */
+class RunningStatsTest extends TestCase
+{
+    /**
+     * The maximum error tolerated due to varying numerical precision.
+     *
+     * @var float
+     */
+    protected const MAX_DELTA = 1e-8;
+
+    /**
+     * @test
+     */
+    public function update() : void
+    {
+        $stats = new RunningStats(2);
+
+        $stats->update(Matrix::quick([
+            [1.0, 2.0],
+            [3.0, 4.0],
+            [5.0, 9.0],
+        ]));
+
+        $this->assertSame(3, $stats->count());
+        $this->assertEqualsWithDelta([3.0, 5.0], $stats->mean()->asArray(), self::MAX_DELTA);
+        $this->assertEqualsWithDelta([8.0 / 3.0, 26.0 / 3.0], $stats->variance()->asArray(), self::MAX_DELTA);
+    }
+
+    /**
+     * @test
+     */
+    public function updateChunks() : void
+    {
+        $stats = new RunningStats(2);
+
+        $stats->update(Vector::quick([1.0, 2.0]))
+            ->update(Matrix::quick([
+                [3.0, 4.0],
+                [5.0, 9.0],
+            ]));
+
+        $this->assertSame(3, $stats->count());
+        $this->assertEqualsWithDelta([3.0, 5.0], $stats->mean()->asArray(), self::MAX_DELTA);
+        $this->assertEqualsWithDelta([8.0 / 3.0, 26.0 / 3.0], $stats->variance()->asArray(), self::MAX_DELTA);
+    }
+
+    /**
+     * @test
+     */
+    public function merge() : void
+    {
+        $a = Matrix::quick([
+            [22.0, -17.0, 12.0, 1.5],
+            [4.0, 11.0, -2.0, 7.0],
+            [20.0, -6.0, -9.0, 0.0],
+            [-5.0, 0.5, 3.0, -4.0],
+        ]);
+
+        $samples = $a->asArray();
+
+        $left = new RunningStats(4);
+        $right = new RunningStats(4);
+
+        $left->update(Matrix::quick(array_slice($samples, 0, 2)));
+        $right->update(Matrix::quick(array_slice($samples, 2)));
+
+        $left->merge($right);
+
+        $b = $a->transpose();
+
+        $this->assertSame(4, $left->count());
+        $this->assertEqualsWithDelta($a->mean(0)->asArray(), $left->mean()->asArray(), self::MAX_DELTA);
+        $this->assertEqualsWithDelta($b->variance()->asArray(), $left->variance()->asArray(), self::MAX_DELTA);
+    }
+
+    /**
+     * @test
+     */
+    public function updateDimensionalityMismatch() : void
+    {
+        $stats = new RunningStats(3);
+
+        $this->expectException(DimensionalityMismatch::class);
+
+        $stats->update(Vector::quick([1.0, 2.0]));
+    }
+}
@@ -0,0 +1,367 @@
+<?php
+
+namespace Tensor\Tests;
+
+use Tensor\Vector;
+use Tensor\Matrix;
+use Tensor\Random;
+use Tensor\Settings;
+use PHPUnit\Framework\TestCase;
+use Generator;
+
+/**
+ * @covers \Tensor\Settings
+ */
+class SettingsTest extends TestCase
+{
+    /**
+     * The maximum error of the fast approximations in units in the last place.
+     *
+     * @var int
+     */
+    protected const MAX_ULPS = 4;
+
+    /**
+     * @return \Generator<mixed[]>
+     */
+    public function fastMathProvider() : Generator
+    {
+        $grid = [];
+
+        for ($i = 0; $i < 2000; ++$i) {
+            $grid[] = -700.0 + $i * 0.7003;
+        }
+
+        $subnormals = [5e-324, -5e-324, 2.2e-310, -1e-315, 0.0, -0.0];
+
+        $edges = [INF, -INF, NAN, 1e-300, -1e-300, 1e300, -1e300];
+
+        yield 'exp' => ['exp', array_merge($grid, $subnormals, $edges, [
+            707.9, -707.9, 708.0, -708.0, 709.7, 710.0, -720.0, -745.0, -746.0, 1e-10, -1e-10,
+        ])];
+
+        $positive = [];
+
+        for ($i = 1; $i <= 2000; ++$i) {
+            $positive[] = $i * 0.3711;
+            $positive[] = 1.0 / ($i * 0.3711);
+        }
+
+        yield 'log' => ['log', array_merge($positive, $subnormals, $edges, [
+            1.0, 0.5, 2.0, M_SQRT1_2, M_SQRT2, 2.3e-308, 1.7e308, PHP_FLOAT_MAX, PHP_FLOAT_MIN,
+            -1.0, -1e-300, -INF,
+        ])];
+
+        $large = [1e5, -1e5, 12345.678, 823549.0, -823549.0, 823550.0, 1e6, -1e6, 1e10, 1e22, -1e300];
+
+        yield 'sin' => ['sin', array_merge($grid, $subnormals, $edges, $large)];
+
+        yield 'cos' => ['cos', array_merge($grid, $subnormals, $edges, $large)];
+
+        yield 'tan' => ['tan', array_merge($grid, $subnormals, $edges, $large)];
+    }
+
+    /**
+     * @return \Generator<mixed[]>
+     */
+    public function parallelProvider() : Generator
+    {
+        yield 'broadcast row' => [function (Matrix $a, Matrix $b) {
+            return $a->add($b->rowAsVector(0));
+        }];
+
+        yield 'broadcast column' => [function (Matrix $a, Matrix $b) {
+            return $a->multiply($b->columnAsVector(0));
+        }];
+
+        yield 'element-wise' => [function (Matrix $a, Matrix $b) {
+            return $a->subtract($b)->exp();
+        }];
+
+        yield 'sum' => [function (Matrix $a) {
+            return [$a->sum(0), $a->sum(1)];
+        }];
+
+        yield 'mean' => [function (Matrix $a) {
+            return [$a->mean(0), $a->mean(1)];
+        }];
+
+        yield 'min max' => [function (Matrix $a) {
+            return [$a->min(0), $a->max(1), $a->argmax(0), $a->argmax(1)];
+        }];
+
+        yield 'quantiles' => [function (Matrix $a) {
+            return [$a->median(), $a->quantiles([0.1, 0.5, 0.9])];
+        }];
+
+        yield 'top k' => [function (Matrix $a) {
+            return $a->topK(5);
+        }];
+
+        yield 'clip' => [function (Matrix $a) {
+            return $a->clip(-0.5, 0.5);
+        }];
+
+        yield 'expression' => [function (Matrix $a, Matrix $b) {
+            return [$a->expr()->subtract($b)->square()->evaluate(), $a->expr()->subtract($b)->square()->sum()];
+        }];
+
+        yield 'distances' => [function (Matrix $a, Matrix $b) {
+            return [
+                $a->pairwiseDistances($b, 'euclidean'),
+                $a->pairwiseDistances($b, 'cosine'),
+                $a->pairwiseDistances($b, 'manhattan'),
+            ];
+        }];
+    }
+
+    /**
+     * @test
+     * @dataProvider parallelProvider
+     *
+     * @param callable $operation
+     */
+    public function parallelMatchesSerial(callable $operation) : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $a = Matrix::gaussian(97, 61, new Random(1));
+        $b = Matrix::gaussian(97, 61, new Random(2));
+
+        $threads = Settings::numThreads();
+        $grainSize = Settings::grainSize();
+
+        try {
+            Settings::setNumThreads(1);
+
+            $serial = self::unpack($operation($a, $b));
+
+            Settings::setNumThreads(8);
+            Settings::setGrainSize(64);
+
+            $parallel = self::unpack($operation($a, $b));
+        } finally {
+            Settings::setNumThreads($threads);
+            Settings::setGrainSize($grainSize);
+        }
+
+        $this->assertSame($serial, $parallel);
+    }
+
+    /**
+     * @test
+     */
+    public function utilizationRows() : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $a = Matrix::gaussian(500, 40, new Random(1));
+
+        $threads = Settings::numThreads();
+        $grainSize = Settings::grainSize();
+
+        try {
+            Settings::setNumThreads(4);
+            Settings::setGrainSize(40);
+            Settings::resetUtilization();
+
+            $a->quantiles([0.25, 0.75]);
+
+            $workers = Settings::utilization();
+        } finally {
+            Settings::setNumThreads($threads);
+            Settings::setGrainSize($grainSize);
+        }
+
+        $this->assertGreaterThanOrEqual(4, count($workers));
+
+        $this->assertSame(500, array_sum(array_column($workers, 'rows')));
+
+        foreach ($workers as $worker) {
+            $this->assertGreaterThanOrEqual(0.0, $worker['busy']);
+            $this->assertGreaterThanOrEqual(0.0, $worker['utilization']);
+            $this->assertLessThanOrEqual(1.0, $worker['utilization']);
+        }
+    }
+
+    /**
+     * @test
+     */
+    public function utilizationSteals() : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $samples = [];
+
+        for ($i = 0; $i < 256; ++$i) {
+            $samples[] = $i < 32 ? range(1.0, 2000.0) : array_fill(0, 2000, 0.0);
+        }
+
+        $a = Matrix::quick($samples);
+
+        $threads = Settings::numThreads();
+        $grainSize = Settings::grainSize();
+
+        try {
+            Settings::setNumThreads(8);
+            Settings::setGrainSize(2000);
+            Settings::resetUtilization();
+
+            $a->topK(1000);
+
+            $workers = Settings::utilization();
+        } finally {
+            Settings::setNumThreads($threads);
+            Settings::setGrainSize($grainSize);
+        }
+
+        $this->assertSame(256, array_sum(array_column($workers, 'rows')));
+        $this->assertGreaterThan(0, array_sum(array_column($workers, 'steals')));
+    }
+
+    /**
+     * @test
+     */
+    public function resetUtilization() : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $threads = Settings::numThreads();
+
+        try {
+            Settings::setNumThreads(2);
+
+            Matrix::gaussian(100, 10, new Random(1))->clip(-1.0, 1.0);
+
+            Settings::resetUtilization();
+
+            $workers = Settings::utilization();
+        } finally {
+            Settings::setNumThreads($threads);
+        }
+
+        $this->assertNotEmpty($workers);
+
+        foreach ($workers as $worker) {
+            $this->assertEquals(['busy' => 0.0, 'utilization' => 0.0, 'rows' => 0, 'tasks' => 0, 'steals' => 0], $worker);
+        }
+    }
+
+    /**
+     * @test
+     */
+    public function fastMath() : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $enabled = Settings::fastMath();
+
+        try {
+            Settings::setFastMath(true);
+
+            $this->assertTrue(Settings::fastMath());
+
+            Settings::setFastMath(false);
+
+            $this->assertFalse(Settings::fastMath());
+        } finally {
+            Settings::setFastMath($enabled);
+        }
+    }
+
+    /**
+     * @test
+     * @dataProvider fastMathProvider
+     *
+     * @param string $function
+     * @param list<float> $values
+     */
+    public function fastMathAccuracy(string $function, array $values) : void
+    {
+        if (!extension_loaded('tensor')) {
+            $this->markTestSkipped('Requires the Tensor extension.');
+        }
+
+        $enabled = Settings::fastMath();
+
+        try {
+            Settings::setFastMath(true);
+
+            $actual = Vector::quick($values)->$function()->asArray();
+        } finally {
+            Settings::setFastMath($enabled);
+        }
+
+        foreach ($values as $i => $value) {
+            $expected = $function($value);
+
+            if (is_nan($expected)) {
+                $this->assertNan($actual[$i], "$function($value)");
+
+                continue;
+            }
+
+            $this->assertLessThanOrEqual(self::MAX_ULPS, self::ulps($expected, $actual[$i]), "$function($value) = {$actual[$i]}, $expected expected");
+        }
+    }
+
+    /**
+     * Convert the tensors in the result of an operation to arrays.
+     *
+     * @param mixed $result
+     * @return mixed
+     */
+    protected static function unpack($result)
+    {
+        if (is_array($result)) {
+            return array_map([self::class, 'unpack'], $result);
+        }
+
+        if (is_object($result)) {
+            return $result->asArray();
+        }
+
+        return $result;
+    }
+
+    /**
+     * Return the number of representable doubles between a and b.
+     *
+     * @param float $a
+     * @param float $b
+     * @return float
+     */
+    protected static function ulps(float $a, float $b) : float
+    {
+        if ($a === $b) {
+            return 0.0;
+        }
+
+        if (is_nan($a) or is_nan($b)) {
+            return INF;
+        }
+
+        [, $ia] = unpack('q', pack('d', $a));
+        [, $ib] = unpack('q', pack('d', $b));
+
+        if ($ia < 0) {
+            $ia = PHP_INT_MIN - $ia;
+        }
+
+        if ($ib < 0) {
+            $ib = PHP_INT_MIN - $ib;
+        }
+
+        return (float) abs($ia - $ib);
+    }
+}
@@ -46,6 +46,38 @@ class VectorTest extends TestCase
         $this->assertInstanceOf(Special::class, $vector);
     }
 
+    /**
+     * @test
+     */
+    public function equalsAfterOperation() : void
+    {
+        $vector = Vector::quick([1, 2, 3]);
+
+        $result = $vector->multiply(2)->add(1);
+
+        $expected = Vector::quick([3, 5, 7]);
+
+        $this->assertEquals($expected, $result);
+        $this->assertTrue($result == $expected);
+        $this->assertFalse($result == $vector->add(1));
+    }
+
+    /**
+     * @test
+     */
+    public function serialize() : void
+    {
+        $vector = Vector::quick([1, 2, 3])->multiply(2);
+
+        $copy = unserialize(serialize($vector));
+
+        $expected = Vector::quick([2, 4, 6]);
+
+        $this->assertEquals($expected, $copy);
+        $this->assertEquals($vector, $copy);
+        $this->assertEquals($expected, $copy->add(0));
+    }
+
     /**
      * @test
      */
@@ -122,6 +154,40 @@ class VectorTest extends TestCase
         $this->assertCount(4, $vector);
     }
 
+    /**
+     * @test
+     */
+    public function bernoulli() : void
+    {
+        $vector = Vector::bernoulli(4, 0.5);
+
+        $this->assertCount(4, $vector);
+    }
+
+    /**
+     * @test
+     */
+    public function truncatedNormal() : void
+    {
+        $vector = Vector::truncatedNormal(4, 1.0, 2.0);
+
+        $this->assertCount(4, $vector);
+        $this->assertLessThanOrEqual(5.0, $vector->max());
+        $this->assertGreaterThanOrEqual(-3.0, $vector->min());
+    }
+
+    /**
+     * @test
+     */
+    public function categorical() : void
+    {
+        $vector = Vector::categorical(10, Vector::quick([0.0, 3.0, 0.0]));
+
+        $expected = Vector::fill(1.0, 10);
+
+        $this->assertEquals($expected, $vector);
+    }
+
     /**
      * @test
      */
@@ -398,6 +464,31 @@ class VectorTest extends TestCase
         $this->assertEqualsWithDelta($expected, $c, self::MAX_DELTA);
     }
 
+    /**
+     * @test
+     */
+    public function outerRectangular() : void
+    {
+        $a = Vector::quick([1.0, -2.0, 3.0]);
+
+        $b = Vector::quick([4.0, 0.5]);
+
+        $expected = Matrix::quick([
+            [4.0, 0.5],
+            [-8.0, -1.0],
+            [12.0, 1.5],
+        ]);
+
+        $this->assertEqualsWithDelta($expected, $a->outer($b), self::MAX_DELTA);
+
+        $expected = Matrix::quick([
+            [4.0, -8.0, 12.0],
+            [0.5, -1.0, 1.5],
+        ]);
+
+        $this->assertEqualsWithDelta($expected, $b->outer($a), self::MAX_DELTA);
+    }
+
     /**
      * @test
      */
@@ -1237,6 +1328,44 @@ class VectorTest extends TestCase
         $this->assertEquals(106, $a->max());
     }
 
+    /**
+     * @test
+     */
+    public function argmin() : void
+    {
+        $a = Vector::quick([-15.0, 25.0, 35.0, -36.0, -72.0, 89.0, 106.0, 45.0]);
+
+        $this->assertSame(4, $a->argmin());
+    }
+
+    /**
+     * @test
+     */
+    public function argmax() : void
+    {
+        $a = Vector::quick([-15.0, 25.0, 35.0, -36.0, -72.0, 89.0, 106.0, 45.0]);
+
+        $this->assertSame(6, $a->argmax());
+    }
+
+    /**
+     * @test
+     */
+    public function topK() : void
+    {
+        $a = Vector::quick([-15.0, 25.0, 35.0, -36.0, -72.0, 89.0, 106.0, 45.0]);
+
+        [$values, $indices] = $a->topK(3);
+
+        $this->assertEquals([106.0, 89.0, 45.0], $values->asArray());
+        $this->assertEquals([6, 5, 7], $indices);
+
+        [$values, $indices] = $a->topK(2, false);
+
+        $this->assertEquals([-72.0, -36.0], $values->asArray());
+        $this->assertEquals([4, 3], $indices);
+    }
+
     /**
      * @test
      */
@@ -1267,6 +1396,16 @@ class VectorTest extends TestCase
         $this->assertEqualsWithDelta(30.0, $a->quantile(0.5), self::MAX_DELTA);
     }
 
+    /**
+     * @test
+     */
+    public function quantiles() : void
+    {
+        $a = Vector::quick([-15.0, 25.0, 35.0, -36.0, -72.0, 89.0, 106.0, 45.0]);
+
+        $this->assertEqualsWithDelta([-20.25, 30.0, 56.0], $a->quantiles([0.25, 0.5, 0.75]), self::MAX_DELTA);
+    }
+
     /**
      * @test
      */
@@ -1346,7 +1485,11 @@ class VectorTest extends TestCase
     {
         $a = Vector::quick([-15.0, 25.0, 35.0, -36.0, -72.0, 89.0, 106.0, 45.0]);
 
+        $this->assertEqualsWithDelta(423.0, $a->pNorm(1.0), self::MAX_DELTA);
+        $this->assertEqualsWithDelta(172.4441938715247, $a->pNorm(2.0), self::MAX_DELTA);
         $this->assertEqualsWithDelta(135.15554088861361, $a->pNorm(3.0), self::MAX_DELTA);
+        $this->assertEqualsWithDelta($a->l1Norm(), $a->pNorm(1.0), self::MAX_DELTA);
+        $this->assertEqualsWithDelta($a->l2Norm(), $a->pNorm(2.0), self::MAX_DELTA);
     }
 
     /**
@@ -1401,6 +1544,67 @@ class VectorTest extends TestCase
         $this->assertEquals($expected, $b);
     }
 
+    /**
+     * @test
+     */
+    public function axpy() : void
+    {
+        $a = Vector::quick([-15.0, 25.0, 35.0, -36.0]);
+
+        $b = Vector::quick([1.0, 2.0, 3.0, 4.0]);
+
+        $c = $a->axpy(2.0, $b);
+
+        $expected = Vector::quick([-13.0, 29.0, 41.0, -28.0]);
+
+        $this->assertSame($a, $c);
+        $this->assertEquals($expected->asArray(), $a->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function addVectorInPlace() : void
+    {
+        $a = Vector::quick([-15.0, 25.0, 35.0, -36.0]);
+
+        $b = Vector::quick([1.0, 2.0, 3.0, 4.0]);
+
+        $a->addVectorInPlace($b)->addVectorInPlace($b)->subtractVectorInPlace($b);
+
+        $expected = Vector::quick([-14.0, 27.0, 38.0, -32.0]);
+
+        $this->assertEquals($expected->asArray(), $a->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function multiplyScalarInPlace() : void
+    {
+        $a = Vector::quick([-15.0, 25.0, 35.0, -36.0]);
+
+        $a->multiplyScalarInPlace(-2.0);
+
+        $expected = Vector::quick([30.0, -50.0, -70.0, 72.0]);
+
+        $this->assertEquals($expected->asArray(), $a->asArray());
+    }
+
+    /**
+     * @test
+     */
+    public function clipInPlace() : void
+    {
+        $a = Vector::quick([-15.0, 25.0, 35.0, -36.0, -72.0, 89.0, 106.0, 45.0]);
+
+        $a->clipInPlace(0.0, 100.0);
+
+        $expected = Vector::quick([0.0, 25.0, 35.0, 0.0, 0.0, 89.0, 100.0, 45.0]);
+
+        $this->assertEquals($expected->asArray(), $a->asArray());
+    }
+
     /**
      * @test
      */